@@ -0,0 +1,28 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+#define MIN_LOCATION 10000
+#define MAX_LOCATION 99999
+
+int main(int argc, char *argv[])
+{
+    long long lines = parse_generator_args(argc, argv, 1000, 1, 100000000, "The number of lines");
+    if (lines == -1)
+        return 1;
+
+    // Keep the left list so some of the right list can repeat it, otherwise the similarity score is almost always 0
+    int *left = malloc(sizeof(left[0]) * lines);
+    for (long long i = 0; i < lines; i++)
+        left[i] = random_range(MIN_LOCATION, MAX_LOCATION);
+
+    for (long long i = 0; i < lines; i++)
+    {
+        int right = (next_random() & 1) ? left[random_range(0, lines - 1)] : random_range(MIN_LOCATION, MAX_LOCATION);
+        printf("%d   %d\n", left[i], right);
+    }
+
+    free(left);
+    return 0;
+}
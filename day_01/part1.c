@@ -2,56 +2,116 @@
 #include <stdlib.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-#include "../c-data-structures/merge_sort/merge_sort.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/sort.h"
+#include "../runner/distance.h"
+#include "../runner/thread_pool.h"
 
 DEF_VEC(int)
+DEF_VEC_CAPACITY(int)
 
-int parse_input(int_Vec *left_list, int_Vec *right_list);
-int similarity_score(int *left, int *right, size_t n);
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    int_Vec left_list;
+    int_Vec right_list;
+} Puzzle;
+
+int parse_input(char *input_file, int_Vec *left_list, int_Vec *right_list);
+long long similarity_score(int *left, int *right, size_t n);
+void sort_lists(int *left, int *right, size_t n);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
-int main(int argc, char const *argv[])
+int main(int argc, char *argv[])
 {
     // Parse the input
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
     int_Vec left_list, right_list;
-    if (parse_input(&left_list, &right_list))
-        return 1;
-    
-    // Validate
-    if (left_list.len != right_list.len)
-    {
-        fprintf(stderr, "Left and right lists do not have the same length.\nLeft length: %zd | Right length: %zd", left_list.len, right_list.len);
+    if (parse_input(input_file, &left_list, &right_list))
         return 1;
-    }
 
     // Do the actual calculations and print the result
-    printf("Total distance: %d\n", similarity_score(left_list.arr, right_list.arr, left_list.len));
+    printf("Total distance: %lld\n", similarity_score(left_list.arr, right_list.arr, left_list.len));
     free(left_list.arr);
     free(right_list.arr);
     return 0;
 }
 
-int parse_input(int_Vec *left_list, int_Vec *right_list)
+void *parse_puzzle(char *input_file)
 {
-    *left_list = new_int_Vec();
-    *right_list = new_int_Vec();
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->left_list, &puzzle->right_list))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
 
-    FILE *f = fopen("input.txt", "r");
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", similarity_score(p->left_list.arr, p->right_list.arr, p->left_list.len));
+    return 0;
+}
 
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    free(p->left_list.arr);
+    free(p->right_list.arr);
+    free(p);
+}
+
+DEF_SOLVER(1, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
+/// @brief Parse the input file into the left and right lists
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param left_list Out: The left list
+/// @param right_list Out: The right list
+/// @return 0 if success, non-zero if failure
+int parse_input(char *input_file, int_Vec *left_list, int_Vec *right_list)
+{
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    int left, right;
-    while (fscanf(f, "%d   %d\n", &left, &right) == 2)
+    // One pair per line, so the lists are allocated once at their full size
+    Span span = input_span(&input);
+    size_t lines = count_lines(span);
+    *left_list = with_capacity_int_Vec(lines);
+    *right_list = with_capacity_int_Vec(lines);
+
+    // Parse many pairs at a time. Each line is "left   right"
+    long long values[256];
+    size_t values_size;
+    while ((values_size = next_numbers(&span, values, 256)) > 0)
     {
-        printf("%d   %d\n", left, right);
-        append_int_Vec(left_list, left);
-        append_int_Vec(right_list, right);
+        for (size_t i = 0; i + 1 < values_size; i += 2)
+        {
+            append_int_Vec(left_list, values[i]);
+            append_int_Vec(right_list, values[i + 1]);
+        }
+        // Only the last batch can be odd, since a full one is even. Its number has no pair, so it goes in the left list
+        // for the length check to catch
+        if (values_size & 1)
+            append_int_Vec(left_list, values[values_size - 1]);
     }
 
-    fclose(f);
+    close_input(&input);
+
+    // Validate
+    if (left_list->len != right_list->len)
+    {
+        fprintf(stderr, "Left and right lists do not have the same length.\nLeft length: %zd | Right length: %zd\n", left_list->len, right_list->len);
+        free(left_list->arr);
+        free(right_list->arr);
+        return 1;
+    }
     return 0;
 }
 
@@ -60,24 +120,36 @@ int parse_input(int_Vec *left_list, int_Vec *right_list)
 /// @param right The right array
 /// @param n The length of both arrays
 /// @return The total distance
-int similarity_score(int *left, int *right, size_t n)
+long long similarity_score(int *left, int *right, size_t n)
 {
-    printf("Sorting\n");
     // Sort the arrays
-    merge_sort(left, n);
-    merge_sort(right, n);
-    printf("Done sorting\n");
+    sort_lists(left, right, n);
 
-    // Sum the distances in the sorted arrays
-    int sum = 0;
-    for (int i = 0; i < n; i++)
-    {
-        int distance = left[i] - right[i];
-        // Absolute value
-        if (distance < 0)
-            distance = -distance;
-        sum += distance;
-    }
+    // Sum the distances in the sorted arrays, 8 at a time where the CPU has AVX2
+    return total_distance(left, right, n);
+}
+
+// The lists for sort_list to sort
+typedef struct SortJob
+{
+    int *lists[2];
+    size_t n;
+} SortJob;
 
-    return sum;
+// Sort lists [begin, end) of a SortJob
+void sort_list(size_t begin, size_t end, int worker, void *ctx)
+{
+    SortJob *job = ctx;
+    for (size_t i = begin; i < end; i++)
+        sort_ints(job->lists[i], job->n);
+}
+
+/// @brief Sort both lists, at the same time if there is more than 1 thread
+/// @param left The left list
+/// @param right The right list
+/// @param n The length of both lists
+void sort_lists(int *left, int *right, size_t n)
+{
+    SortJob job = {{left, right}, n};
+    parallel_for(0UL, 2UL, 1UL, sort_list, &job);
 }
@@ -1,98 +1,298 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-#include "../c-data-structures/merge_sort/merge_sort.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/hashmap.h"
 
 DEF_VEC(int)
+DEF_VEC_CAPACITY(int)
 
-int parse_input(int_Vec *left_list, int_Vec *right_list);
-int similarity_score(int *left, int *right, size_t n);
+// The number of times an ID is in a list
+typedef long long Count;
+DEF_HASHMAP(IntKey, Count)
 
-int main(int argc, char const *argv[])
+// A list's IDs are counted in an array if their range is at most this many times the length of the list. Otherwise the
+// array would cost more to clear than the hash map costs to fill, and they are counted in a hash map
+#define HISTOGRAM_ARRAY_FACTOR 4
+// The range of IDs a live score counts in an array. The puzzle's IDs have 5 digits
+#define LIVE_MIN_ID 0
+#define LIVE_ID_RANGE 100000UL
+
+// How many times each ID is in a list
+// IDs in [min, min + size) are counted in an array and any others in a hash map, so IDs from a small range never hash
+typedef struct Histogram
+{
+    Count *counts;
+    long long min;
+    size_t size;
+    IntKey_Count_HashMap others;
+} Histogram;
+
+// A similarity score that is kept up to date as pairs are added
+typedef struct Similarity
+{
+    Histogram left, right;
+    long long score;
+} Similarity;
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    int_Vec left_list;
+    int_Vec right_list;
+} Puzzle;
+
+int parse_input(char *input_file, int_Vec *left_list, int_Vec *right_list);
+long long similarity_score(int *left, int *right, size_t n);
+Histogram new_histogram(long long min, size_t size);
+Count histogram_add(Histogram *histogram, int id);
+Count histogram_count(Histogram *histogram, int id);
+void delete_histogram(Histogram *histogram);
+Similarity new_similarity(long long min, size_t size);
+long long add_pair(Similarity *similarity, int left, int right);
+void delete_similarity(Similarity *similarity);
+int print_live_scores(char *input_file);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
+int main(int argc, char *argv[])
 {
     // Parse the input
-    int_Vec left_list, right_list;
-    if (parse_input(&left_list, &right_list))
-        return 1;
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
+    // `live` prints the score after every pair as it is read, e.g. `./part2 - live` to follow pairs from a pipe
+    if (argc >= 3 && !strcmp(argv[2], "live"))
+        return print_live_scores(strcmp(input_file, "-") ? input_file : NULL);
 
-    // Validate
-    if (left_list.len != right_list.len)
-    {
-        fprintf(stderr, "Left and right lists do not have the same length.\nLeft length: %zd | Right length: %zd", left_list.len, right_list.len);
+    int_Vec left_list, right_list;
+    if (parse_input(input_file, &left_list, &right_list))
         return 1;
-    }
 
     // Do the actual calculations and print the result
-    printf("Similarity score: %d\n", similarity_score(left_list.arr, right_list.arr, left_list.len));
+    printf("Similarity score: %lld\n", similarity_score(left_list.arr, right_list.arr, left_list.len));
     free(left_list.arr);
     free(right_list.arr);
     return 0;
 }
 
-int parse_input(int_Vec *left_list, int_Vec *right_list)
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->left_list, &puzzle->right_list))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", similarity_score(p->left_list.arr, p->right_list.arr, p->left_list.len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
 {
-    *left_list = new_int_Vec();
-    *right_list = new_int_Vec();
+    Puzzle *p = puzzle;
+    free(p->left_list.arr);
+    free(p->right_list.arr);
+    free(p);
+}
 
-    FILE *f = fopen("input.txt", "r");
+DEF_SOLVER(1, 2, parse_puzzle, solve_puzzle, delete_puzzle)
 
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+/// @brief Parse the input file into the left and right lists
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param left_list Out: The left list
+/// @param right_list Out: The right list
+/// @return 0 if success, non-zero if failure
+int parse_input(char *input_file, int_Vec *left_list, int_Vec *right_list)
+{
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    int left, right;
-    while (fscanf(f, "%d   %d\n", &left, &right) == 2)
+    // One pair per line, so the lists are allocated once at their full size
+    Span span = input_span(&input);
+    size_t lines = count_lines(span);
+    *left_list = with_capacity_int_Vec(lines);
+    *right_list = with_capacity_int_Vec(lines);
+
+    // Parse many pairs at a time. Each line is "left   right"
+    long long values[256];
+    size_t values_size;
+    while ((values_size = next_numbers(&span, values, 256)) > 0)
     {
-        printf("%d   %d\n", left, right);
-        append_int_Vec(left_list, left);
-        append_int_Vec(right_list, right);
+        for (size_t i = 0; i + 1 < values_size; i += 2)
+        {
+            append_int_Vec(left_list, values[i]);
+            append_int_Vec(right_list, values[i + 1]);
+        }
+        // Only the last batch can be odd, since a full one is even. Its number has no pair, so it goes in the left list
+        // for the length check to catch
+        if (values_size & 1)
+            append_int_Vec(left_list, values[values_size - 1]);
     }
 
-    fclose(f);
+    close_input(&input);
+
+    // Validate
+    if (left_list->len != right_list->len)
+    {
+        fprintf(stderr, "Left and right lists do not have the same length.\nLeft length: %zd | Right length: %zd\n", left_list->len, right_list->len);
+        free(left_list->arr);
+        free(right_list->arr);
+        return 1;
+    }
     return 0;
 }
 
-/// @brief Get the similarity score of the arrays
+/// @brief Get the similarity score of the arrays: the sum of each left ID times the number of times it is in the right array
 /// @param left The left array
 /// @param right The right array
 /// @param n The length of both arrays
 /// @return The similarity score
-int similarity_score(int *left, int *right, size_t n)
-{
-    printf("Sorting\n");
-    // Sort the arrays
-    merge_sort(left, n);
-    merge_sort(right, n);
-    printf("Done sorting\n");
-
-    // Sum the distances in the sorted arrays
-    int sum = 0;
-    int last_left_number = -1;
-    int left_similarity;
-    int right_cursor = 0;
-    for (int i = 0; i < n; i++)
+long long similarity_score(int *left, int *right, size_t n)
+{
+    if (!n)
+        return 0LL;
+
+    // Count the right IDs in an array if their range is small enough
+    int min = right[0], max = right[0];
+    for (size_t i = 1; i < n; i++)
     {
-        int left_number = left[i];
-        if (left_number != last_left_number)
-        {
-            // If this is the same as the last one we tried, just use the same score
-            // Otherwise, deal with the right number
-            // Skip all numbers less than the left number
-            left_similarity = 0;
-            while (right_cursor < n && right[right_cursor] < left_number)
-                right_cursor++;
-            // Count the numbers on the right that are the same as the left number
-            while (right_cursor < n && right[right_cursor] == left_number)
-            {
-                left_similarity += left_number;
-                right_cursor++;
-            }
-        }
-        sum += left_similarity;
+        min = right[i] < min ? right[i] : min;
+        max = right[i] > max ? right[i] : max;
     }
+    size_t range = (size_t)((long long)max - min) + 1;
+    Histogram right_counts = new_histogram(min, range / HISTOGRAM_ARRAY_FACTOR <= n ? range : 0UL);
+    if (!right_counts.size)
+        reserve_IntKey_Count_HashMap(&right_counts.others, n);
+    for (size_t i = 0; i < n; i++)
+        histogram_add(&right_counts, right[i]);
+
+    // Then look up each left ID in one pass, without sorting either array
+    long long sum = 0LL;
+    for (size_t i = 0; i < n; i++)
+        sum += (long long)left[i] * histogram_count(&right_counts, left[i]);
 
+    delete_histogram(&right_counts);
     return sum;
 }
+
+/// @brief Make an empty histogram
+/// @param min The smallest ID to count in the array
+/// @param size The number of IDs to count in the array, starting at `min`. Others are counted in a hash map
+/// @return The histogram. Delete with delete_histogram
+Histogram new_histogram(long long min, size_t size)
+{
+    return (Histogram){.counts = size ? calloc(size, sizeof(Count)) : NULL, .min = min, .size = size, .others = new_IntKey_Count_HashMap()};
+}
+
+/// @brief Count one more of an ID
+/// @param histogram The histogram
+/// @param id The ID
+/// @return The number of times `id` has been counted, including this one
+Count histogram_add(Histogram *histogram, int id)
+{
+    // IDs below min wrap around to large offsets, so one comparison finds both ends
+    size_t offset = (size_t)(id - histogram->min);
+    if (offset < histogram->size)
+        return ++histogram->counts[offset];
+
+    IntKey_Count_HashMapEntry *entry = find_IntKey_Count_HashMap(&histogram->others, id);
+    if (entry)
+        return ++entry->value;
+    put_IntKey_Count_HashMap(&histogram->others, id, 1LL);
+    return 1LL;
+}
+
+/// @brief Get the number of times an ID has been counted
+/// @param histogram The histogram
+/// @param id The ID
+/// @return The number of times `id` has been counted
+Count histogram_count(Histogram *histogram, int id)
+{
+    size_t offset = (size_t)(id - histogram->min);
+    if (offset < histogram->size)
+        return histogram->counts[offset];
+
+    Count count = 0LL;
+    get_IntKey_Count_HashMap(&histogram->others, id, &count);
+    return count;
+}
+
+void delete_histogram(Histogram *histogram)
+{
+    free(histogram->counts);
+    histogram->counts = NULL;
+    histogram->size = 0UL;
+    delete_IntKey_Count_HashMap(&histogram->others);
+}
+
+/// @brief Make a similarity score with no pairs yet
+/// @param min The smallest ID expected
+/// @param size The number of IDs expected, starting at `min`. These are counted in arrays, and others in hash maps
+/// @return The similarity score. Delete with delete_similarity
+Similarity new_similarity(long long min, size_t size)
+{
+    return (Similarity){new_histogram(min, size), new_histogram(min, size), 0LL};
+}
+
+/// @brief Add a pair to the lists, updating the score in O(1)
+/// @param similarity The similarity score
+/// @param left The ID added to the left list
+/// @param right The ID added to the right list
+/// @return The similarity score of the lists with this pair
+long long add_pair(Similarity *similarity, int left, int right)
+{
+    // The new right ID matches every left ID like it so far
+    similarity->score += (long long)right * histogram_count(&similarity->left, right);
+    histogram_add(&similarity->right, right);
+    // and the new left ID matches every right ID like it, including the new one
+    similarity->score += (long long)left * histogram_count(&similarity->right, left);
+    histogram_add(&similarity->left, left);
+    return similarity->score;
+}
+
+void delete_similarity(Similarity *similarity)
+{
+    delete_histogram(&similarity->left);
+    delete_histogram(&similarity->right);
+}
+
+/// @brief Read pairs a line at a time, printing the similarity score of the pairs so far after each one
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @return 0 if success, non-zero if failure
+int print_live_scores(char *input_file)
+{
+    FILE *f = input_file ? fopen(input_file, "r") : stdin;
+    if (!f)
+    {
+        perror("Error opening input file");
+        return 1;
+    }
+
+    Similarity similarity = new_similarity(LIVE_MIN_ID, LIVE_ID_RANGE);
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        Span span = {line, line + strlen(line)};
+        long long left, right;
+        if (!next_number(&span, &left) || !next_number(&span, &right))
+            continue;
+        printf("%lld\n", add_pair(&similarity, left, right));
+        fflush(stdout);
+    }
+
+    delete_similarity(&similarity);
+    if (input_file)
+        fclose(f);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+#define MIN_LEVELS 5
+#define MAX_LEVELS 8
+
+int main(int argc, char *argv[])
+{
+    long long reports = parse_generator_args(argc, argv, 1000, 1, 100000000, "The number of reports");
+    if (reports == -1)
+        return 1;
+
+    int levels[MAX_LEVELS];
+    for (long long i = 0; i < reports; i++)
+    {
+        int levels_size = random_range(MIN_LEVELS, MAX_LEVELS);
+        int direction = (next_random() & 1) ? 1 : -1;
+
+        // Start far enough from 0 that a safe report stays positive
+        levels[0] = random_range(4 * MAX_LEVELS, 99 - 4 * MAX_LEVELS);
+        for (int j = 1; j < levels_size; j++)
+            levels[j] = levels[j - 1] + direction * random_range(1, 3);
+
+        // Break about half of the reports at one level, which part 2 may be able to remove
+        if (next_random() & 1)
+            levels[random_range(0, levels_size - 1)] = random_range(1, 99);
+
+        printf("%d", levels[0]);
+        for (int j = 1; j < levels_size; j++)
+            printf(" %d", levels[j]);
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -2,42 +2,98 @@
 #include <stdlib.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/stream.h"
+#include "../runner/reports.h"
 
 DEF_VEC(int)
+DEF_VEC_CAPACITY(int)
+
+typedef struct Reports
+{
+    // Every level of every report, one report after another
+    int *levels;
+    // Where each report starts in `levels`. starts[size] is where the last one ends
+    size_t *starts;
+    // The number of reports
+    size_t size;
+} Reports;
+
+void delete_reports(Reports *reports)
+{
+    free(reports->levels);
+    free(reports->starts);
+    reports->levels = NULL;
+    reports->starts = NULL;
+    reports->size = 0UL;
+}
 
 void print_arr(int *arr, int size);
-int_Vec parse_input_row(FILE *input_text);
+int parse_input(char *input_file, Reports *reports);
+int count_safe_reports(Reports *reports);
+int check_report(ReportBatch *batch, int *report, size_t report_size);
+int flush_batch(ReportBatch *batch);
 int is_safe(int *report, size_t report_size);
+int count_safe_lines(Span lines, int worker, void *ctx, long long *safe_count);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+int stream_puzzle(char *input_file, char *answer);
 
-int main(int argc, char const *argv[])
+int main(int argc, char *argv[])
 {
-    FILE *f = fopen("input.txt", "r");
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
+    Reports reports;
+    if (parse_input(input_file, &reports))
         return 1;
+
+    for (size_t i = 0; i < reports.size; i++)
+    {
+        print_arr(&reports.levels[reports.starts[i]], reports.starts[i + 1] - reports.starts[i]);
+        printf("\n");
     }
-    // Get the first row
-    int_Vec row = parse_input_row(f);
 
-    // For counting safe reports
-    int safe_count = 0;
+    printf("Safe report count: %d\n", count_safe_reports(&reports));
+    delete_reports(&reports);
+    return 0;
+}
 
-    // Loop while the row contains any data
-    while (row.len)
+void *parse_puzzle(char *input_file)
+{
+    Reports *reports = malloc(sizeof(Reports));
+    if (parse_input(input_file, reports))
     {
-        print_arr(row.arr, row.len);
-        printf("\n");
-        if (is_safe(row.arr, row.len))
-            safe_count++;
-        free(row.arr);
-        row = parse_input_row(f);
+        free(reports);
+        return NULL;
     }
+    return reports;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    snprintf(answer, ANSWER_SIZE, "%d", count_safe_reports(puzzle));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    delete_reports(puzzle);
+    free(puzzle);
+}
 
-    printf("Safe report count: %d\n", safe_count);
+int stream_puzzle(char *input_file, char *answer)
+{
+    long long safe_count;
+    if (stream_sum(input_file, "\n", count_safe_lines, NULL, &safe_count))
+        return 1;
+    snprintf(answer, ANSWER_SIZE, "%lld", safe_count);
     return 0;
 }
 
+DEF_STREAM_SOLVER(2, 1, parse_puzzle, solve_puzzle, delete_puzzle, stream_puzzle)
+
 void print_arr(int *arr, int size)
 {
     if (size <= 0)
@@ -54,36 +110,105 @@ void print_arr(int *arr, int size)
     printf("]");
 }
 
-int_Vec parse_input_row(FILE *input_text)
+/// @brief Parse the input file into reports
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param reports Out: The reports, with their levels in one array. Delete with delete_reports
+/// @return 0 if success, non-zero if failure
+int parse_input(char *input_file, Reports *reports)
 {
+    Input input;
+    if (open_input(input_file, &input))
+        return 1;
+
+    // One report per line, and every level but the last takes at least 2 bytes with its separator, so both arrays are
+    // allocated once at their full size instead of once per report
+    Span span = input_span(&input);
+    reports->levels = malloc(sizeof(reports->levels[0]) * (((span.end - span.start) / 2) + 1));
+    reports->starts = malloc(sizeof(reports->starts[0]) * (count_lines(span) + 1));
+    reports->size = 0UL;
+    size_t levels_size = 0UL;
+    // Loop while the row contains any data
+    Span line;
+    while (next_line(&span, &line))
+    {
+        size_t start = levels_size;
+        long long level;
+        while (next_number(&line, &level))
+            reports->levels[levels_size++] = level;
+        if (levels_size == start)
+            break;
+        reports->starts[reports->size++] = start;
+    }
+    reports->starts[reports->size] = levels_size;
+
+    close_input(&input);
+    return 0;
+}
+
+/// @brief Count the safe reports in some lines of the input, without keeping them. Used by stream_sum
+/// @param lines Whole lines of the input
+/// @param worker The thread running this
+/// @param ctx Unused
+/// @param safe_count In/out: The number of safe reports, which the safe reports in `lines` are added to
+/// @return 0
+int count_safe_lines(Span lines, int worker, void *ctx, long long *safe_count)
+{
+    // One report at a time, reusing the same memory, into a batch of reports that are checked together
     int_Vec report = new_int_Vec();
-    int current_number = 0;
-    int ch = getc(input_text);
-    // Parse character by character
-    while (ch != '\n' && ch != EOF)
+    ReportBatch batch = {0};
+    Span line;
+    while (next_line(&lines, &line))
     {
-        if (ch == ' ')
-        {
-            // If a space is found, commit the last number and restart
-            append_int_Vec(&report, current_number);
-            current_number = 0;
-        }
-        else
-        {
-            // If it is a digit instead, concatenate to the current number
-            current_number = (current_number * 10) + (ch - '0');
-        }
-        ch = getc(input_text);
+        clear_int_Vec(&report);
+        long long level;
+        while (next_number(&line, &level))
+            append_int_Vec(&report, level);
+        if (report.len)
+            *safe_count += check_report(&batch, report.arr, report.len);
     }
-    // Assuming there was any numbers, append__Vec the last number
-    if (current_number)
-        append_int_Vec(&report, current_number);
+    *safe_count += flush_batch(&batch);
+    free(report.arr);
+    return 0;
+}
 
-    return report;
+/// @brief Count the safe reports. Most are checked REPORT_BATCH at a time by `safe_in_report_batch()`; `is_safe()` only
+/// checks the reports that don't fit in a batch
+/// @param reports The reports
+/// @return The number of safe reports
+int count_safe_reports(Reports *reports)
+{
+    ReportBatch batch = {0};
+    int safe_count = 0;
+    for (size_t i = 0; i < reports->size; i++)
+        safe_count += check_report(&batch, &reports->levels[reports->starts[i]], reports->starts[i + 1] - reports->starts[i]);
+    return safe_count + flush_batch(&batch);
+}
+
+/// @brief Add a report to a batch, checking the batch once it is full. Reports that don't fit in a batch are checked on
+/// their own
+/// @param batch The batch, which is emptied when it is checked
+/// @param report The levels in the report
+/// @param report_size The number of levels
+/// @return The number of safe reports that were checked: those in the batch if it was full, or this one if it didn't fit
+int check_report(ReportBatch *batch, int *report, size_t report_size)
+{
+    if (!add_to_report_batch(batch, report, report_size))
+        return is_safe(report, report_size);
+    return batch->size == REPORT_BATCH ? flush_batch(batch) : 0;
+}
+
+/// @brief Count the safe reports in a batch, then empty it
+/// @param batch The batch
+/// @return The number of safe reports in the batch
+int flush_batch(ReportBatch *batch)
+{
+    int safe_count = __builtin_popcount(safe_in_report_batch(batch));
+    clear_report_batch(batch);
+    return safe_count;
 }
 
-#define MIN_CHANGE 1
-#define MAX_CHANGE 3
+#define MIN_CHANGE REPORT_MIN_CHANGE
+#define MAX_CHANGE REPORT_MAX_CHANGE
 
 int is_safe(int *report, size_t report_size)
 {
@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../runner/generator.h"
+
+#define LINE_LENGTH 3000
+
+// Characters that appear in the corrupted memory between instructions
+const char NOISE[] = "mul(,)don't[]{}<>?!@#$%^&*+-_ '\"/:;what()select()when()from()0123456789";
+
+int main(int argc, char *argv[])
+{
+    long long length = parse_generator_args(argc, argv, 18000, 1, 10000000000LL, "The number of characters");
+    if (length == -1)
+        return 1;
+
+    char instruction[16];
+    long long written = 0;
+    long long line_length = 0;
+    while (written < length)
+    {
+        // Mostly noise, sometimes a real instruction
+        long long choice = random_range(0, 15);
+        if (choice == 0)
+            snprintf(instruction, sizeof(instruction), "mul(%lld,%lld)", random_range(1, 999), random_range(1, 999));
+        else if (choice == 1)
+            strcpy(instruction, (next_random() & 1) ? "do()" : "don't()");
+        else
+        {
+            instruction[0] = NOISE[random_range(0, sizeof(NOISE) - 2)];
+            instruction[1] = '\0';
+        }
+
+        fputs(instruction, stdout);
+        size_t instruction_length = strlen(instruction);
+        written += instruction_length;
+        line_length += instruction_length;
+        if (line_length >= LINE_LENGTH && written < length)
+        {
+            putchar('\n');
+            written++;
+            line_length = 0;
+        }
+    }
+    putchar('\n');
+
+    return 0;
+}
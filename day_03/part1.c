@@ -1,29 +1,75 @@
 #include <stdio.h>
+#include <stdlib.h>
 
-// Assert ch == c and goes to the next character. If not, continue the while loop
-#define ASSERT_CHAR(c) \
-    if (ch != c)       \
-        continue;      \
-    else               \
-        ch = getc(f)
+#include "../runner/solver.h"
+#include "../runner/input.h"
+
+// Assert *memory == c and goes to the next character. If not, continue the while loop
+#define ASSERT_CHAR(c)   \
+    if (*memory != c)    \
+        continue;        \
+    else                 \
+        memory++
 
 int is_digit(int ch) { return '0' <= ch && ch <= '9'; }
+int product_sum(char *memory);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
+int main(int argc, char *argv[])
+{
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
+    Input memory;
+    if (open_input(input_file, &memory))
+        return 1;
+
+    printf("Product sum: %d\n", product_sum(memory.data));
+    close_input(&memory);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    // The input is already a null-terminated string, so there is nothing to parse
+    Input *memory = malloc(sizeof(Input));
+    if (open_input(input_file, memory))
+    {
+        free(memory);
+        return NULL;
+    }
+    return memory;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    snprintf(answer, ANSWER_SIZE, "%d", product_sum(((Input *)puzzle)->data));
+    return 0;
+}
 
-int main(int argc, char const *argv[])
+void delete_puzzle(void *puzzle)
+{
+    close_input(puzzle);
+    free(puzzle);
+}
+
+DEF_SOLVER(3, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
+/// @brief Sum the products of every valid mul(X,Y) instruction
+/// @param memory The corrupted memory as a null-terminated string
+/// @return The sum of the products
+int product_sum(char *memory)
 {
     int product_sum = 0;
     // Left and right operands
     int lhs, rhs;
-    // Because file IO, I'm just putting the whole thing into one function
-    FILE *f = fopen("input.txt", "r");
 
     // Loop over characters
-    int ch = getc(f);
-    while (ch != EOF)
+    while (*memory)
     {
         // Seek until 'm'
-        while (ch != 'm' && ch != EOF)
-            ch = getc(f);
+        while (*memory != 'm' && *memory)
+            memory++;
 
         // Assert the rest of "mul("
         ASSERT_CHAR('m');
@@ -33,17 +79,17 @@ int main(int argc, char const *argv[])
 
         // Get digits
         lhs = 0;
-        while (is_digit(ch))
+        while (is_digit(*memory))
         {
-            lhs = (lhs * 10) + (ch - '0');
-            ch = getc(f);
+            lhs = (lhs * 10) + (*memory - '0');
+            memory++;
         }
         ASSERT_CHAR(',');
         rhs = 0;
-        while (is_digit(ch))
+        while (is_digit(*memory))
         {
-            rhs = (rhs * 10) + (ch - '0');
-            ch = getc(f);
+            rhs = (rhs * 10) + (*memory - '0');
+            memory++;
         }
         ASSERT_CHAR(')');
 
@@ -51,6 +97,5 @@ int main(int argc, char const *argv[])
         product_sum += lhs * rhs;
     }
 
-    printf("Product sum: %d\n", product_sum);
-    return 0;
+    return product_sum;
 }
@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 140, 1, 100000, "The number of rows and columns");
+    if (size == -1)
+        return 1;
+
+    for (long long row = 0; row < size; row++)
+    {
+        for (long long col = 0; col < size; col++)
+            putchar("XMAS"[next_random() & 3]);
+        putchar('\n');
+    }
+
+    return 0;
+}
@@ -3,73 +3,103 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
 
 // Define char and char* vectors
 typedef char *string;
 DEF_VEC(char)
 DEF_VEC(string)
+// The rows point into the input, so only the array of rows is freed
 void delete_string_vec(string_Vec *vec)
 {
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
     free(vec->arr);
     vec->arr = NULL;
     vec->len = 0UL;
     vec->cap = 0UL;
 }
 
-// Load input.txt into string_Vec
-string_Vec parse_input();
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    // The rows of the crossword point into the input
+    Input input;
+    string_Vec crossword;
+} Puzzle;
+
+// Load the input file into string_Vec
+int parse_input(char *input_file, Input *input, string_Vec *crossword);
 // Count all matches in the crossword
 int count_matches(char **crossword, size_t row_count);
 // Returns 1 if  crossword[row][col] is the a in an "X-MAS"
 int matches_with_start(char **crossword, size_t row_count, size_t row, size_t col);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
-int main(int argc, char const *argv[])
+int main(int argc, char *argv[])
 {
-    string_Vec crossword = parse_input();
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
+    Input input;
+    string_Vec crossword;
+    if (parse_input(input_file, &input, &crossword))
+        return 1;
+
     printf("Match count: %d\n", count_matches(crossword.arr, crossword.len));
     delete_string_vec(&crossword);
+    close_input(&input);
     return 0;
 }
 
-string_Vec parse_input()
+void *parse_puzzle(char *input_file)
 {
-    // Open input.txt or panic
-    FILE *f = fopen("input.txt", "r");
-    if (f == NULL)
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->input, &puzzle->crossword))
     {
-        perror("Error opening input file");
-        exit(1);
+        free(puzzle);
+        return NULL;
     }
+    return puzzle;
+}
 
-    string_Vec output = new_string_Vec();
-    // Loop over characters in the file
-    int ch;
-    char_Vec row = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
-    {
-        if (ch == '\n')
-        {
-            // Add terminator for the string and put it on the string vector
-            append_char_Vec(&row, '\0');
-            append_string_Vec(&output, row.arr);
-            // Generate a new char vector for the next iteration
-            row = new_char_Vec();
-        }
-        else
-            append_char_Vec(&row, (char)ch);
-    }
-    // If relevant, append__Vec the last row. Otherwise, just free the row
-    if (row.len > 0)
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%d", count_matches(p->crossword.arr, p->crossword.len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    delete_string_vec(&p->crossword);
+    close_input(&p->input);
+    free(p);
+}
+
+DEF_SOLVER(4, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
+/// @brief Parse the input file into a vector of rows
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param input Out: The input, which must be closed after the crossword is deleted
+/// @param crossword Out: The crossword as a vector of null-terminated rows
+/// @return 0 if success, non-zero if failure
+int parse_input(char *input_file, Input *input, string_Vec *crossword)
+{
+    if (open_input(input_file, input))
+        return 1;
+
+    Span span = input_span(input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        append_char_Vec(&row, '\0');
-        append_string_Vec(&output, row.arr);
+        fprintf(stderr, "Expected a rectangular crossword\n");
+        close_input(input);
+        return 1;
     }
-    else
-        free(row.arr);
 
-    return output;
+    *crossword = (string_Vec){grid_rows(grid), grid.rows, grid.rows};
+    return 0;
 }
 
 // Count matches of "XMAS" in any direction
@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// The number of distinct pages. The real input orders 49 pages completely
+#define PAGE_COUNT 49
+#define MIN_UPDATE_SIZE 5
+#define MAX_UPDATE_SIZE 23
+
+int main(int argc, char *argv[])
+{
+    long long updates = parse_generator_args(argc, argv, 200, 1, 100000000, "The number of updates");
+    if (updates == -1)
+        return 1;
+
+    // Pick PAGE_COUNT distinct 2 digit pages in a random order, which is the order the rules describe
+    int pages[90];
+    for (int i = 0; i < 90; i++)
+        pages[i] = i + 10;
+    shuffle_ints(pages, 90);
+
+    // One rule for every pair, in a random order
+    int rules_size = PAGE_COUNT * (PAGE_COUNT - 1) / 2;
+    int *rules = malloc(sizeof(rules[0]) * rules_size);
+    int rule_index = 0;
+    for (int i = 0; i < PAGE_COUNT; i++)
+        for (int j = i + 1; j < PAGE_COUNT; j++)
+            rules[rule_index++] = i * PAGE_COUNT + j;
+    shuffle_ints(rules, rules_size);
+    for (int i = 0; i < rules_size; i++)
+        printf("%d|%d\n", pages[rules[i] / PAGE_COUNT], pages[rules[i] % PAGE_COUNT]);
+    free(rules);
+    printf("\n");
+
+    int indexes[PAGE_COUNT];
+    for (long long i = 0; i < updates; i++)
+    {
+        // Choose an odd number of pages so there is a middle page
+        int update_size = random_range(MIN_UPDATE_SIZE / 2, MAX_UPDATE_SIZE / 2) * 2 + 1;
+        for (int j = 0; j < PAGE_COUNT; j++)
+            indexes[j] = j;
+        shuffle_ints(indexes, PAGE_COUNT);
+
+        // About half of the updates are already in order
+        if (next_random() & 1)
+            for (int j = 1; j < update_size; j++)
+                for (int k = j; k > 0 && indexes[k - 1] > indexes[k]; k--)
+                {
+                    int temp = indexes[k];
+                    indexes[k] = indexes[k - 1];
+                    indexes[k - 1] = temp;
+                }
+
+        printf("%d", pages[indexes[0]]);
+        for (int j = 1; j < update_size; j++)
+            printf(",%d", pages[indexes[j]]);
+        printf("\n");
+    }
+
+    return 0;
+}
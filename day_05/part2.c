@@ -3,6 +3,9 @@
 #include <stdbool.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
 
 typedef struct OrderRule
 {
@@ -11,8 +14,11 @@ typedef struct OrderRule
 } OrderRule;
 
 DEF_VEC(OrderRule)
+DEF_VEC_CAPACITY(OrderRule)
 DEF_VEC(short)
+DEF_VEC_CAPACITY(short)
 DEF_VEC(short_Vec)
+DEF_VEC_CAPACITY(short_Vec)
 void delete_short_vec_vec(short_Vec_Vec *vec)
 {
     for (int i = 0; i < vec->len; i++)
@@ -25,19 +31,30 @@ void delete_short_vec_vec(short_Vec_Vec *vec)
     vec->cap = 0UL;
 }
 
-int parse_input(OrderRule_Vec *order_rules, short_Vec_Vec *updates);
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    OrderRule_Vec order_rules;
+    short_Vec_Vec updates;
+} Puzzle;
+
+int parse_input(char *input_file, OrderRule_Vec *order_rules, short_Vec_Vec *updates);
 int sum_of_corrected_invalid_middles(OrderRule *order_rules, size_t order_rules_size, short_Vec_Vec updates);
 bool is_valid_update(OrderRule *order_rules, size_t order_rules_size, short *pages, size_t pages_size);
 short *pages_that_must_follow(OrderRule *active_order_rules, size_t active_order_rules_size, short n, size_t *following_pages_count);
 bool arr_contains(short *arr, size_t arr_size, short n);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
-int main(int argc, char const *argv[])
+int main(int argc, char *argv[])
 {
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
     OrderRule_Vec order_rules;
     short_Vec_Vec updates;
 
     // Try to parse input
-    if (parse_input(&order_rules, &updates))
+    if (parse_input(input_file, &order_rules, &updates))
         return 1;
 
     printf("Sum of valid middle pages: %d\n", sum_of_corrected_invalid_middles(order_rules.arr, order_rules.len, updates));
@@ -47,66 +64,81 @@ int main(int argc, char const *argv[])
     return 0;
 }
 
-/// @brief Parse input.txt for this puzzle's input
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->order_rules, &puzzle->updates))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%d", sum_of_corrected_invalid_middles(p->order_rules.arr, p->order_rules.len, p->updates));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    free(p->order_rules.arr);
+    delete_short_vec_vec(&p->updates);
+    free(p);
+}
+
+DEF_SOLVER(5, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
+/// @brief Parse the input file for this puzzle's input
+/// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param order_rules out parameter for the order rules vector
 /// @param updates out parameter of updates as a 2D vector. Each row is an update consisting of multiple pages
 /// @return `0` if successful. Some nonzero number if unsuccessful (i.e. IO error)
-int parse_input(OrderRule_Vec *order_rules, short_Vec_Vec *updates)
+int parse_input(char *input_file, OrderRule_Vec *order_rules, short_Vec_Vec *updates)
 {
-    FILE *f = fopen("input.txt", "r");
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
-
-    *order_rules = new_OrderRule_Vec();
-    *updates = new_short_Vec_Vec();
 
-    // Get the rule as a string because fscanf does weird things with whitespaces
-    char rule_str[7];
-    while (fgets(rule_str, sizeof(rule_str), f)[0] != '\n')
+    // The rules end at a blank line. There can't be more rules than lines, and the extra room is given back after
+    Span span = input_span(&input);
+    *order_rules = with_capacity_OrderRule_Vec(count_lines(span));
+    Span line;
+    while (next_line(&span, &line) && line.start != line.end)
     {
-        // rule_str should always be in the form "dd|dd\n"
-        if (rule_str[0] < '0' || rule_str[0] > '9' ||
-            rule_str[1] < '0' || rule_str[1] > '9' ||
-            rule_str[2] != '|' ||
-            rule_str[3] < '0' || rule_str[3] > '9' ||
-            rule_str[4] < '0' || rule_str[4] > '9' ||
-            rule_str[5] != '\n')
+        // The rule should always be in the form "dd|dd"
+        Span rule = line;
+        long long first, second;
+        if (!parse_number(&rule, &first) || !skip_prefix(&rule, "|") || !parse_number(&rule, &second) || rule.start != rule.end)
         {
-            fprintf(stderr, "Unexpected line '%s' when reading rules.\n", rule_str);
-            fclose(f);
+            fprintf(stderr, "Unexpected line '%.*s' when reading rules.\n", (int)span_size(line), line.start);
+            close_input(&input);
             return 1;
         }
-        // Parse as 2-digit base 10 numbers
-        short first = ((rule_str[0] - '0') * 10) + (rule_str[1] - '0');
-        short second = ((rule_str[3] - '0') * 10) + (rule_str[4] - '0');
         append_OrderRule_Vec(order_rules, (OrderRule){first, second});
     }
-    if (ferror(f))
-    {
-        perror("Error reading from input file");
-        fclose(f);
-        return 1;
-    }
+    shrink_OrderRule_Vec(order_rules);
 
-    // Parse the updates
-    // Loop over lines
-    short first_page;
-    while (fscanf(f, "%2hd", &first_page) == 1)
+    // Parse the updates, one per line
+    *updates = with_capacity_short_Vec_Vec(count_lines(span));
+    while (next_line(&span, &line))
     {
-        short_Vec update = {malloc(sizeof(short)), 1, 1};
-        update.arr[0] = first_page;
-        // Parse the rest of the update
-        short page;
-        while (fscanf(f, ",%2hd", &page) == 1)
+        // Each page is "dd,", so this is exactly enough room
+        short_Vec update = with_capacity_short_Vec(span_size(line) / 3 + 1);
+        long long page;
+        while (next_number(&line, &page))
             append_short_Vec(&update, page);
         // Add the new update
-        append_short_Vec_Vec(updates, update);
+        if (update.len)
+            append_short_Vec_Vec(updates, update);
+        else
+            free(update.arr);
     }
 
-    fclose(f);
+    close_input(&input);
     return 0;
 }
 
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "../runner/generator.h"
+
+// Roughly 1 in OBSTACLE_RARITY tiles is an obstacle, like the real input
+#define OBSTACLE_RARITY 20
+// The number of starting positions to try on each map
+#define GUARD_ATTEMPTS 100
+
+long long count_guard_steps(char *map, long long size, long long row, long long col);
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 130, 2, 65536, "The number of rows and columns");
+    if (size == -1)
+        return 1;
+
+    char *map = malloc(size * size);
+    long long guard_row = 0, guard_col = 0;
+
+    // Part 1 only makes sense if the guard leaves, and part 2 is trivial if they leave right away,
+    // so use the starting position with the longest walk out of a few tries
+    long long best_steps = 0;
+    while (!best_steps)
+    {
+        for (long long i = 0; i < size * size; i++)
+            map[i] = random_range(1, OBSTACLE_RARITY) == 1 ? '#' : '.';
+
+        for (int i = 0; i < GUARD_ATTEMPTS; i++)
+        {
+            long long row = random_range(0, size - 1);
+            long long col = random_range(0, size - 1);
+            if (map[row * size + col] == '#')
+                continue;
+            long long steps = count_guard_steps(map, size, row, col);
+            if (steps > best_steps)
+            {
+                best_steps = steps;
+                guard_row = row;
+                guard_col = col;
+            }
+        }
+    }
+
+    map[guard_row * size + guard_col] = '^';
+    for (long long row = 0; row < size; row++)
+    {
+        fwrite(map + row * size, 1, size, stdout);
+        putchar('\n');
+    }
+
+    free(map);
+    return 0;
+}
+
+/// @brief Walk the guard from their starting position, facing up
+/// @param map The map, with '#' for obstacles
+/// @param size The number of rows and columns in `map`
+/// @param row The starting row
+/// @param col The starting column
+/// @return The number of steps before the guard leaves the map, or 0 if they loop
+long long count_guard_steps(char *map, long long size, long long row, long long col)
+{
+    const int ROW_STEP[] = {-1, 0, 1, 0};
+    const int COL_STEP[] = {0, 1, 0, -1};
+
+    int dir = 0;
+    long long steps = 0;
+    // Brent's cycle detection: Remember a state, and if the guard gets back to it, they are in a loop.
+    // The remembered state moves forward every power of 2 steps so it eventually lands inside any loop.
+    long long saved_row = row, saved_col = col;
+    int saved_dir = dir;
+    long long next_save = 1;
+    while (true)
+    {
+        long long next_row = row + ROW_STEP[dir];
+        long long next_col = col + COL_STEP[dir];
+        if (next_row < 0 || next_row >= size || next_col < 0 || next_col >= size)
+            return steps;
+        if (map[next_row * size + next_col] == '#')
+            dir = (dir + 1) & 3;
+        else
+        {
+            row = next_row;
+            col = next_col;
+        }
+        steps++;
+
+        if (row == saved_row && col == saved_col && dir == saved_dir)
+            return 0;
+        if (steps == next_save)
+        {
+            saved_row = row;
+            saved_col = col;
+            saved_dir = dir;
+            next_save *= 2;
+        }
+    }
+}
@@ -3,164 +3,156 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-
-// Define char and char* vectors
-typedef char *string;
-DEF_VEC(char)
-DEF_VEC(string)
-void delete_string_vec(string_Vec *vec)
-{
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
-    free(vec->arr);
-    vec->arr = NULL;
-    vec->len = 0UL;
-    vec->cap = 0UL;
-}
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/grid.h"
 
 // Define guard so we can make methods to move the guard
 
+// The same values as GridDirection, so a direction can index the map's steps
 typedef enum Direction
 {
-    UP,
-    RIGHT,
-    DOWN,
-    LEFT,
+    RIGHT = GRID_EAST,
+    UP = GRID_NORTH,
+    LEFT = GRID_WEST,
+    DOWN = GRID_SOUTH,
 } Direction;
 typedef struct Guard
 {
-    short row;
-    short col;
+    // The index of the guard's cell in the map
+    int index;
     Direction dir;
 } Guard;
 
-int parse_input(string_Vec *map, Guard *guard);
-int move_guard(Guard *guard, char **map, size_t row_count);
-// Rotate direction right and return the rotated direction
-Direction rotate_right(Direction dir) { return (dir + 1) % (LEFT + 1); }
-int unique_visited_tiles(char **map, size_t row_count, Guard *guard);
-void print_map(char **map, size_t row_count);
-char peek_guard(Guard guard, char **map, size_t row_count);
-
-int main(int argc, char const *argv[])
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    Grid map;
+    Guard guard;
+} Puzzle;
+
+int parse_input(char *input_file, Grid *map, Guard *guard);
+int move_guard(Guard *guard, Grid map);
+// Rotate direction right and return the rotated direction. Directions are counter-clockwise, so this goes back one
+Direction rotate_right(Direction dir) { return (dir + GRID_DIRECTIONS - 1) % GRID_DIRECTIONS; }
+int unique_visited_tiles(Grid map, Guard *guard);
+char peek_guard(Guard guard, Grid map);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
+int main(int argc, char *argv[])
 {
-    string_Vec map;
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
+    Grid map;
     Guard guard;
 
     // Parse input
-    if (parse_input(&map, &guard))
+    if (parse_input(input_file, &map, &guard))
         return 1;
 
     // Count tiles and update the map
-    int unique_tiles = unique_visited_tiles(map.arr, map.len, &guard);
+    int unique_tiles = unique_visited_tiles(map, &guard);
 
     // Print the map after the update
     printf("Map after updates:\n");
-    print_map(map.arr, map.len);
+    print_grid(map);
 
     // Print the answer
     printf("\nUnique visited tiles: %d\n", unique_tiles);
 
-    delete_string_vec(&map);
+    delete_grid(&map);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->map, &puzzle->guard))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%d", unique_visited_tiles(p->map, &p->guard));
     return 0;
 }
 
-/// @brief Parse input.txt, returning a map and the guard
+void delete_puzzle(void *puzzle)
+{
+    delete_grid(&((Puzzle *)puzzle)->map);
+    free(puzzle);
+}
+
+DEF_SOLVER(6, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
+/// @brief Parse the input file, returning a map and the guard
+/// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param map Out parameter: The map for the puzzle
 /// @param guard Out parameter: location and direction of the guard on the map
 /// @return 0 if successful. Some nonzero number if unsuccessful (i.e. IO error)
-int parse_input(string_Vec *map, Guard *guard)
+int parse_input(char *input_file, Grid *map, Guard *guard)
 {
-    // Open input.txt or panic
-    FILE *f = fopen("input.txt", "r");
-    if (f == NULL)
+    Input input;
+    if (open_input(input_file, &input))
+        return 1;
+
+    Span span = input_span(&input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        perror("Error opening input file");
+        fprintf(stderr, "Expected a rectangular map\n");
+        close_input(&input);
         return 1;
     }
 
-    *map = new_string_Vec();
-    // Loop over characters in the file
-    int ch;
-    char_Vec row = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
-    {
-        if (ch == '.' || ch == '#')
-        {
-            append_char_Vec(&row, (char)ch);
-        }
-        else if (ch == '^' || ch == '>' || ch == 'v' || ch == '<')
+    // Find the guard, and check that everything else is floor or an obstacle
+    size_t guard_row = 0UL, guard_col = 0UL;
+    for (size_t row = 0; row < grid.rows; row++)
+        for (size_t col = 0; col < grid.cols; col++)
         {
-            switch (ch)
+            char ch = GRID_AT(grid, row, col);
+            if (ch == '.' || ch == '#')
+                continue;
+
+            int dir = grid_direction(ch);
+            if (dir < 0)
             {
-            case '^':
-                guard->dir = UP;
-                break;
-            case '>':
-                guard->dir = RIGHT;
-                break;
-            case 'v':
-                guard->dir = DOWN;
-                break;
-            default: // '<'
-                guard->dir = LEFT;
+                fprintf(stderr, "Unexpected character: '%c'\n", ch);
+                close_input(&input);
+                return 1;
             }
-            guard->row = map->len;
-            guard->col = row.len;
-            append_char_Vec(&row, (char)ch);
-        }
-        else if (ch == '\n')
-        {
-            // Add terminator for the string and put it on the string vector
-            append_char_Vec(&row, '\0');
-            append_string_Vec(map, row.arr);
-            // Generate a new char vector for the next iteration
-            row = new_char_Vec();
+            guard->dir = dir;
+            guard_row = row;
+            guard_col = col;
         }
-        else
-        {
-            free(row.arr);
-            delete_string_vec(map);
-            fprintf(stderr, "Unexpected character: '%c'\n", (char)ch);
-            return 1;
-        }
-    }
-    // If relevant, append__Vec the last row. Otherwise, just free the row
-    if (row.len > 0)
-    {
-        append_char_Vec(&row, '\0');
-        append_string_Vec(map, row.arr);
-    }
-    else
-        free(row.arr);
 
+    // Anything past the edge of the map is '\0', so the guard can see when it is about to leave
+    *map = grid_from_view(grid, 1, '\0');
+    guard->index = GRID_INDEX(*map, guard_row, guard_col);
+    close_input(&input);
     return 0;
 }
 
-/// @brief Prints `map` to stdout
-/// @param map The map
-/// @param row_count The number of rows in `map`
-void print_map(char **map, size_t row_count)
-{
-    for (size_t i = 0; i < row_count; i++)
-        printf("%s\n", map[i]);
-}
-
 /// @brief Count unique tiles visited by guard, including the one it's on. Will also turn those tiles into 'X' on the board
 /// @param map The map
-/// @param row_count The number of rows in `map`
 /// @param guard The guard location and direction
 /// @return The number of unique visited tiles
-int unique_visited_tiles(char **map, size_t row_count, Guard *guard)
+int unique_visited_tiles(Grid map, Guard *guard)
 {
     // Start at 1 because the guard is already on one tile
     int unique_tiles = 1;
-    map[guard->row][guard->col] = 'X';
+    map.cells[guard->index] = 'X';
     // Get the maximum number of tiles as a safeguard in case we get stuck
-    int max_tiles = row_count * strlen(map[0]);
+    int max_tiles = map.rows * map.cols;
     for (int i = 0; i < max_tiles; i++)
     {
-        int move = move_guard(guard, map, row_count);
+        int move = move_guard(guard, map);
         if (move == -1)
             break;
         else if (move == 1)
@@ -171,13 +163,12 @@ int unique_visited_tiles(char **map, size_t row_count, Guard *guard)
 
 /// @brief Move a guard one step
 /// @param guard The guard's location and direction
-/// @param map The map as a 2D character array
-/// @param row_count The number of rows in map (columns is irrelevant because each row is a null-terminated string)
+/// @param map The map
 /// @return 0 if the new square has already been visited, 1 if the new square has not been visited, -1 if the new square is off the map or the guard is stuck
-int move_guard(Guard *guard, char **map, size_t row_count)
+int move_guard(Guard *guard, Grid map)
 {
     int new_tile;
-    switch (peek_guard(*guard, map, row_count))
+    switch (peek_guard(*guard, map))
     {
     case '\0':
         // Off the map
@@ -186,7 +177,7 @@ int move_guard(Guard *guard, char **map, size_t row_count)
         // Obstacle rotate and try again
         guard->dir = rotate_right(guard->dir);
         // Return instead of moving again
-        return move_guard(guard, map, row_count);
+        return move_guard(guard, map);
     case 'X':
         // Not a new tile
         new_tile = 0;
@@ -197,57 +188,18 @@ int move_guard(Guard *guard, char **map, size_t row_count)
     }
 
     // Move the guard
-    switch (guard->dir)
-    {
-    case UP:
-        guard->row--;
-        break;
-    case RIGHT:
-        guard->col++;
-        break;
-    case DOWN:
-        guard->row++;
-        break;
-    default: // LEFT
-        guard->col--;
-    }
-    map[guard->row][guard->col] = 'X';
+    guard->index += map.step[guard->dir];
+    map.cells[guard->index] = 'X';
 
     return new_tile;
 }
 
 /// @brief Determine what tile the guard will move to next to determine if the guard should spin or move forward
 /// @param guard The guard's location and direction
-/// @param map The map as a 2D character array
-/// @param row_count The number of rows in map (columns is irrelevant because each row is a null-terminated string)
+/// @param map The map
 /// @return The tile the guard is looking at, or '\0' if the guard is looking off the board
-char peek_guard(Guard guard, char **map, size_t row_count)
+char peek_guard(Guard guard, Grid map)
 {
-    char next_tile;
-    switch (guard.dir)
-    {
-    case UP:
-        // Determine if this would put the guard off the map
-        if (guard.row < 1)
-            next_tile = '\0';
-        else
-            next_tile = map[guard.row - 1][guard.col];
-        break;
-    case RIGHT:
-        // This is the only one that doesn't need explicit validation because the string is null-terminated anyway
-        next_tile = map[guard.row][guard.col + 1];
-        break;
-    case DOWN:
-        if (guard.row + 1 >= row_count)
-            next_tile = '\0';
-        else
-            next_tile = map[guard.row + 1][guard.col];
-        break;
-    default: // LEFT
-        if (guard.col < 1)
-            next_tile = '\0';
-        else
-            next_tile = map[guard.row][guard.col - 1];
-    }
-    return next_tile;
+    // The border is '\0', so this never needs to check the edges
+    return map.cells[guard.index + map.step[guard.dir]];
 }
@@ -3,207 +3,207 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-
-// Define char and char* vectors
-typedef char *string;
-DEF_VEC(char)
-DEF_VEC(string)
-void delete_string_vec(string_Vec *vec)
-{
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
-    free(vec->arr);
-    vec->arr = NULL;
-    vec->len = 0UL;
-    vec->cap = 0UL;
-}
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/grid.h"
+#include "../runner/thread_pool.h"
 
 // Define guard so we can make methods to move the guard
 
+// The same values as GridDirection, so a direction can index the map's steps
 typedef enum Direction
 {
-    UP,
-    RIGHT,
-    DOWN,
-    LEFT,
+    RIGHT = GRID_EAST,
+    UP = GRID_NORTH,
+    LEFT = GRID_WEST,
+    DOWN = GRID_SOUTH,
 } Direction;
 typedef struct Guard
 {
-    short row;
-    short col;
+    // The index of the guard's cell in the map
+    int index;
     Direction dir;
 } Guard;
 
-typedef struct Position
+// The positions the guard visits are indices into the map
+DEF_VEC(int)
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    Grid map;
+    Guard guard;
+} Puzzle;
+
+int parse_input(char *input_file, Grid *map, Guard *guard);
+int move_guard(Guard *guard, Grid map);
+// Rotate direction right and return the rotated direction. Directions are counter-clockwise, so this goes back one
+Direction rotate_right(Direction dir) { return (dir + GRID_DIRECTIONS - 1) % GRID_DIRECTIONS; }
+// The change in index for one step in `dir`. Computing it from the stride makes the loop search about three times as fast
+// as loading it from map.step
+static inline int step_in(Grid map, Direction dir)
 {
-    int row;
-    int col;
-} Position;
-DEF_VEC(Position);
-
-int parse_input(string_Vec *map, Guard *guard);
-int move_guard(Guard *guard, char **map, size_t row_count);
-// Rotate direction right and return the rotated direction
-Direction rotate_right(Direction dir) { return (dir + 1) % (LEFT + 1); }
-Position_Vec unique_visited_tiles(char **map, size_t row_count, Guard guard);
-void print_map(char **map, size_t row_count);
-char peek_guard(Guard guard, char **map, size_t row_count);
-int obstructions_that_create_loops(char **map, size_t map_row_count, Position *positions_to_try, size_t positions_to_try_size, Guard guard);
-int contains_loop(char **map, size_t map_row_count, Guard guard);
-int move_guard_with_direction(Guard *guard, char **map, size_t row_count);
-
-int main(int argc, char const *argv[])
+    // North and south move a row, and north and west move backwards
+    int step = (dir & 1) ? map.stride : 1;
+    return ((dir + 1) & 2) ? -step : step;
+}
+int_Vec unique_visited_tiles(Grid map, Guard guard);
+static inline char peek_guard(Guard guard, Grid map);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+int obstructions_that_create_loops(Grid map, int *positions_to_try, size_t positions_to_try_size, Guard guard);
+static inline int contains_loop(Grid map, Guard guard);
+static inline int move_guard_with_direction(Guard *guard, Grid map);
+void reset_visited_tiles(Grid map);
+
+int main(int argc, char *argv[])
 {
-    string_Vec map;
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
+    Grid map;
     Guard guard;
 
     // Parse input
-    if (parse_input(&map, &guard))
+    if (parse_input(input_file, &map, &guard))
         return 1;
 
     // Count tiles and update the map
-    Position_Vec unique_tiles = unique_visited_tiles(map.arr, map.len, guard);
+    int_Vec unique_tiles = unique_visited_tiles(map, guard);
 
     // Print the map after the update
     printf("Map after updates:\n");
-    print_map(map.arr, map.len);
+    print_grid(map);
 
     // Print the answer
     printf("\nUnique visited tiles: %d\n", (int)unique_tiles.len + 1);
 
-    // Return every 'X' back to '.'
-    for (size_t i = 0; i < map.len; i++)
+    reset_visited_tiles(map);
+    printf("Number of places for an obstacle that will create a loop: %d\n", obstructions_that_create_loops(map, unique_tiles.arr, unique_tiles.len, guard));
+
+    // Free everything
+    free(unique_tiles.arr);
+    delete_grid(&map);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->map, &puzzle->guard))
     {
-        char *row = map.arr[i];
-        while (*row)
-        {
-            if (*row == 'X')
-                *row = '.';
-            row++;
-        }
+        free(puzzle);
+        return NULL;
     }
-    printf("Number of places for an obstacle that will create a loop: %d\n", obstructions_that_create_loops(map.arr, map.len, unique_tiles.arr, unique_tiles.len, guard));
+    return puzzle;
+}
 
-    // Free everything
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    int_Vec unique_tiles = unique_visited_tiles(p->map, p->guard);
+    reset_visited_tiles(p->map);
+    snprintf(answer, ANSWER_SIZE, "%d", obstructions_that_create_loops(p->map, unique_tiles.arr, unique_tiles.len, p->guard));
     free(unique_tiles.arr);
-    delete_string_vec(&map);
     return 0;
 }
 
-/// @brief Parse input.txt, returning a map and the guard
+void delete_puzzle(void *puzzle)
+{
+    delete_grid(&((Puzzle *)puzzle)->map);
+    free(puzzle);
+}
+
+DEF_SOLVER(6, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
+/// @brief Parse the input file, returning a map and the guard
+/// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param map Out parameter: The map for the puzzle
 /// @param guard Out parameter: location and direction of the guard on the map
 /// @return 0 if successful. Some nonzero number if unsuccessful (i.e. IO error)
-int parse_input(string_Vec *map, Guard *guard)
+int parse_input(char *input_file, Grid *map, Guard *guard)
 {
-    // Open input.txt or panic
-    FILE *f = fopen("input.txt", "r");
-    if (f == NULL)
+    Input input;
+    if (open_input(input_file, &input))
+        return 1;
+
+    Span span = input_span(&input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        perror("Error opening input file");
+        fprintf(stderr, "Expected a rectangular map\n");
+        close_input(&input);
         return 1;
     }
 
-    *map = new_string_Vec();
-    // Loop over characters in the file
-    int ch;
-    char_Vec row = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
-    {
-        if (ch == '.' || ch == '#')
-        {
-            append_char_Vec(&row, (char)ch);
-        }
-        else if (ch == '^' || ch == '>' || ch == 'v' || ch == '<')
+    // Find the guard, and check that everything else is floor or an obstacle
+    size_t guard_row = 0UL, guard_col = 0UL;
+    for (size_t row = 0; row < grid.rows; row++)
+        for (size_t col = 0; col < grid.cols; col++)
         {
-            switch (ch)
+            char ch = GRID_AT(grid, row, col);
+            if (ch == '.' || ch == '#')
+                continue;
+
+            int dir = grid_direction(ch);
+            if (dir < 0)
             {
-            case '^':
-                guard->dir = UP;
-                break;
-            case '>':
-                guard->dir = RIGHT;
-                break;
-            case 'v':
-                guard->dir = DOWN;
-                break;
-            default: // '<'
-                guard->dir = LEFT;
+                fprintf(stderr, "Unexpected character: '%c'\n", ch);
+                close_input(&input);
+                return 1;
             }
-            guard->row = map->len;
-            guard->col = row.len;
-            append_char_Vec(&row, (char)ch);
-        }
-        else if (ch == '\n')
-        {
-            // Add terminator for the string and put it on the string vector
-            append_char_Vec(&row, '\0');
-            append_string_Vec(map, row.arr);
-            // Generate a new char vector for the next iteration
-            row = new_char_Vec();
+            guard->dir = dir;
+            guard_row = row;
+            guard_col = col;
         }
-        else
-        {
-            free(row.arr);
-            delete_string_vec(map);
-            fprintf(stderr, "Unexpected character: '%c'\n", (char)ch);
-            return 1;
-        }
-    }
-    // If relevant, append__Vec the last row. Otherwise, just free the row
-    if (row.len > 0)
-    {
-        append_char_Vec(&row, '\0');
-        append_string_Vec(map, row.arr);
-    }
-    else
-        free(row.arr);
 
+    // Anything past the edge of the map is '\0', so the guard can see when it is about to leave
+    *map = grid_from_view(grid, 1, '\0');
+    guard->index = GRID_INDEX(*map, guard_row, guard_col);
+    close_input(&input);
     return 0;
 }
 
-/// @brief Prints `map` to stdout
-/// @param map The map
-/// @param row_count The number of rows in `map`
-void print_map(char **map, size_t row_count)
-{
-    for (size_t i = 0; i < row_count; i++)
-        printf("%s\n", map[i]);
-}
-
 /// @brief Count unique tiles visited by guard, including the one it's on. Will also turn those tiles into 'X' on the board
 /// @param map The map
-/// @param row_count The number of rows in `map`
 /// @param guard The guard location and direction
 /// @return All unique visited tiles, excluding the guard start
-Position_Vec unique_visited_tiles(char **map, size_t row_count, Guard guard)
+int_Vec unique_visited_tiles(Grid map, Guard guard)
 {
-    Position_Vec unique_tiles = new_Position_Vec();
+    int_Vec unique_tiles = new_int_Vec();
     // Mark the starting point as visited to prevent it from being added to the vector
-    map[guard.row][guard.col] = 'X';
+    map.cells[guard.index] = 'X';
     // Get the maximum number of tiles as a safeguard in case we get stuck
-    int max_tiles = row_count * strlen(map[0]);
+    int max_tiles = map.rows * map.cols;
     for (int i = 0; i < max_tiles; i++)
     {
-        int move = move_guard(&guard, map, row_count);
+        int move = move_guard(&guard, map);
         if (move == -1)
             break;
         // Check if this a new tile and it's not the start tile
         else if (move == 1)
-            append_Position_Vec(&unique_tiles, (Position){(int)(guard.row), (int)(guard.col)});
+            append_int_Vec(&unique_tiles, guard.index);
     }
     return unique_tiles;
 }
 
+/// @brief Return every 'X' back to '.'
+/// @param map The map
+void reset_visited_tiles(Grid map)
+{
+    // The border is never visited, so this can go over every cell
+    for (size_t i = 0; i < map.size; i++)
+        if (map.cells[i] == 'X')
+            map.cells[i] = '.';
+}
+
 /// @brief Move a guard one step
 /// @param guard The guard's location and direction
-/// @param map The map as a 2D character array
-/// @param row_count The number of rows in map (columns is irrelevant because each row is a null-terminated string)
+/// @param map The map
 /// @return 0 if the new square has already been visited, 1 if the new square has not been visited, -1 if the new square is off the map or the guard is stuck
-int move_guard(Guard *guard, char **map, size_t row_count)
+int move_guard(Guard *guard, Grid map)
 {
     int new_tile;
-    switch (peek_guard(*guard, map, row_count))
+    switch (peek_guard(*guard, map))
     {
     case '\0':
         // Off the map
@@ -212,7 +212,7 @@ int move_guard(Guard *guard, char **map, size_t row_count)
         // Obstacle rotate and try again
         guard->dir = rotate_right(guard->dir);
         // Return instead of moving again
-        return move_guard(guard, map, row_count);
+        return move_guard(guard, map);
     case 'X':
         // Not a new tile
         new_tile = 0;
@@ -223,145 +223,83 @@ int move_guard(Guard *guard, char **map, size_t row_count)
     }
 
     // Move the guard
-    switch (guard->dir)
-    {
-    case UP:
-        guard->row--;
-        break;
-    case RIGHT:
-        guard->col++;
-        break;
-    case DOWN:
-        guard->row++;
-        break;
-    default: // LEFT
-        guard->col--;
-    }
-    map[guard->row][guard->col] = 'X';
+    guard->index += map.step[guard->dir];
+    map.cells[guard->index] = 'X';
 
     return new_tile;
 }
 
 /// @brief Determine what tile the guard will move to next to determine if the guard should spin or move forward
 /// @param guard The guard's location and direction
-/// @param map The map as a 2D character array
-/// @param row_count The number of rows in map (columns is irrelevant because each row is a null-terminated string)
+/// @param map The map
 /// @return The tile the guard is looking at, or '\0' if the guard is looking off the board
-char peek_guard(Guard guard, char **map, size_t row_count)
+static inline char peek_guard(Guard guard, Grid map)
 {
-    char next_tile;
-    switch (guard.dir)
-    {
-    case UP:
-        // Determine if this would put the guard off the map
-        if (guard.row < 1)
-            next_tile = '\0';
-        else
-            next_tile = map[guard.row - 1][guard.col];
-        break;
-    case RIGHT:
-        // This is the only one that doesn't need explicit validation because the string is null-terminated anyway
-        next_tile = map[guard.row][guard.col + 1];
-        break;
-    case DOWN:
-        if (guard.row + 1 >= row_count)
-            next_tile = '\0';
-        else
-            next_tile = map[guard.row + 1][guard.col];
-        break;
-    default: // LEFT
-        if (guard.col < 1)
-            next_tile = '\0';
-        else
-            next_tile = map[guard.row][guard.col - 1];
-    }
-    return next_tile;
+    // The border is '\0', so this never needs to check the edges
+    return map.cells[guard.index + step_in(map, guard.dir)];
 }
 
-// For debugging: count the number of maps we've tried
-// int recursions = 0;
+// The obstructions for each thread of obstructions_that_create_loops to try
+typedef struct ObstructionJob
+{
+    Grid map;
+    int *positions_to_try;
+    Guard guard;
+} ObstructionJob;
+
+int count_loops(size_t begin, size_t end, int worker, void *ctx);
+int add_int(int a, int b) { return a + b; }
+DEF_PARALLEL_REDUCE(int)
 
 /// @brief Determine how many places we can put obstructions where a loop will be created
 /// @param map The map
-/// @param map_row_count The number of rows in the map
-/// @param positions_to_try An array of obstruction positions to try
+/// @param positions_to_try An array of obstruction positions (indices into `map`) to try
 /// @param positions_to_try_size The number of elements in `positions_to_try`
 /// @param guard The guard's original position and direction
 /// @return The number of places we can put an obstruction to create a loop
-int obstructions_that_create_loops(char **map, size_t map_row_count, Position *positions_to_try, size_t positions_to_try_size, Guard guard)
+int obstructions_that_create_loops(Grid map, int *positions_to_try, size_t positions_to_try_size, Guard guard)
 {
-    // Base case: there are no positions to try
-    if (positions_to_try_size <= 0)
-        return 0;
-
-    // Copy the map so we can check this one without causing issues for future iterations
-    // Get the size of each row (+1 for the null terminator)
-    size_t map_row_size = strlen(map[0]) + 1;
-    char **map_copy = malloc(sizeof(char *) * map_row_count);
-    for (size_t i = 0; i < map_row_count; i++)
+    // Each position is independent, so split them between threads
+    ObstructionJob job = {map, positions_to_try, guard};
+    return parallel_reduce_int(0UL, positions_to_try_size, 64UL, 0, count_loops, add_int, &job);
+}
+
+/// @brief Count the positions in [begin, end) that create a loop, on a copy of the map owned by `worker`
+/// @param begin The first index into positions_to_try
+/// @param end One past the last index
+/// @param worker The thread running this
+/// @param ctx The ObstructionJob
+/// @return The number of positions that create a loop
+int count_loops(size_t begin, size_t end, int worker, void *ctx)
+{
+    ObstructionJob *job = ctx;
+    // Each thread reuses one copy of the map instead of allocating one for every position
+    Grid map_copy = job->map;
+    map_copy.cells = worker_scratch(worker, job->map.size);
+
+    int loops = 0;
+    for (size_t i = begin; i < end; i++)
     {
-        map_copy[i] = malloc(sizeof(char) * map_row_size);
-        strncpy(map_copy[i], map[i], map_row_size);
+        memcpy(map_copy.cells, job->map.cells, job->map.size);
+        map_copy.cells[job->positions_to_try[i]] = '#';
+        loops += contains_loop(map_copy, job->guard);
     }
-
-    map_copy[positions_to_try[0].row][positions_to_try[0].col] = '#';
-
-    // Check for a loop
-    int first_position_creates_loop = contains_loop(map_copy, map_row_count, guard);
-
-    // For debug, print loops
-    // if (first_position_creates_loop)
-    // {
-    //     for (size_t i = 0; i < map_row_count; i++)
-    //     {
-    //         char *map_row = map_copy[i];
-    //         while (*map_row)
-    //         {
-    //             char ch = *map_row;
-    //             if (!(ch & 0xf0))
-    //             {
-    //                 // Check if (up or down) and (left or right)
-    //                 if ((ch & 0b0101) && (ch & 0b1010))
-    //                     *map_row = '+';
-    //                 else if (ch & 0b0101)
-    //                     // Up or down
-    //                     *map_row = '|';
-    //                 else
-    //                     // Left or right
-    //                     *map_row = '-';
-    //             }
-    //             map_row++;
-    //         }
-    //     }
-    //     printf("Map %d:\n", recursions);
-    //     print_map(map_copy, map_row_count);
-    //     printf("\n");
-    // }
-    // recursions++;
-
-    // Free the map copy
-    // I could definitely re-copy and reuse this, but I don't want to yet
-    for (size_t i = 0; i < map_row_count; i++)
-        free(map_copy[i]);
-    free(map_copy);
-    // Recursion: Try the next positions
-    return first_position_creates_loop + obstructions_that_create_loops(map, map_row_count, positions_to_try + 1, positions_to_try_size - 1, guard);
+    return loops;
 }
 
 /// @brief Check if the given map contains a guard loop
 /// @param map The map
-/// @param map_row_count The number of rows in the map
 /// @param guard The position and direction of the guard
 /// @return 0 if the guard will exit the map, 1 if the guard will get stuck in a loop
-int contains_loop(char **map, size_t map_row_count, Guard guard)
+static inline int contains_loop(Grid map, Guard guard)
 {
     // Mark the starting point as visited to prevent it from being added to the vector
-    map[guard.row][guard.col] = 1 << guard.dir;
+    map.cells[guard.index] = 1 << guard.dir;
     // Get the maximum number of tiles as a safeguard in case we get stuck
-    int max_tiles = map_row_count * strlen(map[0]);
+    int max_tiles = map.rows * map.cols;
     for (int i = 0; i < max_tiles; i++)
     {
-        int move = move_guard_with_direction(&guard, map, map_row_count);
+        int move = move_guard_with_direction(&guard, map);
         if (move == -1)
             return 0;
         // Check if a loop was detected
@@ -374,53 +312,40 @@ int contains_loop(char **map, size_t map_row_count, Guard guard)
 
 /// @brief Move a guard one step, but leave a bitmask of directions instead of 'X'
 /// @param guard The guard's location and direction
-/// @param map The map as a 2D character array
-/// @param row_count The number of rows in map (columns is irrelevant because each row is a null-terminated string)
+/// @param map The map
 /// @return 0 if a loop was not found, 1 if a loop has been found, -1 if the new square is off the map or the guard is stuck
-int move_guard_with_direction(Guard *guard, char **map, size_t row_count)
+static inline int move_guard_with_direction(Guard *guard, Grid map)
 {
-    // Check for obstacle or end
-    switch (peek_guard(*guard, map, row_count))
+    // Rotate away from obstacles. This is a loop rather than recursion so it can be inlined
+    char next = peek_guard(*guard, map);
+    for (int turns = 0; next == '#'; turns++)
     {
-    case '\0':
-        // Off the map
-        return -1;
-    case '#':
-        // Obstacle rotate and try again
+        // Obstacles on every side
+        if (turns == GRID_DIRECTIONS)
+            return -1;
         guard->dir = rotate_right(guard->dir);
-        // Return instead of moving again
-        return move_guard_with_direction(guard, map, row_count);
+        next = peek_guard(*guard, map);
     }
+    // Off the map
+    if (next == '\0')
+        return -1;
 
     // Move the guard
-    switch (guard->dir)
-    {
-    case UP:
-        guard->row--;
-        break;
-    case RIGHT:
-        guard->col++;
-        break;
-    case DOWN:
-        guard->row++;
-        break;
-    default: // LEFT
-        guard->col--;
-    }
+    guard->index += step_in(map, guard->dir);
 
     // Use the appropriate direction for the tile
-    char old_tile = map[guard->row][guard->col];
+    char old_tile = map.cells[guard->index];
     // All printable characters will have some bits in the first nibble
     // If this is a printable character that isn't an obstacle, we should just leave the direction here
     if (old_tile & 0xf0)
-        map[guard->row][guard->col] = 1 << guard->dir;
+        map.cells[guard->index] = 1 << guard->dir;
     else if (old_tile & (1 << guard->dir))
         // Otherwise, there is already some direction here,
         // so we should determine if the guard has been here before in this direction
         return 1;
     else
         // If it's already a direction, but not this direction, add this direction
-        map[guard->row][guard->col] = old_tile | (1 << guard->dir);
+        map.cells[guard->index] = old_tile | (1 << guard->dir);
 
     return 0;
 }
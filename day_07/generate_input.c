@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+#define MIN_OPERANDS 3
+#define MAX_OPERANDS 12
+#define MAX_OPERAND 999
+// Keep targets well inside a long long
+#define MAX_TARGET 1000000000000000LL
+
+int main(int argc, char *argv[])
+{
+    long long equations = parse_generator_args(argc, argv, 850, 1, 100000000, "The number of equations");
+    if (equations == -1)
+        return 1;
+
+    long long operands[MAX_OPERANDS];
+    for (long long i = 0; i < equations; i++)
+    {
+        int operands_size = random_range(MIN_OPERANDS, MAX_OPERANDS);
+        for (int j = 0; j < operands_size; j++)
+            operands[j] = random_range(1, MAX_OPERAND);
+
+        // Build the target from random +, *, and || so about half of the equations are possible
+        long long target = operands[0];
+        for (int j = 1; j < operands_size; j++)
+        {
+            long long shift = 10;
+            while (shift <= operands[j])
+                shift *= 10;
+
+            long long op = random_range(0, 2);
+            if (op == 1 && target <= MAX_TARGET / operands[j])
+                target *= operands[j];
+            else if (op == 2 && target <= MAX_TARGET / shift)
+                target = target * shift + operands[j];
+            else
+                target += operands[j];
+        }
+        if (next_random() & 1)
+            target += random_range(1, 100);
+
+        printf("%lld:", target);
+        for (int j = 0; j < operands_size; j++)
+            printf(" %lld", operands[j]);
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -2,81 +2,225 @@
 #include <stdlib.h>
 #include <string.h>
 
-// Long long vector
-// Manually defined instead of using the template because `long long` has a space
-typedef struct LL_Vec
+#include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/thread_pool.h"
+#include "../runner/stream.h"
+
+// Long long vector. The template needs a type name without a space
+typedef long long LL;
+DEF_VEC(LL)
+DEF_VEC_CAPACITY(LL)
+
+// One line of the input. The operands of every equation are stored together in one LL_Vec
+typedef struct Equation
 {
-    long long *arr;
-    size_t len;
-    size_t cap;
-} LL_Vec;
-void appendLL_Vec(LL_Vec *vec, long long val)
+    long long target;
+    // The index of the first operand
+    size_t operands_start;
+    // The number of operands
+    size_t operands_size;
+} Equation;
+
+DEF_VEC(Equation)
+DEF_VEC_CAPACITY(Equation)
+
+// The parsed input for the runner
+typedef struct Puzzle
 {
-    if (vec->len + 1 > vec->cap)
-    {
-        // Double if there is any capacity, otherwise make it one
-        vec->cap = vec->cap ? vec->cap * 2 : 1;
-        vec->arr = realloc(vec->arr, sizeof(long long) * vec->cap);
-    }
-    vec->arr[vec->len++] = val;
-}
-LL_Vec new_LL_Vec() { return (LL_Vec){NULL, 0UL, 0UL}; }
+    Equation_Vec equations;
+    LL_Vec operands;
+} Puzzle;
+
+// The equations for each thread of total_calibration_result to check
+typedef struct CalibrationJob
+{
+    Equation *equations;
+    long long *operands;
+} CalibrationJob;
 
-long long parse_input_line(FILE *f, LL_Vec *operands);
+// A sum of targets. A single identifier so it can be reduced in parallel
+typedef long long Calibration;
+
+int parse_input(char *input_file, Equation_Vec *equations, LL_Vec *operands);
+long long parse_input_line(Span line, LL_Vec *operands);
+long long total_calibration_result(Equation *equations, size_t equations_size, long long *operands);
 int valid_values(long long target, long long *operands, size_t operands_size);
+Calibration sum_valid_targets(size_t begin, size_t end, int worker, void *ctx);
+int sum_valid_lines(Span lines, int worker, void *ctx, long long *total);
+Calibration add_calibration(Calibration a, Calibration b) { return a + b; }
+DEF_PARALLEL_REDUCE(Calibration)
 void print_arr(long long *arr, size_t arr_size);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+int stream_puzzle(char *input_file, char *answer);
 
-int main(int argc, char const *argv[])
+int main(int argc, char *argv[])
 {
-    long long total = 0LL;
-    LL_Vec operands = new_LL_Vec();
-    FILE *f = fopen("input.txt", "r");
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
+    Equation_Vec equations;
+    LL_Vec operands;
+    if (parse_input(input_file, &equations, &operands))
+        return 1;
 
-    long long target = parse_input_line(f, &operands);
-    while (target)
+    for (size_t i = 0; i < equations.len; i++)
     {
-        printf("%lld:", target);
-        print_arr(operands.arr, operands.len);
+        Equation equation = equations.arr[i];
+        printf("%lld:", equation.target);
+        print_arr(operands.arr + equation.operands_start, equation.operands_size);
         printf("\n");
         // Check if the values make a possible calculation
-        if (valid_values(target, operands.arr, operands.len))
-        {
+        if (valid_values(equation.target, operands.arr + equation.operands_start, equation.operands_size))
             printf("\tPOSSIBLE\n");
-            total += target;
-        }
         else
             printf("\tIMPOSSIBLE\n");
+    }
+
+    printf("Total calibration result: %lld\n", total_calibration_result(equations.arr, equations.len, operands.arr));
+
+    free(equations.arr);
+    free(operands.arr);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->equations, &puzzle->operands))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", total_calibration_result(p->equations.arr, p->equations.len, p->operands.arr));
+    return 0;
+}
 
-        // Reset operands array
-        // Don't worry about shrinking it because we are about to just put more elements into it.
-        operands.len = 0UL;
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    free(p->equations.arr);
+    free(p->operands.arr);
+    free(p);
+}
 
-        // Get the next line
-        target = parse_input_line(f, &operands);
+int stream_puzzle(char *input_file, char *answer)
+{
+    long long total;
+    if (stream_sum(input_file, "\n", sum_valid_lines, NULL, &total))
+        return 1;
+    snprintf(answer, ANSWER_SIZE, "%lld", total);
+    return 0;
+}
+
+DEF_STREAM_SOLVER(7, 1, parse_puzzle, solve_puzzle, delete_puzzle, stream_puzzle)
+
+/// @brief Parse every line of the input file
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param equations Out: The equations
+/// @param operands Out: The operands of every equation, indexed by `Equation.operands_start`
+/// @return 0 if success, non-zero if failure
+int parse_input(char *input_file, Equation_Vec *equations, LL_Vec *operands)
+{
+    Input input;
+    if (open_input(input_file, &input))
+        return 1;
+
+    // One equation per line, so they are allocated once at their full size
+    Span span = input_span(&input);
+    size_t lines = count_lines(span);
+    *equations = with_capacity_Equation_Vec(lines);
+    *operands = new_LL_Vec();
+
+    Span line;
+    while (next_line(&span, &line))
+    {
+        size_t operands_start = operands->len;
+        long long target = parse_input_line(line, operands);
+        if (!target)
+            break;
+        append_Equation_Vec(equations, (Equation){target, operands_start, operands->len - operands_start});
     }
 
-    printf("Total calibration result: %lld\n", total);
+    close_input(&input);
+    return 0;
+}
+
+/// @brief Sum the targets of every equation that can be made true
+/// @param equations The equations
+/// @param equations_size The number of elements in `equations`
+/// @param operands The operands of every equation, indexed by `Equation.operands_start`
+/// @return The total calibration result
+long long total_calibration_result(Equation *equations, size_t equations_size, long long *operands)
+{
+    // Each equation is independent, so split them between threads
+    CalibrationJob job = {equations, operands};
+    return parallel_reduce_Calibration(0UL, equations_size, 16UL, 0LL, sum_valid_targets, add_calibration, &job);
+}
+
+/// @brief Sum the targets of the equations in [begin, end) that can be made true
+/// @param begin The first equation
+/// @param end One past the last equation
+/// @param worker The thread running this
+/// @param ctx The CalibrationJob
+/// @return The sum of their targets
+Calibration sum_valid_targets(size_t begin, size_t end, int worker, void *ctx)
+{
+    CalibrationJob *job = ctx;
+    Calibration total = 0LL;
+    for (size_t i = begin; i < end; i++)
+        if (valid_values(job->equations[i].target, job->operands + job->equations[i].operands_start, job->equations[i].operands_size))
+            total += job->equations[i].target;
+    return total;
+}
 
+/// @brief Sum the targets of the equations in some lines of the input that can be made true, without keeping them.
+/// Used by stream_sum
+/// @param lines Whole lines of the input
+/// @param worker The thread running this
+/// @param ctx Unused
+/// @param total In/out: The total calibration result, which their targets are added to
+/// @return 0
+int sum_valid_lines(Span lines, int worker, void *ctx, long long *total)
+{
+    // One equation at a time, reusing the same memory
+    LL_Vec operands = new_LL_Vec();
+    Span line;
+    while (next_line(&lines, &line))
+    {
+        clear_LL_Vec(&operands);
+        long long target = parse_input_line(line, &operands);
+        if (target && valid_values(target, operands.arr, operands.len))
+            *total += target;
+    }
     free(operands.arr);
-    fclose(f);
     return 0;
 }
 
 /// @brief Parse a line of the input file to get the target value and the operands
-/// @param f The input file
+/// @param line The line, without the newline
 /// @param operands An initialized vector of `long long` where the operands will be placed
-/// @return The target value, or 0 if the end of the file has been reached
-long long parse_input_line(FILE *f, LL_Vec *operands)
+/// @return The target value, or 0 if the line is empty
+long long parse_input_line(Span line, LL_Vec *operands)
 {
     // Return early if we can't find the target
     long long target;
-    if (fscanf(f, "%lld:", &target) == EOF)
+    if (!next_number(&line, &target))
         return 0LL;
 
-    // Loop until a newline is found
+    // The rest of the line is operands, which are at least 2 bytes each with the space before them
+    reserve_LL_Vec(operands, span_size(line) / 2);
     long long operand;
-    while (getc(f) != '\n' && !feof(f) && fscanf(f, "%lld", &operand))
-        appendLL_Vec(operands, operand);
+    while (next_number(&line, &operand))
+        append_LL_Vec(operands, operand);
 
     return target;
 }
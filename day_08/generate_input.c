@@ -0,0 +1,25 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// The characters that can be antenna frequencies
+const char FREQUENCIES[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+// Roughly 1 in ANTENNA_RARITY tiles is an antenna, like the real input
+#define ANTENNA_RARITY 12
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 50, 1, 65536, "The number of rows and columns");
+    if (size == -1)
+        return 1;
+
+    for (long long row = 0; row < size; row++)
+    {
+        for (long long col = 0; col < size; col++)
+            putchar(random_range(1, ANTENNA_RARITY) == 1 ? FREQUENCIES[random_range(0, sizeof(FREQUENCIES) - 2)] : '.');
+        putchar('\n');
+    }
+
+    return 0;
+}
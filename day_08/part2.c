@@ -3,6 +3,8 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
 
 // Define point using shorts instead of int or size_t because the real input is only 50x50
 // This allows us to make other structures that are smaller than 64-bit for efficiency
@@ -24,17 +26,25 @@ typedef struct FrequencyMap
 typedef char *string;
 DEF_VEC(char)
 DEF_VEC(string)
+// The rows point into the input, so only the array of rows is freed
 void delete_string_vec(string_Vec *vec)
 {
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
     free(vec->arr);
     vec->arr = NULL;
     vec->len = 0UL;
     vec->cap = 0UL;
 }
 
-int parse_input(string_Vec *map, FrequencyMap *antenna_map);
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    // The rows of the map point into the input
+    Input input;
+    string_Vec map;
+    FrequencyMap antenna_map;
+} Puzzle;
+
+int parse_input(char *input_file, Input *input, string_Vec *map, FrequencyMap *antenna_map);
 void print_map(char **map, size_t row_count);
 FrequencyMap newFrequencyMap();
 void deleteFrequencyMap(FrequencyMap *map);
@@ -45,14 +55,20 @@ int count_antinodes(char **map, size_t map_size, FrequencyMap antenna_map);
 Point *find_possible_antinodes(Point *antennas, size_t antennas_size, char **map, size_t map_size, size_t *possible_antinodes_size);
 short gcd(short x, short y);
 
-int main(int argc, char const *argv[])
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
+int main(int argc, char *argv[])
 {
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
     // The map of spaces (as '.'), antennas (as alphanumeric), and antinodes (as '#')
+    Input input;
     string_Vec map;
     // The map from frequency to antenna locations
     FrequencyMap antenna_map;
 
-    if (parse_input(&map, &antenna_map))
+    if (parse_input(input_file, &input, &map, &antenna_map))
         return 1;
 
     int antinode_count = count_antinodes(map.arr, map.len, antenna_map);
@@ -62,77 +78,82 @@ int main(int argc, char const *argv[])
     print_map(map.arr, map.len);
 
     delete_string_vec(&map);
+    close_input(&input);
     deleteFrequencyMap(&antenna_map);
 
     printf("\nNumber of distinct antinodes: %d\n", antinode_count);
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->input, &puzzle->map, &puzzle->antenna_map))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%d", count_antinodes(p->map.arr, p->map.len, p->antenna_map));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    delete_string_vec(&p->map);
+    close_input(&p->input);
+    deleteFrequencyMap(&p->antenna_map);
+    free(p);
+}
+
+DEF_SOLVER(8, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse input into `map`, noting the locations of all antennas in antenna_map
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param input Out parameter: The input, which must be closed after the map is deleted
 /// @param map Out parameter: The map for the puzzle
 /// @param antenna_map Out parameter: map of frequencies to antenna locations
 /// @return 0 if successful. Some nonzero number if unsuccessful (i.e. IO error)
-int parse_input(string_Vec *map, FrequencyMap *antenna_map)
+int parse_input(char *input_file, Input *input, string_Vec *map, FrequencyMap *antenna_map)
 {
-    // Open input.txt or panic
-    FILE *f = fopen("input.txt", "r");
-    if (f == NULL)
+    if (open_input(input_file, input))
+        return 1;
+
+    Span span = input_span(input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        perror("Error opening input file");
+        fprintf(stderr, "Expected a rectangular map\n");
+        close_input(input);
         return 1;
     }
 
-    *map = new_string_Vec();
+    // Note every antenna, and check that everything else is empty
     *antenna_map = newFrequencyMap();
-
-    // Loop over characters in the file
-    int ch;
-    char_Vec row = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
-    {
-        if (ch == '.')
-        {
-            append_char_Vec(&row, (char)ch);
-        }
-        else if (
-            ('0' <= ch && ch <= '9') ||
-            ('A' <= ch && ch <= 'Z') ||
-            ('a' <= ch && ch <= 'z'))
+    for (size_t row = 0; row < grid.rows; row++)
+        for (size_t col = 0; col < grid.cols; col++)
         {
+            char ch = GRID_AT(grid, row, col);
+            if (ch == '.')
+                continue;
+
             // Alphanumeric: antenna
-            if (add_antenna(antenna_map, (char)ch, (Point){map->len, row.len}))
+            if (add_antenna(antenna_map, ch, (Point){row, col}))
             {
-                // Should be unreachable because we already checked if ch is alphanumeric
-                fprintf(stderr, "Unexpected invalid antenna '%c'\n", (char)ch);
-                exit(1);
+                fprintf(stderr, "Unexpected character: '%c'\n", ch);
+                deleteFrequencyMap(antenna_map);
+                close_input(input);
+                return 1;
             }
-            append_char_Vec(&row, (char)ch);
         }
-        else if (ch == '\n')
-        {
-            // Add terminator for the string and put it on the string vector
-            append_char_Vec(&row, '\0');
-            append_string_Vec(map, row.arr);
-            // Generate a new char vector for the next iteration
-            row = new_char_Vec();
-        }
-        else
-        {
-            free(row.arr);
-            delete_string_vec(map);
-            fprintf(stderr, "Unexpected character: '%c'\n", (char)ch);
-            return 1;
-        }
-    }
-    // If relevant, append__Vec the last row. Otherwise, just free the row
-    if (row.len > 0)
-    {
-        append_char_Vec(&row, '\0');
-        append_string_Vec(map, row.arr);
-    }
-    else
-        free(row.arr);
 
+    *map = (string_Vec){grid_rows(grid), grid.rows, grid.rows};
     return 0;
 }
 
@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+int main(int argc, char *argv[])
+{
+    long long length = parse_generator_args(argc, argv, 19999, 1, 10000000000LL, "The number of digits in the disk map");
+    if (length == -1)
+        return 1;
+
+    // Alternate file sizes (never 0) and free space sizes, ending with a file
+    if (!(length & 1))
+        length--;
+    for (long long i = 0; i < length; i++)
+        putchar((i & 1) ? '0' + random_range(0, 9) : '0' + random_range(1, 9));
+    putchar('\n');
+
+    return 0;
+}
@@ -1,8 +1,18 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/stat.h>
 
-#define IN_FILE "input.txt"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/arena.h"
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    char *files;
+    size_t files_size;
+    char *free_space;
+    size_t free_space_size;
+} Puzzle;
 
 // Doubly linked list node
 typedef struct ListNode
@@ -19,6 +29,8 @@ typedef struct LinkedList
 {
     ListNode *head;
     ListNode *tail;
+    // Every node is allocated from here. Deleted nodes are not reused, but are freed with the list
+    Arena arena;
 } LinkedList;
 
 void append_list(LinkedList *list, int id, short size);
@@ -27,16 +39,20 @@ void delete_node(LinkedList *list, ListNode *node);
 void delete_list(LinkedList *list);
 ListNode *find_first_free_space(LinkedList *list, ListNode *file_node);
 
-int parse_input(char **files, size_t *files_size, char **free_space, size_t *free_space_size);
+int parse_input(char *input_file, char **files, size_t *files_size, char **free_space, size_t *free_space_size);
 unsigned long long compressed_checksum(char *files, size_t files_size, char *free_space, size_t free_space_size);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
-int main(int argc, char const *argv[])
+int main(int argc, char *argv[])
 {
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
     char *files;
     size_t files_size;
     char *free_space;
     size_t free_space_size;
-    if (parse_input(&files, &files_size, &free_space, &free_space_size))
+    if (parse_input(input_file, &files, &files_size, &free_space, &free_space_size))
         return 1;
     printf("Files:      ");
     for (size_t i = 0; i < files_size; i++)
@@ -53,42 +69,61 @@ int main(int argc, char const *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->files, &puzzle->files_size, &puzzle->free_space, &puzzle->free_space_size))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%llu", compressed_checksum(p->files, p->files_size, p->free_space, p->free_space_size));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    free(p->files);
+    free(p->free_space);
+    free(p);
+}
+
+DEF_SOLVER(9, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse input into arrays `files` and `free_space`
+/// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param files Out: The array of file sizes as bytes representing the numbers 0-9
 /// @param files_size Out: The number of elements in `files`
 /// @param free_space Out: The array of free space sizes as bytes representing the numbers 0-9
 /// @param free_space_size Out: The number of elements in `free_space`
 /// @return 0 if successful. Some nonzero number if unsuccessful (i.e. IO error)
-int parse_input(char **files, size_t *files_size, char **free_space, size_t *free_space_size)
+int parse_input(char *input_file, char **files, size_t *files_size, char **free_space, size_t *free_space_size)
 {
-    // Use the POSIX stat to get the size of the input file
-    struct stat statbuf;
-    if (stat(IN_FILE, &statbuf))
-    {
-        perror("Error opening input file stats");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
+
     // Because the files and free spaces are alternating characters,
     // allocate an array for files and free_space equal to half the file size, rounded up
-    size_t half_file_size = ((size_t)statbuf.st_size / 2) + (statbuf.st_size % 2);
+    size_t half_file_size = (input.size / 2) + (input.size % 2);
 
     *files = malloc(sizeof(*files[0]) * half_file_size);
     *free_space = malloc(sizeof(*free_space[0]) * half_file_size);
     *files_size = 0UL;
     *free_space_size = 0UL;
 
-    // Open input.txt or panic
-    FILE *f = fopen(IN_FILE, "r");
-    if (f == NULL)
-    {
-        perror("Error opening input file");
-        return 1;
-    }
-
     // Loop over the input, alternating between adding a file and adding a free space
-    int ch = getc(f);
+    // The input is null-terminated, so this stops at the end even without a newline
+    char *ch = input.data;
     int is_file = 1;
-    while ('0' <= ch && ch <= '9')
+    while ('0' <= *ch && *ch <= '9')
     {
         if (is_file)
         {
@@ -97,7 +132,7 @@ int parse_input(char **files, size_t *files_size, char **free_space, size_t *fre
                 printf("Unexpected file %lu. Maximum file count %lu.\n", *files_size, half_file_size);
                 exit(1);
             }
-            (*files)[(*files_size)++] = (char)ch - '0';
+            (*files)[(*files_size)++] = *ch - '0';
         }
         else
         {
@@ -106,13 +141,14 @@ int parse_input(char **files, size_t *files_size, char **free_space, size_t *fre
                 printf("Unexpected free space %lu. Maximum free space count %lu.\n", *files_size, half_file_size);
                 exit(1);
             }
-            (*free_space)[(*free_space_size)++] = (char)ch - '0';
+            (*free_space)[(*free_space_size)++] = *ch - '0';
         }
 
         is_file = !is_file;
-        ch = getc(f);
+        ch++;
     }
 
+    close_input(&input);
     return 0;
 }
 
@@ -128,7 +164,7 @@ unsigned long long compressed_checksum(char *files, size_t files_size, char *fre
     // The position in the compressed filesystem
     unsigned long long compressed_pos = 0ULL;
 
-    LinkedList linked_list = {NULL, NULL};
+    LinkedList linked_list = {NULL, NULL, new_arena(0UL)};
 
     // Put the files and free spaces into the list
     for (int i = 0; i < files_size; i++)
@@ -204,7 +240,7 @@ unsigned long long compressed_checksum(char *files, size_t files_size, char *fre
 /// @param size The size of the file/free space
 void append_list(LinkedList *list, int id, short size)
 {
-    ListNode *new_node = malloc(sizeof(ListNode));
+    ListNode *new_node = ARENA_NEW(&list->arena, ListNode);
     new_node->id = id;
     new_node->size = size;
     new_node->next = NULL;
@@ -229,22 +265,14 @@ void append_list(LinkedList *list, int id, short size)
 // Free all elements in a list
 void delete_list(LinkedList *list)
 {
-    // Loop over all nodes, starting at the head
-    ListNode *node = list->head;
-    ListNode *temp;
-    while (node)
-    {
-        temp = node->next;
-        free(node);
-        node = temp;
-    }
+    delete_arena(&list->arena);
 
     // Clear head and tail
     list->head = NULL;
     list->tail = NULL;
 }
 
-/// @brief Delete node from list
+/// @brief Delete node from list. Its memory is not freed until the whole list is deleted
 /// @param list The linked list
 /// @param node The node to delete
 void delete_node(LinkedList *list, ListNode *node)
@@ -272,8 +300,6 @@ void delete_node(LinkedList *list, ListNode *node)
         fprintf(stderr, "Illegal state: node has no next, but is not tail\n");
         exit(1);
     }
-
-    free(node);
 }
 
 /// @brief Move a node from `source` to directly after `new_parent`
@@ -291,7 +317,7 @@ void move_node(LinkedList *list, ListNode *source, ListNode *new_parent)
 
     // Create a new node for source
     // We can't actually move because we need to leave free space
-    ListNode *node = malloc(sizeof(ListNode));
+    ListNode *node = ARENA_NEW(&list->arena, ListNode);
     node->id = source->id;
     node->size = source->size;
 
@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// Roughly 1 in TRAIL_RARITY tiles starts a planted trail
+#define TRAIL_RARITY 30
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 50, 1, 65536, "The number of rows and columns");
+    if (size == -1)
+        return 1;
+
+    const int ROW_STEP[] = {-1, 0, 1, 0};
+    const int COL_STEP[] = {0, 1, 0, -1};
+
+    // Random heights have almost no trails, so plant some by walking uphill from a random trailhead
+    char *map = malloc(size * size);
+    for (long long i = 0; i < size * size; i++)
+        map[i] = '0' + random_range(0, 9);
+    for (long long i = 0; i < size * size / TRAIL_RARITY; i++)
+    {
+        long long row = random_range(0, size - 1);
+        long long col = random_range(0, size - 1);
+        int dir = random_range(0, 3);
+        for (int height = 0; height <= 9; height++)
+        {
+            map[row * size + col] = '0' + height;
+            // Never turn around, which would overwrite the last step
+            dir = (dir + random_range(-1, 1)) & 3;
+            long long next_row = row + ROW_STEP[dir];
+            long long next_col = col + COL_STEP[dir];
+            if (next_row < 0 || next_row >= size || next_col < 0 || next_col >= size)
+                break;
+            row = next_row;
+            col = next_col;
+        }
+    }
+
+    for (long long row = 0; row < size; row++)
+    {
+        fwrite(map + row * size, 1, size, stdout);
+        putchar('\n');
+    }
+
+    free(map);
+    return 0;
+}
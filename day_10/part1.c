@@ -2,24 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "../c-data-structures/vector/vector_template.h"
-
-#define IN_FILE "input.txt"
-
-// Helper to index a 1D array as 2D
-#define IDX_2D(arr, row, col) arr[((row) * map_row_size) + (col)]
-
-DEF_VEC(int)
-DEF_VEC(int_Vec)
-void deleteint_Vec_Vec(int_Vec_Vec *vec)
-{
-    for (size_t i = 0; i < vec->len; i++)
-        free(vec->arr[i].arr);
-    free(vec->arr);
-    vec->arr = NULL;
-    vec->len = 0;
-    vec->cap = 0;
-}
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/grid.h"
 
 // A coordinate on the map
 typedef struct Point
@@ -34,20 +19,22 @@ typedef struct MapSquare
     Point *reachable_peaks;
     // The length of reachable_peaks
     int reachable_peaks_size;
-    // The height of this square
-    int height;
 } MapSquare;
 
-int parse_input(int_Vec_Vec *map);
-long long get_total_trailhead_score(int_Vec_Vec map);
-Point *get_reachable_peaks(MapSquare *map, size_t map_size, size_t map_row_size, size_t row, size_t col, int *return_size);
+int parse_input(char *input_file, Grid *map);
+long long get_total_trailhead_score(Grid map);
+Point *get_reachable_peaks(Grid map, MapSquare *squares, int index, int *return_size);
 Point *union_point_arrays(Point *arr1, int arr1_size, Point *arr2, int arr2_size, int *return_size);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
-int main(int argc, char const *argv[])
+int main(int argc, char *argv[])
 {
+    char *input_file = (argc >= 2) ? argv[1] : NULL;
     int is_error;
-    int_Vec_Vec map;
-    if (parse_input(&map))
+    Grid map;
+    if (parse_input(input_file, &map))
     {
         is_error = 1;
         goto END;
@@ -57,108 +44,104 @@ int main(int argc, char const *argv[])
 
     // Cleanup
     is_error = 0;
-    deleteint_Vec_Vec(&map);
+    delete_grid(&map);
 END:
     return is_error;
 }
 
-/// @brief Parse input into a 2D vector of MapSquare
-/// @param map Out: The vector of MapSquare
+void *parse_puzzle(char *input_file)
+{
+    Grid *map = malloc(sizeof(Grid));
+    if (parse_input(input_file, map))
+    {
+        free(map);
+        return NULL;
+    }
+    return map;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    snprintf(answer, ANSWER_SIZE, "%lld", get_total_trailhead_score(*(Grid *)puzzle));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    delete_grid(puzzle);
+    free(puzzle);
+}
+
+DEF_SOLVER(10, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
+/// @brief Parse input into a map of heights
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param map Out: The map of heights, as digits
 /// @return 0 if success, non-zero if failure
-int parse_input(int_Vec_Vec *map)
+int parse_input(char *input_file, Grid *map)
 {
-    // Open input.txt or panic
-    FILE *f = fopen(IN_FILE, "r");
-    if (f == NULL)
+    Input input;
+    if (open_input(input_file, &input))
+        return 1;
+
+    Span span = input_span(&input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        perror("Error opening input file");
+        fprintf(stderr, "Expected a rectangular map\n");
+        close_input(&input);
         return 1;
     }
 
-    // Parse file
-    *map = new_int_Vec_Vec();
-    int ch;
-    int_Vec row = new_int_Vec();
-    while ((ch = getc(f)) != EOF)
-    {
-        if ('0' <= ch && ch <= '9')
+    // Check that every height is a digit
+    for (size_t row = 0; row < grid.rows; row++)
+        for (size_t col = 0; col < grid.cols; col++)
         {
-            append_int_Vec(&row, (int)(ch - '0'));
-        }
-        else if (ch == '\n')
-        {
-            append_int_Vec_Vec(map, row);
-            row = new_int_Vec();
-        }
-        else
-        {
-            // Error: cleanup and return
-            deleteint_Vec_Vec(map);
-            return 1;
+            char ch = GRID_AT(grid, row, col);
+            if (ch < '0' || ch > '9')
+            {
+                fprintf(stderr, "Unexpected character: '%c'\n", ch);
+                close_input(&input);
+                return 1;
+            }
         }
-    }
-    // If relevant, append__Vec the last row. Otherwise, just free the row
-    if (row.len > 0)
-        append_int_Vec_Vec(map, row);
-    else
-        free(row.arr);
 
+    // The heights are kept as digits. Past the edge of the map is '\0', which is never the next height up
+    *map = grid_from_view(grid, 1, '\0');
+    close_input(&input);
     return 0;
 }
 
 /// @brief The the total score of all trailheads, according to day 10 part 1
-/// @param map A 2d vector of map heights
+/// @param map The map of heights
 /// @return The total score of all trailheads in `map`
-long long get_total_trailhead_score(int_Vec_Vec map)
+long long get_total_trailhead_score(Grid map)
 {
     long long total_score = 0LL;
-    // The number of rows if map
-    size_t map_size = map.len;
-    // The number of columns in map
-    size_t map_row_size = map_size ? map.arr[0].len : 0;
 
-    // Allocate a 1D array because we can to division and modulo to index it as 2D, similar to how static 2D arrays work
-    size_t flattened_size = map_size * map_row_size;
-    MapSquare *map_squares = malloc(flattened_size * sizeof(map_squares[0]));
-    for (size_t row = 0; row < map_size; row++)
-    {
-        // Stop if the map is not rectangular
-        if (map.arr[row].len != map_row_size)
-        {
-            // Make the cleanup only clean up rows that actually have been written or the cleanup may cause nonexistant memory to be freed.
-            flattened_size = row * map_row_size;
-            fprintf(stderr, "Unexpected length for row %lu. Expected: %lu. Actual: %lu", row, map_row_size, map.arr[row].len);
-            total_score = -1;
-            goto CLEANUP;
-        }
-        for (size_t col = 0; col < map_row_size; col++)
-        {
-            IDX_2D(map_squares, row, col).reachable_peaks = NULL;
-            // -1 indicates this hasn't been calculated yet, while 0 would indicate no reachable peaks
-            IDX_2D(map_squares, row, col).reachable_peaks_size = -1;
-            IDX_2D(map_squares, row, col).height = map.arr[row].arr[col];
-        }
-    }
+    // One MapSquare for every cell of the map, indexed the same way
+    MapSquare *map_squares = NEW_GRID_LAYER(map, MapSquare);
+    for (size_t i = 0; i < map.size; i++)
+        // -1 indicates this hasn't been calculated yet, while 0 would indicate no reachable peaks
+        map_squares[i].reachable_peaks_size = -1;
 
     // Loop over all map squares and check score if the square is a trailhead
-    for (size_t row = 0; row < map_size; row++)
+    for (int row = 0; row < map.rows; row++)
     {
-        for (size_t col = 0; col < map_row_size; col++)
+        for (int col = 0; col < map.cols; col++)
         {
             // If trailhead, then count the reachable peaks
-            if (IDX_2D(map_squares, row, col).height == 0)
+            if (GRID_CELL(map, row, col) == '0')
             {
                 int score;
-                get_reachable_peaks(map_squares, map_size, map_row_size, row, col, &score);
+                get_reachable_peaks(map, map_squares, GRID_INDEX(map, row, col), &score);
                 total_score += score;
             }
         }
     }
 
-    // Essentially using labels as defer
-CLEANUP:
     // Free everything
-    for (size_t i = 0; i < flattened_size; i++)
+    for (size_t i = 0; i < map.size; i++)
         if (map_squares[i].reachable_peaks_size > 0)
             free(map_squares[i].reachable_peaks);
     free(map_squares);
@@ -167,31 +150,29 @@ CLEANUP:
 }
 
 /// @brief Get all peaks reachable from this square
-/// @param map The map of MapSquares
-/// @param map_size The number of rows in `map`
-/// @param map_row_size The number of columns in `map`
-/// @param row The row to find the reachable peaks for
-/// @param col The column to find the reachable peaks for
+/// @param map The map of heights
+/// @param squares The MapSquare of every cell in `map`
+/// @param index The index of the cell to find the reachable peaks for
 /// @param return_size Out: The size of the returned array
 /// @return An array of points representing all the peaks reachable from this square
-Point *get_reachable_peaks(MapSquare *map, size_t map_size, size_t map_row_size, size_t row, size_t col, int *return_size)
+Point *get_reachable_peaks(Grid map, MapSquare *squares, int index, int *return_size)
 {
     // See if this has been memoized already
-    if (IDX_2D(map, row, col).reachable_peaks_size != -1)
+    if (squares[index].reachable_peaks_size != -1)
     {
-        *return_size = IDX_2D(map, row, col).reachable_peaks_size;
+        *return_size = squares[index].reachable_peaks_size;
         // Do not memoize this because we already have
-        return IDX_2D(map, row, col).reachable_peaks;
+        return squares[index].reachable_peaks;
     }
 
     Point *reachable_peaks;
-    int height = IDX_2D(map, row, col).height;
+    char height = map.cells[index];
     // If this is a peak, return self
-    if (height == 9)
+    if (height == '9')
     {
         reachable_peaks = malloc(sizeof(reachable_peaks[0]));
-        reachable_peaks[0].x = (short)row;
-        reachable_peaks[0].y = (short)col;
+        reachable_peaks[0].x = (short)grid_row(map, index);
+        reachable_peaks[0].y = (short)grid_col(map, index);
 
         *return_size = 1;
         // Memoize and return
@@ -205,34 +186,20 @@ Point *get_reachable_peaks(MapSquare *map, size_t map_size, size_t map_row_size,
     *return_size = 0;
     Point *neighbor_peaks;
     int neighbor_peaks_size;
-    // Check right
-    if (col + 1 < map_row_size && IDX_2D(map, row, col + 1).height == height)
-    {
-        neighbor_peaks = get_reachable_peaks(map, map_size, map_row_size, row, col + 1, &neighbor_peaks_size);
-        reachable_peaks = union_point_arrays(reachable_peaks, *return_size, neighbor_peaks, neighbor_peaks_size, return_size);
-    }
-    // Check up
-    if (row > 0 && IDX_2D(map, row - 1, col).height == height)
-    {
-        neighbor_peaks = get_reachable_peaks(map, map_size, map_row_size, row - 1, col, &neighbor_peaks_size);
-        reachable_peaks = union_point_arrays(reachable_peaks, *return_size, neighbor_peaks, neighbor_peaks_size, return_size);
-    }
-    // Check left
-    if (col > 0 && IDX_2D(map, row, col - 1).height == height)
-    {
-        neighbor_peaks = get_reachable_peaks(map, map_size, map_row_size, row, col - 1, &neighbor_peaks_size);
-        reachable_peaks = union_point_arrays(reachable_peaks, *return_size, neighbor_peaks, neighbor_peaks_size, return_size);
-    }
-    // Check down
-    if (row + 1 < map_row_size && IDX_2D(map, row + 1, col).height == height)
+    // Check right, up, left, and down. The border is never a height, so there is no need to check the edges
+    for (int dir = 0; dir < GRID_DIRECTIONS; dir++)
     {
-        neighbor_peaks = get_reachable_peaks(map, map_size, map_row_size, row + 1, col, &neighbor_peaks_size);
-        reachable_peaks = union_point_arrays(reachable_peaks, *return_size, neighbor_peaks, neighbor_peaks_size, return_size);
+        int neighbor = index + map.step[dir];
+        if (map.cells[neighbor] == height)
+        {
+            neighbor_peaks = get_reachable_peaks(map, squares, neighbor, &neighbor_peaks_size);
+            reachable_peaks = union_point_arrays(reachable_peaks, *return_size, neighbor_peaks, neighbor_peaks_size, return_size);
+        }
     }
 
 MEMOIZE_RETURN:
-    IDX_2D(map, row, col).reachable_peaks = reachable_peaks;
-    IDX_2D(map, row, col).reachable_peaks_size = *return_size;
+    squares[index].reachable_peaks = reachable_peaks;
+    squares[index].reachable_peaks_size = *return_size;
     return reachable_peaks;
 }
 
@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+#define MAX_STONE 10000000
+
+int main(int argc, char *argv[])
+{
+    long long stones = parse_generator_args(argc, argv, 8, 1, 100000000, "The number of stones");
+    if (stones == -1)
+        return 1;
+
+    printf("%lld", random_range(0, MAX_STONE));
+    for (long long i = 1; i < stones; i++)
+        printf(" %lld", random_range(0, MAX_STONE));
+    printf("\n");
+
+    return 0;
+}
@@ -1,6 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/arena.h"
+
+// The number of blinks the actual puzzle asks for
+#define PUZZLE_BLINKS 25
+
 // Singly linked list
 typedef struct ListNode
 {
@@ -8,18 +15,32 @@ typedef struct ListNode
     long long val;
 } ListNode;
 
-int parse_input(char *input_file, ListNode **head);
-ListNode *append__Vec(ListNode *tail, long long val);
-void insert_after(ListNode *parent, long long val);
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    // Holds the stones from the input, followed by the stones of the solve in progress
+    Arena arena;
+    ListNode *head;
+} Puzzle;
+
+int parse_input(char *input_file, Arena *arena, ListNode **head);
+ListNode *append__Vec(Arena *arena, ListNode *tail, long long val);
+ListNode *copy_list(Arena *arena, ListNode *head);
+void insert_after(Arena *arena, ListNode *parent, long long val);
 int split_digits(long long n, long long *most_sig, long long *least_sig);
 int log_10(long long n);
-long long get_length_and_free(ListNode *head);
-void apply_operation(ListNode *node);
-void apply_operations(ListNode *head);
+long long get_length(ListNode *head);
+void apply_operation(Arena *arena, ListNode *node);
+void apply_operations(Arena *arena, ListNode *head);
 void print_list(ListNode *head);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
+    // Every stone is allocated from here
+    Arena arena = new_arena(0UL);
     // The head of the list of stones
     ListNode *head = NULL;
     // The number of "blinks" to execute
@@ -40,63 +61,113 @@ int main(int argc, char *argv[])
         blinks = 25;
     }
 
-    if (parse_input(input_file, &head))
+    if (parse_input(input_file, &arena, &head))
         return 1;
 
     // Apply operations `blinks` times
     for (int i = 0; i < blinks; i++)
-        apply_operations(head);
+        apply_operations(&arena, head);
     
     // print_list(head);
-    printf("Final stone count: %lld\n", get_length_and_free(head));
+    printf("Final stone count: %lld\n", get_length(head));
+
+    delete_arena(&arena);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    puzzle->arena = new_arena(0UL);
+    if (parse_input(input_file, &puzzle->arena, &puzzle->head))
+    {
+        delete_arena(&puzzle->arena);
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
 
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    // Blink a copy of the stones, then free every stone made by this solve at once
+    ArenaMark mark = arena_mark(&p->arena);
+    ListNode *head = copy_list(&p->arena, p->head);
+    for (int i = 0; i < PUZZLE_BLINKS; i++)
+        apply_operations(&p->arena, head);
+    snprintf(answer, ANSWER_SIZE, "%lld", get_length(head));
+    arena_reset(&p->arena, mark);
     return 0;
 }
 
+void delete_puzzle(void *puzzle)
+{
+    delete_arena(&((Puzzle *)puzzle)->arena);
+    free(puzzle);
+}
+
+DEF_SOLVER(11, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file into
 /// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param arena The arena to allocate the list from
 /// @param head Out: The head of the linked list of numbers that have been read
 /// @return 0 if success, non-zero if failure
-int parse_input(char *input_file, ListNode **head)
+int parse_input(char *input_file, Arena *arena, ListNode **head)
 {
-    // Open input.txt or stdin or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
     // Dummy node to point to the future head
     // This feels like a dumb way to do this, but I can't think of a better way right now
     ListNode pre_head;
     ListNode *tail = &pre_head;
+    Span span = input_span(&input);
     long long val;
-    while (fscanf(f, "%lld", &val) != EOF)
-        tail = append__Vec(tail, val);
+    while (next_number(&span, &val))
+        tail = append__Vec(arena, tail, val);
     tail->next = NULL;
     *head = pre_head.next;
 
+    close_input(&input);
     return 0;
 }
 
 /// @brief Append the value to tail
+/// @param arena The arena to allocate the new node from
 /// @param tail The tail of the list to append__Vec
 /// @param val The value to append__Vec
 /// @return The new tail
-ListNode *append__Vec(ListNode *tail, long long val)
+ListNode *append__Vec(Arena *arena, ListNode *tail, long long val)
 {
-    tail = tail->next = malloc(sizeof(ListNode));
+    tail = tail->next = ARENA_NEW(arena, ListNode);
     tail->val = val;
     return tail;
 }
 
+/// @brief Copy a linked list
+/// @param arena The arena to allocate the copy from
+/// @param head The head of the list to copy
+/// @return The head of the copy
+ListNode *copy_list(Arena *arena, ListNode *head)
+{
+    ListNode pre_head;
+    ListNode *tail = &pre_head;
+    for (; head; head = head->next)
+        tail = append__Vec(arena, tail, head->val);
+    tail->next = NULL;
+    return pre_head.next;
+}
+
 /// @brief Insert a node containing `val` after this node
+/// @param arena The arena to allocate the new node from
 /// @param parent The parent node of the new node
 /// @param val The value to insert
-void insert_after(ListNode *parent, long long val)
+void insert_after(Arena *arena, ListNode *parent, long long val)
 {
-    ListNode *node = malloc(sizeof(ListNode));
+    ListNode *node = ARENA_NEW(arena, ListNode);
     node->next = parent->next;
     node->val = val;
     parent->next = node;
@@ -114,41 +185,37 @@ void print_list(ListNode *head)
     printf("\n");
 }
 
-/// @brief Get the length of a linked list, freeing all elements in the process
+/// @brief Get the length of a linked list
 /// @param head The head of the list
 /// @return The length of the list starting at head
-long long get_length_and_free(ListNode *head)
+long long get_length(ListNode *head)
 {
     long long count = 0LL;
-    ListNode *next;
-    while (head)
-    {
+    for (; head; head = head->next)
         count++;
-        next = head->next;
-        free(head);
-        head = next;
-    }
     return count;
 }
 
 /// @brief Apply `apply_operation(...)` to all elements in the given list
+/// @param arena The arena to allocate new stones from
 /// @param head The head of the list to apply operations to
-void apply_operations(ListNode *head)
+void apply_operations(Arena *arena, ListNode *head)
 {
     ListNode *next;
     while (head)
     {
         // Find the next node before applying the operation to prevent issues when the operation inserts a stone after this node
         next = head->next;
-        apply_operation(head);
+        apply_operation(arena, head);
         // Finally, set the head node to the next node for the next operation
         head = next;
     }
 }
 
 /// @brief Apply the appropriate operation to the stone represented by `node`
+/// @param arena The arena to allocate a new stone from
 /// @param node The node representing this stone
-void apply_operation(ListNode *node)
+void apply_operation(Arena *arena, ListNode *node)
 {
     long long left_stone, right_stone;
     if (!(node->val))
@@ -159,7 +226,7 @@ void apply_operation(ListNode *node)
         // If the stone is engraved with a number that has an even number of digits, it is replaced by two stones.
         // The left half of the digits are engraved on the new left stone, and the right half of the digits are engraved on the new right stone.
         node->val = left_stone;
-        insert_after(node, right_stone);
+        insert_after(arena, node, right_stone);
     }
     else
         // If none of the other rules apply, the stone is replaced by a new stone; the old stone's number multiplied by 2024 is engraved on the new stone.
@@ -1,6 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/arena.h"
+
+// The number of blinks the actual puzzle asks for
+#define PUZZLE_BLINKS 75
+
 // Singly linked list
 typedef struct ListNode
 {
@@ -24,22 +31,38 @@ typedef struct Trie
    This is my alternative to caching in a hashmap of (long long blinks, long long stone) -> count
 */
 Trie **cache;
+// Every trie node in `cache` is allocated from here, so the whole cache is freed at once
+Arena cache_arena;
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    Arena arena;
+    ListNode *head;
+} Puzzle;
 
-int parse_input(char *input_file, ListNode **head);
-ListNode *append__list_Vec(ListNode *tail, long long val);
-void insert_after(ListNode *parent, long long val);
+int parse_input(char *input_file, Arena *arena, ListNode **head);
+ListNode *append__list_Vec(Arena *arena, ListNode *tail, long long val);
+void insert_after(Arena *arena, ListNode *parent, long long val);
 int split_digits(long long n, long long *most_sig, long long *least_sig);
 int log_10(long long n);
-long long get_length_and_free(ListNode *head);
 long long children_of_the_stone(long long stone, int blinks);
 long long count_stones(ListNode *head, int blinks);
 void print_list(ListNode *head);
-void insert_trie(Trie *root, long long key, long long val);
-void delete_trie(Trie *root);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+void new_cache(int blinks);
+void new_puzzle_cache();
+void delete_cache();
+void insert_trie(Arena *arena, Trie *root, long long key, long long val);
+Trie *new_trie(Arena *arena);
 long long get_trie(Trie *root, long long key);
 
 int main(int argc, char *argv[])
 {
+    // Every stone is allocated from here
+    Arena arena = new_arena(0UL);
     // The head of the list of stones
     ListNode *head = NULL;
     // The number of "blinks" to execute
@@ -60,63 +83,96 @@ int main(int argc, char *argv[])
         blinks = 25;
     }
 
-    if (parse_input(input_file, &head))
+    if (parse_input(input_file, &arena, &head))
         return 1;
 
     // print_list(head);
+    new_cache(blinks);
     printf("Final stone count: %lld\n", count_stones(head, blinks));
 
     // Cleanup
-    get_length_and_free(head);
+    delete_cache();
+    delete_arena(&arena);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    puzzle->arena = new_arena(0UL);
+    if (parse_input(input_file, &puzzle->arena, &puzzle->head))
+    {
+        delete_arena(&puzzle->arena);
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    snprintf(answer, ANSWER_SIZE, "%lld", count_stones(((Puzzle *)puzzle)->head, PUZZLE_BLINKS));
     return 0;
 }
 
+void delete_puzzle(void *puzzle)
+{
+    delete_arena(&((Puzzle *)puzzle)->arena);
+    free(puzzle);
+}
+
+// The count for a stone and number of blinks doesn't depend on the input, so the cache is kept for every puzzle in a batch
+void new_puzzle_cache() { new_cache(PUZZLE_BLINKS); }
+
+DEF_SOLVER_WITH_TABLES(11, 2, parse_puzzle, solve_puzzle, delete_puzzle, new_puzzle_cache, delete_cache)
+
 /// @brief Parse the input file into
 ///
 /// A linked list is used because that was how the brute force solution was implemented and I don't need to change this part
 /// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param arena The arena to allocate the list from
 /// @param head Out: The head of the linked list of numbers that have been read
 /// @return 0 if success, non-zero if failure
-int parse_input(char *input_file, ListNode **head)
+int parse_input(char *input_file, Arena *arena, ListNode **head)
 {
-    // Open input.txt or stdin or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
     // Dummy node to point to the future head
     // This feels like a dumb way to do this, but I can't think of a better way right now
     ListNode pre_head;
     ListNode *tail = &pre_head;
+    Span span = input_span(&input);
     long long val;
-    while (fscanf(f, "%lld", &val) != EOF)
-        tail = append__list_Vec(tail, val);
+    while (next_number(&span, &val))
+        tail = append__list_Vec(arena, tail, val);
     tail->next = NULL;
     *head = pre_head.next;
 
+    close_input(&input);
     return 0;
 }
 
 /// @brief Append the value to tail
+/// @param arena The arena to allocate the new node from
 /// @param tail The tail of the list to append__Vec
 /// @param val The value to append__Vec
 /// @return The new tail
-ListNode *append__list_Vec(ListNode *tail, long long val)
+ListNode *append__list_Vec(Arena *arena, ListNode *tail, long long val)
 {
-    tail = tail->next = malloc(sizeof(ListNode));
+    tail = tail->next = ARENA_NEW(arena, ListNode);
     tail->val = val;
     return tail;
 }
 
 /// @brief Insert a node containing `val` after this node
+/// @param arena The arena to allocate the new node from
 /// @param parent The parent node of the new node
 /// @param val The value to insert
-void insert_after(ListNode *parent, long long val)
+void insert_after(Arena *arena, ListNode *parent, long long val)
 {
-    ListNode *node = malloc(sizeof(ListNode));
+    ListNode *node = ARENA_NEW(arena, ListNode);
     node->next = parent->next;
     node->val = val;
     parent->next = node;
@@ -134,38 +190,13 @@ void print_list(ListNode *head)
     printf("\n");
 }
 
-/// @brief Get the length of a linked list, freeing all elements in the process
-/// @param head The head of the list
-/// @return The length of the list starting at head
-long long get_length_and_free(ListNode *head)
-{
-    long long count = 0LL;
-    ListNode *next;
-    while (head)
-    {
-        count++;
-        next = head->next;
-        free(head);
-        head = next;
-    }
-    return count;
-}
-
-/// @brief Count the total number of stones after applying `children_of_the_stone(...)` to each stone `blinks` times
+/// @brief Count the total number of stones after applying `children_of_the_stone(...)` to each stone `blinks` times.
+/// The cache must be allocated by new_cache for at least `blinks` blinks
 /// @param head The list of stones in the base case
 /// @param blinks The number of blinks to perform
 /// @return The total number of stones after `blinks` operations to each stone
 long long count_stones(ListNode *head, int blinks)
 {
-    // Initialize cache array
-    cache = malloc(blinks * sizeof(cache[0]));
-    for (int i = 0; i < blinks; i++)
-    {
-        cache[i] = calloc(1, sizeof(*cache[0]));
-        // Indicate that stone of 0 is unknown
-        cache[i]->val = -1;
-    }
-
     long long total_stones = 0;
     ListNode *next;
     while (head)
@@ -176,11 +207,24 @@ long long count_stones(ListNode *head, int blinks)
         // Finally, set the head node to the next node for the next operation
         head = next;
     }
-    // Free cache
+    return total_stones;
+}
+
+/// @brief Allocate an empty cache
+/// @param blinks The most blinks that will be counted before delete_cache
+void new_cache(int blinks)
+{
+    cache_arena = new_arena(0UL);
+    cache = malloc(blinks * sizeof(cache[0]));
     for (int i = 0; i < blinks; i++)
-        delete_trie(cache[i]);
+        cache[i] = new_trie(&cache_arena);
+}
+
+// Free the cache
+void delete_cache()
+{
+    delete_arena(&cache_arena);
     free(cache);
-    return total_stones;
 }
 
 /// @brief Count the number of stones that will exist after applying `blinks` operations to this stone
@@ -221,7 +265,7 @@ long long children_of_the_stone(long long stone, int blinks)
         child_count = children_of_the_stone(2024 * stone, blinks);
 
     // Memoize
-    insert_trie(cache[blinks], stone, child_count);
+    insert_trie(&cache_arena, cache[blinks], stone, child_count);
     // for (int i = 0; i < 5 - (blinks + 1); i++)
     //     printf(" ");
     // printf("Stone %lld, blinks %d: %lld\n", stone, blinks + 1, child_count);
@@ -274,11 +318,22 @@ int log_10(long long n)
     return log;
 }
 
+/// @brief Allocate an empty trie node, with no value (-1)
+/// @param arena The arena to allocate the node from
+/// @return The node
+Trie *new_trie(Arena *arena)
+{
+    Trie *node = arena_calloc(arena, sizeof(Trie));
+    node->val = -1;
+    return node;
+}
+
 /// @brief Insert `val` into the trie under `key`
+/// @param arena The arena to allocate new nodes from
 /// @param root The trie to insert into
 /// @param key The key
 /// @param val The value to insert
-void insert_trie(Trie *root, long long key, long long val)
+void insert_trie(Arena *arena, Trie *root, long long key, long long val)
 {
     if (!key)
     {
@@ -291,23 +346,11 @@ void insert_trie(Trie *root, long long key, long long val)
     long long subkey = key % (sizeof(root->children) / sizeof(root->children[0]));
     key /= sizeof(root->children) / sizeof(root->children[0]);
 
+    // Initialize the child if it doesn't already exist
     if (!root->children[subkey])
-    {
-        // Initialize the child if it doesn't already exist
-        root->children[subkey] = calloc(1, sizeof(*(root->children[0])));
-        root->children[subkey]->val = -1;
-    }
+        root->children[subkey] = new_trie(arena);
 
-    insert_trie(root->children[subkey], key, val);
-}
-
-/// Free everything in the trie, including root
-void delete_trie(Trie *root)
-{
-    for (size_t i = 0; i < sizeof(root->children) / sizeof(root->children[0]); i++)
-        if (root->children[i])
-            delete_trie(root->children[i]);
-    free(root);
+    insert_trie(arena, root->children[subkey], key, val);
 }
 
 /// @brief Get the value at `key` if it exists
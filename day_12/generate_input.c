@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// The average width of a region. Regions are built around one seed point per REGION_SIZE x REGION_SIZE block
+#define REGION_SIZE 10
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 140, 1, 65536, "The number of rows and columns");
+    if (size == -1)
+        return 1;
+
+    // Put a seed with a random plant type at a random point in each block
+    long long blocks = (size + REGION_SIZE - 1) / REGION_SIZE;
+    long long *seed_row = malloc(sizeof(seed_row[0]) * blocks * blocks);
+    long long *seed_col = malloc(sizeof(seed_col[0]) * blocks * blocks);
+    char *seed_plant = malloc(blocks * blocks);
+    for (long long i = 0; i < blocks * blocks; i++)
+    {
+        seed_row[i] = (i / blocks) * REGION_SIZE + random_range(0, REGION_SIZE - 1);
+        seed_col[i] = (i % blocks) * REGION_SIZE + random_range(0, REGION_SIZE - 1);
+        seed_plant[i] = 'A' + random_range(0, 25);
+    }
+
+    // Each plot gets the plant of its closest seed. Only seeds in the same or neighboring blocks can be closest
+    for (long long row = 0; row < size; row++)
+    {
+        for (long long col = 0; col < size; col++)
+        {
+            long long block_row = row / REGION_SIZE;
+            long long block_col = col / REGION_SIZE;
+            long long best_distance = -1;
+            char plant = 'A';
+            for (long long i = block_row - 1; i <= block_row + 1; i++)
+            {
+                for (long long j = block_col - 1; j <= block_col + 1; j++)
+                {
+                    if (i < 0 || i >= blocks || j < 0 || j >= blocks)
+                        continue;
+                    long long seed = i * blocks + j;
+                    long long distance = llabs(seed_row[seed] - row) + llabs(seed_col[seed] - col);
+                    if (best_distance == -1 || distance < best_distance)
+                    {
+                        best_distance = distance;
+                        plant = seed_plant[seed];
+                    }
+                }
+            }
+            putchar(plant);
+        }
+        putchar('\n');
+    }
+
+    free(seed_row);
+    free(seed_col);
+    free(seed_plant);
+    return 0;
+}
@@ -1,115 +1,105 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/grid.h"
 
-typedef char *string;
+int parse_input(char *input_file, Grid *map);
+long long get_total_fencing(Grid map);
+long long get_region_price(Grid map, int index, long long *area);
+void print_map(Grid map);
 
-DEF_VEC(char)
-DEF_VEC(string)
-void delete_string_vec(string_Vec *vec)
-{
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
-    free(vec->arr);
-    vec->arr = NULL;
-    vec->len = 0UL;
-    vec->cap = 0UL;
-}
-
-int parse_input(char *input_file, string_Vec *map);
-long long get_total_fencing(char **map, size_t map_size);
-long long get_region_price(char **map, size_t map_size, int row, int col, long long *area);
-void print_map(char **map, size_t map_size);
-// Check is a row,col pair is valid on the map
-int valid_point(char **map, size_t map_size, int row, int col) { return row >= 0 && col >= 0 && row < map_size && map[row][col]; }
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
     // Get input
-    string_Vec map;
+    Grid map;
     char *input_file = (argc >= 2) ? argv[1] : NULL;
     if (parse_input(input_file, &map))
         return 1;
 
-    long long total_price = get_total_fencing(map.arr, map.len);
-    print_map(map.arr, map.len);
+    long long total_price = get_total_fencing(map);
+    print_map(map);
 
     printf("\e[37m\nTotal price: %lld\n", total_price);
 
     // Clean up
-    delete_string_vec(&map);
+    delete_grid(&map);
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Grid *map = malloc(sizeof(Grid));
+    if (parse_input(input_file, map))
+    {
+        free(map);
+        return NULL;
+    }
+    return map;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    snprintf(answer, ANSWER_SIZE, "%lld", get_total_fencing(*(Grid *)puzzle));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    delete_grid(puzzle);
+    free(puzzle);
+}
+
+DEF_SOLVER(12, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file into `map`
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param map Out: the file after it's loaded
 /// @return 0 if success, non-zero if failure
-int parse_input(char *input_file, string_Vec *map)
+int parse_input(char *input_file, Grid *map)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
-
-    *map = new_string_Vec();
 
-    int ch;
-    char_Vec row = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
+    Span span = input_span(&input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        if (ch != '\n')
-            // Anything other than EOF and newline can just get append_ed_Vec to the vector
-            append_char_Vec(&row, (char)ch);
-        else
-        {
-            // Add terminator for the string and put it on the string vector
-            append_char_Vec(&row, '\0');
-            append_string_Vec(map, row.arr);
-            // Generate a new char vector for the next iteration
-            // Slight optimization: start with a capacity of this array's length
-            row.arr = malloc(sizeof(row.arr[0]) * row.len);
-            row.cap = row.len;
-            row.len = 0UL;
-        }
-    }
-
-    // If relevant, append__Vec the last row. Otherwise, just free the row
-    if (row.len > 0)
-    {
-        append_char_Vec(&row, '\0');
-        append_string_Vec(map, row.arr);
+        fprintf(stderr, "Expected a rectangular map\n");
+        close_input(&input);
+        return 1;
     }
-    else
-        free(row.arr);
 
+    // Past the edge of the map is '\0', which is never the same plant as anything on the map
+    *map = grid_from_view(grid, 1, '\0');
+    close_input(&input);
     return 0;
 }
 
 /// @brief Print the map to stdout, graying out characters with the most significant bit set
 /// @param map The map
-/// @param map_size The number of rows in `map`
-void print_map(char **map, size_t map_size)
+void print_map(Grid map)
 {
     char last_char = '\0';
-    for (size_t i = 0; i < map_size; i++)
+    for (int row = 0; row < map.rows; row++)
     {
-        char *row = map[i];
-        while (*row)
+        for (int col = 0; col < map.cols; col++)
         {
+            char ch = GRID_CELL(map, row, col);
             // ch & 0x80 indicates used, which should be grayed out unless this is already grayed out
-            if ((*row & (char)0x80) && !(last_char & (char)0x80))
+            if ((ch & (char)0x80) && !(last_char & (char)0x80))
                 printf("\e[90m");
             // Reset back to white if the last character was gray
-            else if (!(*row & (char)0x80) && (last_char & (char)0x80))
+            else if (!(ch & (char)0x80) && (last_char & (char)0x80))
                 printf("\e[37m");
-            last_char = *row;
-            putchar(*row & (char)0x7f);
-            row++;
+            last_char = ch;
+            putchar(ch & (char)0x7f);
         }
         putchar('\n');
     }
@@ -117,68 +107,55 @@ void print_map(char **map, size_t map_size)
 
 /// @brief Get the total price of fencing for a given map
 /// @param map A map of characters representing garden squares
-/// @param map_size The number of rows in `map`
 /// @return The total price (sum of perimeter*area for each region)
-long long get_total_fencing(char **map, size_t map_size)
+long long get_total_fencing(Grid map)
 {
     long long total = 0LL;
     long long perimeter;
     long long area;
-    for (int i = 0; i < map_size; i++)
+    for (int i = 0; i < map.rows; i++)
     {
-        for (int j = 0; map[i][j]; j++)
+        for (int j = 0; j < map.cols; j++)
         {
             area = 0LL;
-            perimeter = get_region_price(map, map_size, i, j, &area);
+            perimeter = get_region_price(map, GRID_INDEX(map, i, j), &area);
             total += perimeter * area;
         }
     }
     return total;
 }
 
-/// @brief Find the price of a region containing map[row][col]
+/// @brief Find the price of a region containing the cell at `index`
 /// @param map The map
-/// @param map_size The number of rows in the map
-/// @param row The row to look at
-/// @param col The column to look at
+/// @param index The index of the cell to look at
 /// @param area Out: The total area of this map. This will be added to, not replaced
 /// @return The perimeter
-long long get_region_price(char **map, size_t map_size, int row, int col, long long *area)
+long long get_region_price(Grid map, int index, long long *area)
 {
-    // Ignore squares that have already been found and squares that don't exist
-    if ((map[row][col] & (char)0x80) || !map[row][col])
+    // Ignore squares that have already been found
+    if (map.cells[index] & (char)0x80)
         return 0;
 
     // Set this as found by setting the most significant bit, but save this character for comparisons
     // This will never be set in an actual ASCII character
-    char this_before_found = map[row][col];
-    map[row][col] |= (char)0x80;
+    char this_before_found = map.cells[index];
+    map.cells[index] |= (char)0x80;
 
     long long perimeter = 0LL;
 
-// Check a side
-#define CHECK_SIDE(r, c)                                                                  \
-    do                                                                                    \
-    {                                                                                     \
-        if (!valid_point(map, map_size, r, c) || (map[r][c] & 0x7f) != this_before_found) \
-            /* If this side is on the edge of the map,                                    \
-            or a character that is not this character, add a fence */                     \
-            perimeter++;                                                                  \
-        else                                                                              \
-            /* If not edge and the same character, check that character */                \
-            perimeter += get_region_price(map, map_size, r, c, area);                     \
-    } while (0)
-
-    // Right
-    CHECK_SIDE(row, col + 1);
-    // Up
-    CHECK_SIDE(row - 1, col);
-    // Left
-    CHECK_SIDE(row, col - 1);
-    // Down
-    CHECK_SIDE(row + 1, col);
-
-#undef CHECK_SIDE
+    // Check right, up, left, and down
+    for (int dir = 0; dir < GRID_DIRECTIONS; dir++)
+    {
+        int neighbor = index + map.step[dir];
+        if ((map.cells[neighbor] & 0x7f) != this_before_found)
+            // If this side is on the edge of the map (the border is '\0'),
+            // or a character that is not this character, add a fence
+            perimeter++;
+        else
+            // If not edge and the same character, check that character
+            perimeter += get_region_price(map, neighbor, area);
+    }
+
     (*area)++;
     return perimeter;
 }
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+#define MIN_BUTTON_MOVE 10
+#define MAX_BUTTON_MOVE 99
+#define MAX_PRESSES 100
+
+int main(int argc, char *argv[])
+{
+    long long machines = parse_generator_args(argc, argv, 320, 1, 100000000, "The number of claw machines");
+    if (machines == -1)
+        return 1;
+
+    for (long long i = 0; i < machines; i++)
+    {
+        long long ax = random_range(MIN_BUTTON_MOVE, MAX_BUTTON_MOVE);
+        long long ay = random_range(MIN_BUTTON_MOVE, MAX_BUTTON_MOVE);
+        long long bx = random_range(MIN_BUTTON_MOVE, MAX_BUTTON_MOVE);
+        long long by = random_range(MIN_BUTTON_MOVE, MAX_BUTTON_MOVE);
+
+        // Put the prize where some number of presses lands, then move about half of them so they can't be won
+        long long a_presses = random_range(0, MAX_PRESSES);
+        long long b_presses = random_range(0, MAX_PRESSES);
+        long long prize_x = a_presses * ax + b_presses * bx;
+        long long prize_y = a_presses * ay + b_presses * by;
+        if (next_random() & 1)
+        {
+            prize_x += random_range(1, MAX_BUTTON_MOVE);
+            prize_y += random_range(1, MAX_BUTTON_MOVE);
+        }
+
+        if (i)
+            printf("\n");
+        printf("Button A: X+%lld, Y+%lld\nButton B: X+%lld, Y+%lld\nPrize: X=%lld, Y=%lld\n", ax, ay, bx, by, prize_x, prize_y);
+    }
+
+    return 0;
+}
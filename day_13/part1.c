@@ -3,6 +3,11 @@
 #include <limits.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/thread_pool.h"
+#include "../runner/stream.h"
 
 #define A_PRICE 3
 #define B_PRICE 1
@@ -22,13 +27,27 @@ typedef struct ClawMachine
 } ClawMachine;
 
 DEF_VEC(ClawMachine)
+DEF_VEC_CAPACITY(ClawMachine)
+
+// A number of tokens. A single identifier so it can be reduced in parallel
+typedef long long Tokens;
 
 int parse_input(char *input_file, ClawMachine_Vec *claw_machines);
+int parse_claw_machine(Span record, ClawMachine *claw_machine);
 long long count_total_tokens(ClawMachine *claw_machines, size_t claw_machines_size);
+Tokens count_tokens(size_t begin, size_t end, int worker, void *ctx);
+int count_record_tokens(Span records, int worker, void *ctx, long long *total_tokens);
+Tokens add_tokens(Tokens a, Tokens b) { return a + b; }
+DEF_PARALLEL_REDUCE(Tokens)
 int min_tokens(ClawMachine claw_machine);
 void print_claw_machine(ClawMachine claw_machine);
 int min(int a, int b);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+int stream_puzzle(char *input_file, char *answer);
+
 int main(int argc, char *argv[])
 {
     ClawMachine_Vec claw_machines;
@@ -46,42 +65,112 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    ClawMachine_Vec *claw_machines = malloc(sizeof(ClawMachine_Vec));
+    if (parse_input(input_file, claw_machines))
+    {
+        free(claw_machines);
+        return NULL;
+    }
+    return claw_machines;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    ClawMachine_Vec *claw_machines = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", count_total_tokens(claw_machines->arr, claw_machines->len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((ClawMachine_Vec *)puzzle)->arr);
+    free(puzzle);
+}
+
+int stream_puzzle(char *input_file, char *answer)
+{
+    // Claw machines are separated by blank lines
+    long long total_tokens;
+    if (stream_sum(input_file, "\n\n", count_record_tokens, NULL, &total_tokens))
+        return 1;
+    snprintf(answer, ANSWER_SIZE, "%lld", total_tokens);
+    return 0;
+}
+
+DEF_STREAM_SOLVER(13, 1, parse_puzzle, solve_puzzle, delete_puzzle, stream_puzzle)
+
 /// @brief Parse the input file into `claw_machines`
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param claw_machines Out: The vector of claw machines
 /// @return 0 if success, non-zero if failure
 int parse_input(char *input_file, ClawMachine_Vec *claw_machines)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    *claw_machines = new_ClawMachine_Vec();
-
-    ClawMachine claw_machine;
-    while (fscanf(
-               f,
-               "Button A: X%hd, Y%hd\nButton B: X%hd, Y%hd\nPrize: X=%hd, Y=%hd\n",
-               &(claw_machine.button_a.x),
-               &(claw_machine.button_a.y),
-               &(claw_machine.button_b.x),
-               &(claw_machine.button_b.y),
-               &(claw_machine.target.x),
-               &(claw_machine.target.y)) == 6)
+    // Each claw machine is 3 lines and a blank line, so they are allocated once at their full size
+    Span span = input_span(&input);
+    size_t machines = (count_lines(span) + 1) / 4;
+    *claw_machines = with_capacity_ClawMachine_Vec(machines);
+
+    Span record;
+    while (next_record(&span, &record))
     {
-        if (ferror(f))
+        ClawMachine claw_machine;
+        if (parse_claw_machine(record, &claw_machine))
         {
-            fprintf(stderr, "Error reading input\n");
             free(claw_machines->arr);
             claw_machines->arr = NULL;
+            close_input(&input);
             return 1;
         }
         append_ClawMachine_Vec(claw_machines, claw_machine);
     }
+
+    close_input(&input);
+    return 0;
+}
+
+/// @brief Parse one claw machine
+/// @param record The record of the claw machine: "Button A: X+_, Y+_\nButton B: X+_, Y+_\nPrize: X=_, Y=_"
+/// @param claw_machine Out: The claw machine
+/// @return 0 if success, non-zero if failure
+int parse_claw_machine(Span record, ClawMachine *claw_machine)
+{
+    long long values[6];
+    if (next_numbers(&record, values, 6) != 6)
+    {
+        fprintf(stderr, "Expected 6 numbers for each claw machine\n");
+        return 1;
+    }
+
+    *claw_machine = (ClawMachine){
+        .button_a = {values[0], values[1]},
+        .button_b = {values[2], values[3]},
+        .target = {values[4], values[5]},
+    };
+    return 0;
+}
+
+/// @brief Count the tokens for the claw machines in some records of the input, without keeping them. Used by stream_sum
+/// @param records Whole records of the input
+/// @param worker The thread running this
+/// @param ctx Unused
+/// @param total_tokens In/out: The total number of tokens, which the tokens for these claw machines are added to
+/// @return 0 if success, non-zero if a claw machine is invalid
+int count_record_tokens(Span records, int worker, void *ctx, long long *total_tokens)
+{
+    Span record;
+    while (next_record(&records, &record))
+    {
+        ClawMachine claw_machine;
+        if (parse_claw_machine(record, &claw_machine))
+            return 1;
+        *total_tokens += min_tokens(claw_machine);
+    }
     return 0;
 }
 
@@ -108,8 +197,21 @@ int min(int a, int b)
 /// @return The fewest total number of tokens of spent
 long long count_total_tokens(ClawMachine *claw_machines, size_t claw_machines_size)
 {
-    long long total_tokens = 0LL;
-    for (size_t i = 0; i < claw_machines_size; i++)
+    // Each machine is independent, so split them between threads
+    return parallel_reduce_Tokens(0UL, claw_machines_size, 32UL, 0LL, count_tokens, add_tokens, claw_machines);
+}
+
+/// @brief Count the tokens spent on the machines in [begin, end)
+/// @param begin The first machine
+/// @param end One past the last machine
+/// @param worker The thread running this
+/// @param ctx The array of claw machines
+/// @return The number of tokens
+Tokens count_tokens(size_t begin, size_t end, int worker, void *ctx)
+{
+    ClawMachine *claw_machines = ctx;
+    Tokens total_tokens = 0LL;
+    for (size_t i = begin; i < end; i++)
         total_tokens += min_tokens(claw_machines[i]);
     return total_tokens;
 }
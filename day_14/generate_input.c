@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// The real room. The solvers take it as the room size when every robot fits in it but not in the example's 11x7 room
+#define MAP_WIDTH 101
+#define MAP_HEIGHT 103
+// The height of the triangle of robots planted for part 2, which takes TREE_HEIGHT^2 robots
+#define TREE_HEIGHT 10
+
+int main(int argc, char *argv[])
+{
+    long long robots = parse_generator_args(argc, argv, 500, 1, 100000000, "The number of robots");
+    if (robots == -1)
+        return 1;
+
+    // Part 2 looks for a picture, so make the first robots form a triangle after some number of seconds
+    long long tree_time = random_range(1, MAP_WIDTH * MAP_HEIGHT - 1);
+    long long tree_row = random_range(0, MAP_HEIGHT - TREE_HEIGHT);
+    long long tree_col = random_range(TREE_HEIGHT, MAP_WIDTH - TREE_HEIGHT);
+    long long tree_row_offset = 0;
+    long long tree_col_offset = 0;
+
+    for (long long i = 0; i < robots; i++)
+    {
+        long long vx = random_range(-MAP_WIDTH + 1, MAP_WIDTH - 1);
+        long long vy = random_range(-MAP_HEIGHT + 1, MAP_HEIGHT - 1);
+        long long px, py;
+        if (i < TREE_HEIGHT * TREE_HEIGHT)
+        {
+            // Work backwards from the robot's spot in the triangle
+            long long target_x = tree_col + tree_col_offset;
+            long long target_y = tree_row + tree_row_offset;
+            px = ((target_x - vx * tree_time) % MAP_WIDTH + MAP_WIDTH) % MAP_WIDTH;
+            py = ((target_y - vy * tree_time) % MAP_HEIGHT + MAP_HEIGHT) % MAP_HEIGHT;
+
+            // Move to the next spot, going to the next row of the triangle when this one is full
+            if (++tree_col_offset > tree_row_offset)
+            {
+                tree_row_offset++;
+                tree_col_offset = -tree_row_offset;
+            }
+        }
+        else
+        {
+            px = random_range(0, MAP_WIDTH - 1);
+            py = random_range(0, MAP_HEIGHT - 1);
+        }
+        printf("p=%lld,%lld v=%lld,%lld\n", px, py, vx, vy);
+    }
+
+    return 0;
+}
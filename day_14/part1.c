@@ -2,9 +2,11 @@
 #include <stdlib.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/dims.h"
 
-#define MAP_WIDTH 101
-#define MAP_HEIGHT 103
 #define MOVE_COUNT 100
 
 // Doing this ahead of time because I feel like part 2 will be similar but with larger numbers
@@ -26,11 +28,29 @@ typedef struct Robot
 } Robot;
 
 DEF_VEC(Robot)
+DEF_VEC_CAPACITY(Robot)
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    Robot_Vec robots;
+    Point room;
+} Puzzle;
+
+// The sizes of the rooms in the puzzle: the example's, then the real one. Neither is in the input
+static const Point ROOM_SIZES[] = {{11, 7}, {101, 103}};
 
 int parse_input(char *input_file, Robot_Vec *robots);
+Point get_room_size(Robot *robots, size_t robots_size);
 void print_robots(Robot *robots, size_t robots_size);
-long long find_tree(Robot *robots, size_t robots_size);
-Point get_destination(Robot robot);
+static DIMS_INLINE long long find_tree_impl(Robot *robots, size_t robots_size, int width, int height);
+// The real room gets its own copy, where wrapping around it divides by constants
+DEF_SIZE_DISPATCH(long long, find_tree, (Robot *robots, size_t robots_size), (robots, robots_size))
+static DIMS_INLINE Point get_destination(Robot robot, int width, int height);
+
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
@@ -40,48 +60,91 @@ int main(int argc, char *argv[])
         return 1;
 
     print_robots(robots.arr, robots.len);
-    printf("Safety_factor: %lld\n", find_tree(robots.arr, robots.len));
+    Point room = get_room_size(robots.arr, robots.len);
+    printf("Safety_factor: %lld\n", find_tree(robots.arr, robots.len, room.x, room.y));
     free(robots.arr);
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->robots))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    puzzle->room = get_room_size(puzzle->robots.arr, puzzle->robots.len);
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", find_tree(p->robots.arr, p->robots.len, p->room.x, p->room.y));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((Puzzle *)puzzle)->robots.arr);
+    free(puzzle);
+}
+
+DEF_SOLVER(14, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file into `robots`
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param claw_machines Out: The vector of robots
 /// @return 0 if success, non-zero if failure
 int parse_input(char *input_file, Robot_Vec *robots)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    *robots = new_Robot_Vec();
+    // One robot per line, so they are allocated once at their full size
+    Span span = input_span(&input);
+    size_t lines = count_lines(span);
+    *robots = with_capacity_Robot_Vec(lines);
 
-    Robot robot;
-    while (fscanf(
-               f,
-               "p=%hd,%hd v=%hd,%hd\n",
-               &robot.pos.x,
-               &robot.pos.y,
-               &robot.vel.x,
-               &robot.vel.y) == 4)
+    // Parse many robots at a time. Each line is "p=_,_ v=_,_"
+    long long values[256];
+    size_t values_size;
+    while ((values_size = next_numbers(&span, values, 256)) > 3)
     {
-        if (ferror(f))
+        for (size_t i = 0; i + 3 < values_size; i += 4)
         {
-            fprintf(stderr, "Error reading input\n");
-            free(robots->arr);
-            robots->arr = NULL;
-            return 1;
+            Robot robot = {.pos = {values[i], values[i + 1]}, .vel = {values[i + 2], values[i + 3]}};
+            append_Robot_Vec(robots, robot);
         }
-        append_Robot_Vec(robots, robot);
     }
+
+    close_input(&input);
     return 0;
 }
 
+/// @brief Get the size of the room the robots are in: the smallest of ROOM_SIZES that holds them, or just large enough to
+/// hold them if none does
+/// @param robots The array of robots
+/// @param robots_size The number of robots in the array
+/// @return The width and height of the room
+Point get_room_size(Robot *robots, size_t robots_size)
+{
+    Point needed = {1, 1};
+    for (size_t i = 0; i < robots_size; i++)
+    {
+        if (robots[i].pos.x >= needed.x)
+            needed.x = robots[i].pos.x + 1;
+        if (robots[i].pos.y >= needed.y)
+            needed.y = robots[i].pos.y + 1;
+    }
+    for (size_t i = 0; i < sizeof(ROOM_SIZES) / sizeof(ROOM_SIZES[0]); i++)
+        if (needed.x <= ROOM_SIZES[i].x && needed.y <= ROOM_SIZES[i].y)
+            return ROOM_SIZES[i];
+    return needed;
+}
+
 // For debugging: print the array of robots
 void print_robots(Robot *robots, size_t robots_size)
 {
@@ -92,15 +155,17 @@ void print_robots(Robot *robots, size_t robots_size)
 /// @brief Get the "safety factor" from a list of robots
 /// @param robots The array of robots
 /// @param robots_size The number of robots in the array
+/// @param width The width of the room, which is a constant in the copies for DIM_SIZES
+/// @param height The height of the room
 /// @return The product of the number of robots in each quadrant
-long long find_tree(Robot *robots, size_t robots_size)
+static DIMS_INLINE long long find_tree_impl(Robot *robots, size_t robots_size, int width, int height)
 {
     long long robots_per_quadrant[4] = {0};
-    Point mid = {MAP_WIDTH / 2, MAP_HEIGHT / 2};
+    Point mid = {width / 2, height / 2};
 
     for (size_t i = 0; i < robots_size; i++)
     {
-        Point dest = get_destination(robots[i]);
+        Point dest = get_destination(robots[i], width, height);
         if (dest.x < mid.x)
         {
             // Left side
@@ -132,11 +197,13 @@ long long find_tree(Robot *robots, size_t robots_size)
 
 /// @brief Get the destination of the robot after `MOVE_COUNT` seconds
 /// @param robot
+/// @param width The width of the room
+/// @param height The height of the room
 /// @return
-Point get_destination(Robot robot)
+static DIMS_INLINE Point get_destination(Robot robot, int width, int height)
 {
     return (Point){
-        ((robot.vel.x * MOVE_COUNT + robot.pos.x) % MAP_WIDTH + MAP_WIDTH) % MAP_WIDTH,
-        ((robot.vel.y * MOVE_COUNT + robot.pos.y) % MAP_HEIGHT + MAP_HEIGHT) % MAP_HEIGHT,
+        ((robot.vel.x * MOVE_COUNT + robot.pos.x) % width + width) % width,
+        ((robot.vel.y * MOVE_COUNT + robot.pos.y) % height + height) % height,
     };
 }
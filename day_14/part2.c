@@ -1,10 +1,15 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/dims.h"
 
-#define MAP_WIDTH 101
-#define MAP_HEIGHT 103
+// The triangle size used to recognize the tree without a human looking at the candidates
+#define PUZZLE_TRIANGLE_SIZE 5
 
 // Doing this ahead of time because I feel like part 2 will be similar but with larger numbers
 // Just need to remember to replace "%hd" with the appropriate flag
@@ -25,13 +30,33 @@ typedef struct Robot
 } Robot;
 
 DEF_VEC(Robot)
+DEF_VEC_CAPACITY(Robot)
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    Robot_Vec robots;
+    Point room;
+} Puzzle;
+
+// The sizes of the rooms in the puzzle: the example's, then the real one. Neither is in the input
+static const Point ROOM_SIZES[] = {{11, 7}, {101, 103}};
 
 int parse_input(char *input_file, Robot_Vec *robots);
+Point get_room_size(Robot *robots, size_t robots_size);
 void print_robots(Robot *robots, size_t robots_size);
-void find_tree(Robot *robots, size_t robots_size, int iterations, int triangle_size);
-Point get_destination(Robot robot);
-void print_map(short map[MAP_HEIGHT][MAP_WIDTH]);
-int has_triangle(short map[MAP_HEIGHT][MAP_WIDTH], int triangle_size);
+static DIMS_INLINE int find_tree_impl(Robot *robots, size_t robots_size, int iterations, int triangle_size, bool print_candidates,
+                                      int width, int height);
+// The real room gets its own copy, where wrapping around it divides by constants
+DEF_SIZE_DISPATCH(int, find_tree, (Robot *robots, size_t robots_size, int iterations, int triangle_size, bool print_candidates),
+                  (robots, robots_size, iterations, triangle_size, print_candidates))
+static DIMS_INLINE Point get_destination(Robot robot, int width, int height);
+void print_map(short *map, int width, int height);
+static DIMS_INLINE int has_triangle(short *map, int triangle_size, int width, int height);
+
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
@@ -43,48 +68,93 @@ int main(int argc, char *argv[])
     int iterations = (argc >= 3) ? atoi(argv[2]) : 100;
     int triangle_size = (argc >= 4) ? atoi(argv[3]) : 3;
     // print_robots(robots.arr, robots.len);
-    find_tree(robots.arr, robots.len, iterations, triangle_size);
+    Point room = get_room_size(robots.arr, robots.len);
+    find_tree(robots.arr, robots.len, iterations, triangle_size, true, room.x, room.y);
     free(robots.arr);
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->robots))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    puzzle->room = get_room_size(puzzle->robots.arr, puzzle->robots.len);
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    // The robots return to their starting positions after width * height seconds, so the tree must be before that
+    int seconds = find_tree(p->robots.arr, p->robots.len, p->room.x * p->room.y, PUZZLE_TRIANGLE_SIZE, false, p->room.x, p->room.y);
+    snprintf(answer, ANSWER_SIZE, "%d", seconds);
+    return seconds == -1;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((Puzzle *)puzzle)->robots.arr);
+    free(puzzle);
+}
+
+DEF_SOLVER(14, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file into `robots`
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param claw_machines Out: The vector of robots
 /// @return 0 if success, non-zero if failure
 int parse_input(char *input_file, Robot_Vec *robots)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    *robots = new_Robot_Vec();
+    // One robot per line, so they are allocated once at their full size
+    Span span = input_span(&input);
+    size_t lines = count_lines(span);
+    *robots = with_capacity_Robot_Vec(lines);
 
-    Robot robot;
-    while (fscanf(
-               f,
-               "p=%hd,%hd v=%hd,%hd\n",
-               &robot.pos.x,
-               &robot.pos.y,
-               &robot.vel.x,
-               &robot.vel.y) == 4)
+    // Parse many robots at a time. Each line is "p=_,_ v=_,_"
+    long long values[256];
+    size_t values_size;
+    while ((values_size = next_numbers(&span, values, 256)) > 3)
     {
-        if (ferror(f))
+        for (size_t i = 0; i + 3 < values_size; i += 4)
         {
-            fprintf(stderr, "Error reading input\n");
-            free(robots->arr);
-            robots->arr = NULL;
-            return 1;
+            Robot robot = {.pos = {values[i], values[i + 1]}, .vel = {values[i + 2], values[i + 3]}};
+            append_Robot_Vec(robots, robot);
         }
-        append_Robot_Vec(robots, robot);
     }
+
+    close_input(&input);
     return 0;
 }
 
+/// @brief Get the size of the room the robots are in: the smallest of ROOM_SIZES that holds them, or just large enough to
+/// hold them if none does
+/// @param robots The array of robots
+/// @param robots_size The number of robots in the array
+/// @return The width and height of the room
+Point get_room_size(Robot *robots, size_t robots_size)
+{
+    Point needed = {1, 1};
+    for (size_t i = 0; i < robots_size; i++)
+    {
+        if (robots[i].pos.x >= needed.x)
+            needed.x = robots[i].pos.x + 1;
+        if (robots[i].pos.y >= needed.y)
+            needed.y = robots[i].pos.y + 1;
+    }
+    for (size_t i = 0; i < sizeof(ROOM_SIZES) / sizeof(ROOM_SIZES[0]); i++)
+        if (needed.x <= ROOM_SIZES[i].x && needed.y <= ROOM_SIZES[i].y)
+            return ROOM_SIZES[i];
+    return needed;
+}
+
 // For debugging: print the array of robots
 void print_robots(Robot *robots, size_t robots_size)
 {
@@ -97,61 +167,76 @@ void print_robots(Robot *robots, size_t robots_size)
 /// @param robots_size The number of robots in the array
 /// @param iterations The number of iterations to try
 /// @param triangle_size The minimum height of a triangle that will be considered valid
-void find_tree(Robot *robots, size_t robots_size, int iterations, int triangle_size)
+/// @param print_candidates If true, print every candidate. If false, stop at the first candidate
+/// @param width The width of the room, which is a constant in the copies for DIM_SIZES
+/// @param height The height of the room
+/// @return The number of seconds until the first candidate, or -1 if there is no candidate
+static DIMS_INLINE int find_tree_impl(Robot *robots, size_t robots_size, int iterations, int triangle_size, bool print_candidates,
+                                      int width, int height)
 {
-    short map[MAP_HEIGHT][MAP_WIDTH];
+    int first_candidate = -1;
+    // The number of robots on each tile, row by row
+    short *map = calloc((size_t)width * height, sizeof(map[0]));
 
     // Fill the map initially
     for (size_t i = 0; i < robots_size; i++)
-        map[robots[i].pos.y][robots[i].pos.x]++;
+        map[robots[i].pos.y * width + robots[i].pos.x]++;
 
     for (int i = 0; i < iterations; i++)
     {
-        if (has_triangle(map, triangle_size))
+        if (has_triangle(map, triangle_size, width, height))
         {
+            if (first_candidate == -1)
+                first_candidate = i;
+            if (!print_candidates)
+                break;
             printf("\nSeconds: %d\n", i);
-            print_map(map);
+            print_map(map, width, height);
         }
 
         for (size_t j = 0; j < robots_size; j++)
         {
             // Remove robot from old location
-            map[robots[j].pos.y][robots[j].pos.x]--;
+            map[robots[j].pos.y * width + robots[j].pos.x]--;
             // Move robot to new location
-            robots[j].pos = get_destination(robots[j]);
-            map[robots[j].pos.y][robots[j].pos.x]++;
+            robots[j].pos = get_destination(robots[j], width, height);
+            map[robots[j].pos.y * width + robots[j].pos.x]++;
         }
     }
+    free(map);
+    return first_candidate;
 }
 
 /// @brief Get the destination of the robot after one second
 /// @param robot
+/// @param width The width of the room
+/// @param height The height of the room
 /// @return The destination of the robot
-Point get_destination(Robot robot)
+static DIMS_INLINE Point get_destination(Robot robot, int width, int height)
 {
     return (Point){
-        ((robot.vel.x + robot.pos.x) % MAP_WIDTH + MAP_WIDTH) % MAP_WIDTH,
-        ((robot.vel.y + robot.pos.y) % MAP_HEIGHT + MAP_HEIGHT) % MAP_HEIGHT,
+        ((robot.vel.x + robot.pos.x) % width + width) % width,
+        ((robot.vel.y + robot.pos.y) % height + height) % height,
     };
 }
 
-void print_map(short map[MAP_HEIGHT][MAP_WIDTH])
+void print_map(short *map, int width, int height)
 {
-    for (int i = 0; i < MAP_HEIGHT; i++)
+    for (int i = 0; i < height; i++)
     {
-        for (int j = 0; j < MAP_WIDTH; j++)
-            putchar(map[i][j] ? '@' : ' ');
+        for (int j = 0; j < width; j++)
+            putchar(map[i * width + j] ? '@' : ' ');
         putchar('\n');
     }
 }
 
-int has_triangle(short map[MAP_HEIGHT][MAP_WIDTH], int triangle_size)
+static DIMS_INLINE int has_triangle(short *map, int triangle_size, int width, int height)
 {
     // Loop over every row
-    for (int i = 0; i < MAP_HEIGHT - triangle_size; i++)
+    for (int i = 0; i < height - triangle_size; i++)
     {
         // Loop over every column within the row for triangle tops
-        for (int j = triangle_size; j < MAP_WIDTH - triangle_size; j++)
+        for (int j = triangle_size; j < width - triangle_size; j++)
         {
             // Loop over the rows in the triangle
             for (int k = 0; k < triangle_size; k++)
@@ -160,7 +245,7 @@ int has_triangle(short map[MAP_HEIGHT][MAP_WIDTH], int triangle_size)
                 for (int l = j - k; l <= j + k; l++)
                 {
                     // If anything in the next triangle does not have a robot where it should be, check the next tip in the second loop (over j)
-                    if (!map[i + k][l])
+                    if (!map[(i + k) * width + l])
                         goto CHECK_NEXT_TRIANGLE;
                 }
             }
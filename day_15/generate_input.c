@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// Roughly 1 in WALL_RARITY inside tiles is a wall and 1 in BOX_RARITY is a box
+#define WALL_RARITY 20
+#define BOX_RARITY 3
+// The real input has 8 moves for every tile
+#define MOVES_PER_TILE 8
+#define MOVES_LINE_LENGTH 1000
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 50, 3, 65536, "The number of rows and columns, including the outer walls");
+    if (size == -1)
+        return 1;
+
+    long long robot_row = random_range(1, size - 2);
+    long long robot_col = random_range(1, size - 2);
+    for (long long row = 0; row < size; row++)
+    {
+        for (long long col = 0; col < size; col++)
+        {
+            if (row == 0 || row == size - 1 || col == 0 || col == size - 1)
+                putchar('#');
+            else if (row == robot_row && col == robot_col)
+                putchar('@');
+            else if (random_range(1, WALL_RARITY) == 1)
+                putchar('#');
+            else if (random_range(1, BOX_RARITY) == 1)
+                putchar('O');
+            else
+                putchar('.');
+        }
+        putchar('\n');
+    }
+    putchar('\n');
+
+    long long moves = MOVES_PER_TILE * size * size;
+    for (long long i = 0; i < moves; i++)
+    {
+        putchar("^>v<"[next_random() & 3]);
+        if ((i + 1) % MOVES_LINE_LENGTH == 0 || i + 1 == moves)
+            putchar('\n');
+    }
+
+    return 0;
+}
@@ -3,127 +3,136 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/grid.h"
 
-typedef char *string;
 DEF_VEC(char)
-DEF_VEC(string)
-void delete_string_vec(string_Vec *vec)
-{
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
-    free(vec->arr);
-    vec->arr = NULL;
-    vec->len = 0UL;
-    vec->cap = 0UL;
-}
 
-typedef struct Point
+// The parsed input for the runner
+typedef struct Puzzle
 {
-    short row;
-    short col;
-} Point;
+    // The moves point into the input
+    Input input;
+    Grid map;
+    char_Vec moves;
+    // The index of the robot in the map
+    int robot;
+} Puzzle;
 
-int parse_input(char *input_file, string_Vec *map, char_Vec *moves, Point *robot);
-void print_map(char **map, size_t map_size, Point robot);
-long long get_gps_sum(char **map, size_t map_size, char *moves, Point *robot);
+int parse_input(char *input_file, Input *input, Grid *map, char_Vec *moves, int *robot);
+void print_map(Grid map, int robot);
+long long get_gps_sum(Grid map, char *moves, int *robot);
 int get_gps(int row, int col);
-int try_move(char **map, size_t map_size, int row, int col, char direction);
+int try_move(Grid map, int index, GridDirection direction);
+
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
-    string_Vec map;
+    Input input;
+    Grid map;
     char_Vec moves;
-    Point robot;
+    int robot;
     char *input_file = (argc >= 2) ? argv[1] : NULL;
-    if (parse_input(input_file, &map, &moves, &robot))
+    if (parse_input(input_file, &input, &map, &moves, &robot))
         return 1;
 
-    long long gps_sum = get_gps_sum(map.arr, map.len, moves.arr, &robot);
+    long long gps_sum = get_gps_sum(map, moves.arr, &robot);
 
-    print_map(map.arr, map.len, robot);
+    print_map(map, robot);
     for (size_t i = 0; moves.arr[i]; i++)
     {
         if (!(i % 70))
             putchar('\n');
         putchar(moves.arr[i]);
     }
-    printf("\n\nRobot: (%hd,%hd)\n\n", robot.row, robot.col);
+    printf("\n\nRobot: (%d,%d)\n\n", grid_row(map, robot), grid_col(map, robot));
     printf("Sum of GPS's: %lld\n", gps_sum);
 
-    delete_string_vec(&map);
-    free(moves.arr);
+    delete_grid(&map);
+    close_input(&input);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->input, &puzzle->map, &puzzle->moves, &puzzle->robot))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", get_gps_sum(p->map, p->moves.arr, &p->robot));
     return 0;
 }
 
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    delete_grid(&p->map);
+    close_input(&p->input);
+    free(p);
+}
+
+DEF_SOLVER(15, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 // Print the map to stdout
-void print_map(char **map, size_t map_size, Point robot)
+void print_map(Grid map, int robot)
 {
-    map[robot.row][robot.col] = '@';
-    for (size_t i = 0; i < map_size; i++)
-        puts(map[i]);
-    map[robot.row][robot.col] = '.';
+    map.cells[robot] = '@';
+    print_grid(map);
+    map.cells[robot] = '.';
 }
 
 /// @brief Parse the input file into the map, moves, and the robot location
 /// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param input Out: The input, which must be closed after the moves are no longer used
 /// @param map Out: The map that the robot is in
 /// @param moves Out: All of the moves that will be taken by the robot
-/// @param robot Out: The location of the robot
+/// @param robot Out: The index of the robot in the map
 /// @return 0 if successful, 1 if unsuccessful
-int parse_input(char *input_file, string_Vec *map, char_Vec *moves, Point *robot)
+int parse_input(char *input_file, Input *input, Grid *map, char_Vec *moves, int *robot)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    if (open_input(input_file, input))
         return 1;
-    }
-    *map = new_string_Vec();
-    *moves = new_char_Vec();
 
-    // Used to detect double newline, which indicates the start of the next section
-    int last_char = 0;
-    int ch;
-    char_Vec row = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
+    Span span = input_span(input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        if (ch != '\n')
-        {
-            // If robot, note its position and set the space to empty
-            if (ch == '@')
-            {
-                robot->row = map->len;
-                robot->col = row.len;
-                append_char_Vec(&row, '.');
-            }
-            else
-                append_char_Vec(&row, ch);
-        }
-        // Put the new line only if the double newline has not been reached
-        else if (last_char != '\n')
-        {
-            append_char_Vec(&row, '\0');
-            append_string_Vec(map, row.arr);
-            // Generate a new char vector for the next iteration
-            // Slight optimization: start with a capacity of this array's length
-            row.arr = malloc(sizeof(row.arr[0]) * row.len);
-            row.cap = row.len;
-            row.len = 0UL;
-        }
-        else
-            break;
-        last_char = ch;
+        fprintf(stderr, "Expected a rectangular map\n");
+        close_input(input);
+        return 1;
     }
 
-    free(row.arr);
+    // Past the edge of the map is a wall, so moves never need to check the edges
+    *map = grid_from_view(grid, 1, '#');
 
-    // Put the rest of the file in the moves vector
-    while ((ch = getc(f)) != EOF)
-        if (ch != '\n')
-            append_char_Vec(moves, ch);
-    append_char_Vec(moves, '\0');
+    // Note the robot's position and set its space to empty
+    for (int row = 0; row < map->rows; row++)
+        for (int col = 0; col < map->cols; col++)
+            if (GRID_CELL(*map, row, col) == '@')
+            {
+                *robot = GRID_INDEX(*map, row, col);
+                GRID_CELL(*map, row, col) = '.';
+            }
 
+    // The moves are the rest of the input. Remove the newlines in place to make them one null-terminated string
+    char *moves_end = span.start;
+    for (char *ch = span.start; ch < span.end; ch++)
+        if (*ch != '\n')
+            *moves_end++ = *ch;
+    *moves_end = '\0';
+    *moves = (char_Vec){span.start, moves_end - span.start, moves_end - span.start};
     return 0;
 }
 
@@ -136,57 +145,35 @@ int get_gps(int row, int col)
 
 /// @brief Get the sum of the gps's of the boxes after moving the robot
 /// @param map The map
-/// @param map_size The number of rows in `map`
 /// @param moves Null-terminated list of moves
-/// @param robot The location of the robot. This is passed by reference so the caller can know it's destination.
+/// @param robot The index of the robot. This is passed by reference so the caller can know it's destination.
 /// @return The sum of the GPS's of the boxes destinations
-long long get_gps_sum(char **map, size_t map_size, char *moves, Point *robot)
+long long get_gps_sum(Grid map, char *moves, int *robot)
 {
     long long gps_sum = 0LL;
     // Do moves
     // Loop over the array of moves
     while (*moves)
     {
-        // Figure out where the robot "wants" to go and ensure that isn't off the map
+        // Figure out where the robot "wants" to go
         char move = *moves;
-        Point destination = *robot;
-        switch (move)
+        int direction = grid_direction(move);
+        if (direction < 0)
         {
-        case '>':
-            // Right
-            // Ensure this move is not off the map
-            if (!map[destination.row][++destination.col])
-                goto NEXT;
-            break;
-        case '^':
-            // Up
-            if (--destination.row < 0)
-                goto NEXT;
-            break;
-        case '<':
-            // Left
-            if (--destination.col < 0)
-                goto NEXT;
-            break;
-        case 'v':
-            // Down
-            if (++destination.row >= map_size)
-                goto NEXT;
-            break;
-        default:
             // Something is wrong, so end the function early
             fprintf(stderr, "Unexpected move: '%c'\n", move);
             return -1;
         }
+        int destination = *robot + map.step[direction];
 
         // Determine what's there and act accordingly
-        switch (map[destination.row][destination.col])
+        switch (map.cells[destination])
         {
         case 'O':
             // Box
-            if (try_move(map, map_size, destination.row, destination.col, move))
+            if (try_move(map, destination, direction))
                 // Put an empty space where the box was because we don't keep track of robot on the map
-                map[destination.row][destination.col] = '.';
+                map.cells[destination] = '.';
             else
                 break;
             // If the move was possible, fallthrough
@@ -195,26 +182,25 @@ long long get_gps_sum(char **map, size_t map_size, char *moves, Point *robot)
             *robot = destination;
             break;
         case '#':
-            // Wall: do nothing
+            // Wall (or the edge of the map): do nothing
             break;
         default:
             fprintf(stderr, "Unexpected object: '%c'\n", move);
             return -1;
         }
 
-    NEXT:
         // Go to the next move
         moves++;
     }
 
     // Find gps sum by finding every box
     // Loop over rows
-    for (int i = 0; i < map_size; i++)
+    for (int i = 0; i < map.rows; i++)
     {
         // Loop over columns
-        for (int j = 0; map[i][j]; j++)
+        for (int j = 0; j < map.cols; j++)
         {
-            if (map[i][j] == 'O')
+            if (GRID_CELL(map, i, j) == 'O')
                 gps_sum += get_gps(i, j);
         }
     }
@@ -223,61 +209,31 @@ long long get_gps_sum(char **map, size_t map_size, char *moves, Point *robot)
 
 /// @brief Try to move the box (represented by O) in the given direction. Fails if this action would push a box into a wall.
 /// @param map The map
-/// @param map_size The number of rows in the map
-/// @param row The row of the box to move
-/// @param col The column of the box to move
-/// @param direction The direction, represented by one of [>^<v], in which to move the box
+/// @param index The index of the box to move
+/// @param direction The direction in which to move the box
 /// @return 1 if box is successfully moved, 0 if a wall was hit
-int try_move(char **map, size_t map_size, int row, int col, char direction)
+int try_move(Grid map, int index, GridDirection direction)
 {
-    Point destination = {.row = row, .col = col};
-    switch (direction)
-    {
-    case '>':
-        // Right
-        // Ensure this move is not off the map
-        if (!map[destination.row][++destination.col])
-            return 0;
-        break;
-    case '^':
-        // Up
-        if (--destination.row < 0)
-            return 0;
-        break;
-    case '<':
-        // Left
-        if (--destination.col < 0)
-            return 0;
-        break;
-    case 'v':
-        // Down
-        if (++destination.row >= map_size)
-            return 0;
-        break;
-    default:
-        // Something is wrong, so end the function early
-        fprintf(stderr, "Unexpected move: '%c'\n", direction);
-        return -1;
-    }
+    int destination = index + map.step[direction];
 
     // Determine what's there and act accordingly
-    switch (map[destination.row][destination.col])
+    switch (map.cells[destination])
     {
     case 'O':
         // Box
-        return try_move(map, map_size, destination.row, destination.col, direction);
+        return try_move(map, destination, direction);
         break;
     case '.':
         // Empty space
-        map[destination.row][destination.col] = 'O';
+        map.cells[destination] = 'O';
         return 1;
         break;
     case '#':
-        // Wall: do nothing
+        // Wall (or the edge of the map): do nothing
         return 0;
         break;
     default:
-        fprintf(stderr, "Unexpected object: '%c'\n", map[destination.row][destination.col]);
+        fprintf(stderr, "Unexpected object: '%c'\n", map.cells[destination]);
         return -1;
     }
 }
@@ -3,146 +3,159 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/grid.h"
 
-typedef char *string;
 DEF_VEC(char)
-DEF_VEC(string)
-void delete_string_vec(string_Vec *vec)
-{
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
-    free(vec->arr);
-    vec->arr = NULL;
-    vec->len = 0UL;
-    vec->cap = 0UL;
-}
-
-typedef struct Point
-{
-    short row;
-    short col;
-} Point;
 
-// Stores information about a move of some item from `source` to `destination`
+// Stores information about a move of some item from `source` to `destination`, which are indices into the map
 typedef struct Move
 {
-    Point source;
-    Point destination;
+    int source;
+    int destination;
 } Move;
 
 DEF_VEC(Move)
 
-int parse_input(char *input_file, string_Vec *map, char_Vec *moves, Point *robot);
-void print_map(char **map, size_t map_size, Point robot);
-long long get_gps_sum(char **map, size_t map_size, char *moves, Point *robot);
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    // The moves point into the input
+    Input input;
+    Grid map;
+    char_Vec moves;
+    // The index of the robot in the map
+    int robot;
+} Puzzle;
+
+int parse_input(char *input_file, Input *input, Grid *map, char_Vec *moves, int *robot);
+void print_map(Grid map, int robot);
+long long get_gps_sum(Grid map, char *moves, int *robot);
 int get_gps(int row, int col);
-int is_move_possible(char **map, size_t map_size, int row, int col, char direction);
-void do_moves(char **map, int row, int col, char direction);
+int is_move_possible(Grid map, int index, GridDirection direction);
+void do_moves(Grid map, int index, GridDirection direction);
+
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
-    string_Vec map;
+    Input input;
+    Grid map;
     char_Vec moves;
-    Point robot;
+    int robot;
     char *input_file = (argc >= 2) ? argv[1] : NULL;
-    if (parse_input(input_file, &map, &moves, &robot))
+    if (parse_input(input_file, &input, &map, &moves, &robot))
         return 1;
 
-    long long gps_sum = get_gps_sum(map.arr, map.len, moves.arr, &robot);
+    long long gps_sum = get_gps_sum(map, moves.arr, &robot);
 
-    print_map(map.arr, map.len, robot);
+    print_map(map, robot);
     for (size_t i = 0; moves.arr[i]; i++)
     {
         if (!(i % 70))
             putchar('\n');
         putchar(moves.arr[i]);
     }
-    printf("\n\nRobot: (%hd,%hd)\n\n", robot.row, robot.col);
+    printf("\n\nRobot: (%d,%d)\n\n", grid_row(map, robot), grid_col(map, robot));
     printf("Sum of GPS's: %lld\n", gps_sum);
 
-    delete_string_vec(&map);
-    free(moves.arr);
+    delete_grid(&map);
+    close_input(&input);
+    return 0;
+}
+
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->input, &puzzle->map, &puzzle->moves, &puzzle->robot))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", get_gps_sum(p->map, p->moves.arr, &p->robot));
     return 0;
 }
 
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    delete_grid(&p->map);
+    close_input(&p->input);
+    free(p);
+}
+
+DEF_SOLVER(15, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
 // Print the map to stdout
-void print_map(char **map, size_t map_size, Point robot)
+void print_map(Grid map, int robot)
 {
-    map[robot.row][robot.col] = '@';
-    for (size_t i = 0; i < map_size; i++)
-        puts(map[i]);
-    map[robot.row][robot.col] = '.';
+    map.cells[robot] = '@';
+    print_grid(map);
+    map.cells[robot] = '.';
 }
 
 /// @brief Parse the input file into the map, moves, and the robot location
 /// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param input Out: The input, which must be closed after the moves are no longer used
 /// @param map Out: The map that the robot is in
 /// @param moves Out: All of the moves that will be taken by the robot
-/// @param robot Out: The location of the robot
+/// @param robot Out: The index of the robot in the map
 /// @return 0 if successful, 1 if unsuccessful
-int parse_input(char *input_file, string_Vec *map, char_Vec *moves, Point *robot)
+int parse_input(char *input_file, Input *input, Grid *map, char_Vec *moves, int *robot)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
+    if (open_input(input_file, input))
+        return 1;
+
+    Span span = input_span(input);
+    GridView grid;
+    if (!next_grid(&span, &grid))
     {
-        perror("Error opening input file");
+        fprintf(stderr, "Expected a rectangular map\n");
+        close_input(input);
         return 1;
     }
-    *map = new_string_Vec();
-    *moves = new_char_Vec();
-
-    // Used to detect double newline, which indicates the start of the next section
-    int last_char = 0;
-    int ch;
-    char_Vec row = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
+
+    // Everything is twice as wide, so the map is copied into a new grid
+    // Past the edge of the map is a wall, so moves never need to check the edges
+    *map = new_grid(grid.rows, 2 * grid.cols, 1, '.', '#');
+    for (size_t row = 0; row < grid.rows; row++)
     {
-        if (ch != '\n')
+        for (size_t col = 0; col < grid.cols; col++)
         {
+            char ch = GRID_AT(grid, row, col);
+            char *tiles = &GRID_CELL(*map, row, 2 * col);
             // If robot, note its position and set the space to empty
             if (ch == '@')
             {
-                robot->row = map->len;
-                robot->col = row.len;
-                append_char_Vec(&row, '.');
-                append_char_Vec(&row, '.');
+                *robot = GRID_INDEX(*map, row, 2 * col);
+                tiles[0] = tiles[1] = '.';
             }
             else if (ch == 'O')
             {
-                append_char_Vec(&row, '[');
-                append_char_Vec(&row, ']');
+                tiles[0] = '[';
+                tiles[1] = ']';
             }
             else
-            {
-                append_char_Vec(&row, ch);
-                append_char_Vec(&row, ch);
-            }
-        }
-        // Put the new line only if the double newline has not been reached
-        else if (last_char != '\n')
-        {
-            append_char_Vec(&row, '\0');
-            append_string_Vec(map, row.arr);
-            // Generate a new char vector for the next iteration
-            // Slight optimization: start with a capacity of this array's length
-            row.arr = malloc(sizeof(row.arr[0]) * row.len);
-            row.cap = row.len;
-            row.len = 0UL;
+                tiles[0] = tiles[1] = ch;
         }
-        else
-            break;
-        last_char = ch;
     }
 
-    free(row.arr);
-
-    // Put the rest of the file in the moves vector
-    while ((ch = getc(f)) != EOF)
-        if (ch != '\n')
-            append_char_Vec(moves, ch);
-    append_char_Vec(moves, '\0');
-
+    // The moves are the rest of the input. Remove the newlines in place to make them one null-terminated string
+    char *moves_end = span.start;
+    for (char *ch = span.start; ch < span.end; ch++)
+        if (*ch != '\n')
+            *moves_end++ = *ch;
+    *moves_end = '\0';
+    *moves = (char_Vec){span.start, moves_end - span.start, moves_end - span.start};
     return 0;
 }
 
@@ -155,60 +168,38 @@ int get_gps(int row, int col)
 
 /// @brief Get the sum of the gps's of the boxes after moving the robot
 /// @param map The map
-/// @param map_size The number of rows in `map`
 /// @param moves Null-terminated list of moves
-/// @param robot The location of the robot. This is passed by reference so the caller can know it's destination.
+/// @param robot The index of the robot. This is passed by reference so the caller can know it's destination.
 /// @return The sum of the GPS's of the boxes destinations
-long long get_gps_sum(char **map, size_t map_size, char *moves, Point *robot)
+long long get_gps_sum(Grid map, char *moves, int *robot)
 {
     long long gps_sum = 0LL;
     // Do moves
     // Loop over the array of moves
     while (*moves)
     {
-        // Figure out where the robot "wants" to go and ensure that isn't off the map
+        // Figure out where the robot "wants" to go
         char move = *moves;
-        Point destination = *robot;
-        switch (move)
+        int direction = grid_direction(move);
+        if (direction < 0)
         {
-        case '>':
-            // Right
-            // Ensure this move is not off the map
-            if (!map[destination.row][++destination.col])
-                goto NEXT;
-            break;
-        case '^':
-            // Up
-            if (--destination.row < 0)
-                goto NEXT;
-            break;
-        case '<':
-            // Left
-            if (--destination.col < 0)
-                goto NEXT;
-            break;
-        case 'v':
-            // Down
-            if (++destination.row >= map_size)
-                goto NEXT;
-            break;
-        default:
             // Something is wrong, so end the function early
             fprintf(stderr, "Unexpected move: '%c'\n", move);
             return -1;
         }
+        int destination = *robot + map.step[direction];
 
         // Determine what's there and act accordingly
-        switch (map[destination.row][destination.col])
+        switch (map.cells[destination])
         {
         case '[':
         case ']':
             // Box
-            if (is_move_possible(map, map_size, destination.row, destination.col, move))
+            if (is_move_possible(map, destination, direction))
             {
                 // Perform the moves only if the entire transaction succeeds
                 // They are performed in reverse order because
-                do_moves(map, destination.row, destination.col, move);
+                do_moves(map, destination, direction);
             }
             else
                 break;
@@ -219,106 +210,73 @@ long long get_gps_sum(char **map, size_t map_size, char *moves, Point *robot)
             *robot = destination;
             break;
         case '#':
-            // Wall: do nothing
+            // Wall (or the edge of the map): do nothing
             break;
         default:
             fprintf(stderr, "Unexpected object: '%c'\n", move);
             return -1;
         }
 
-    NEXT:
         // Go to the next move
         moves++;
     }
 
     // Find gps sum by finding every box
     // Loop over rows
-    for (int i = 0; i < map_size; i++)
+    for (int i = 0; i < map.rows; i++)
     {
         // Loop over columns
-        for (int j = 0; map[i][j]; j++)
+        for (int j = 0; j < map.cols; j++)
         {
             // GPS goes by the left side of the box
-            if (map[i][j] == '[')
+            if (GRID_CELL(map, i, j) == '[')
                 gps_sum += get_gps(i, j);
         }
     }
     return gps_sum;
 }
 
-/// @brief Check if it's possible to move a box at `row`,`col` in a given direction but do not actually do it
+/// @brief Check if it's possible to move a box at `index` in a given direction but do not actually do it
 /// @param map The map
-/// @param map_size The number of rows in the map
-/// @param row The row of the box to move
-/// @param col The column of the box to move
-/// @param direction The direction, represented by one of [>^<v], in which to move the box
+/// @param index The index of the box to move
+/// @param direction The direction in which to move the box
 /// @return 1 if box is successfully moved, 0 if a wall was hit
-int is_move_possible(char **map, size_t map_size, int row, int col, char direction)
+int is_move_possible(Grid map, int index, GridDirection direction)
 {
     // Assume we are pushing the left
-    Point destination_left = {.row = row, .col = col};
+    int destination_left = index;
     // If we are instead pushing the right, change the left
-    if (map[row][col] == ']')
-        destination_left.col--;
-
-    switch (direction)
-    {
-    case '>':
-        // Right
-        // Ensure this move is not off the map
-        if (!map[destination_left.row][++destination_left.col + 1])
-            return 0;
-        break;
-    case '^':
-        // Up
-        if (--destination_left.row < 0)
-            return 0;
-        break;
-    case '<':
-        // Left
-        if (--destination_left.col < 0)
-            return 0;
-        break;
-    case 'v':
-        // Down
-        if (++destination_left.row >= map_size)
-            return 0;
-        break;
-    default:
-        // Something is wrong, so end the function early
-        fprintf(stderr, "Unexpected move: '%c'\n", direction);
-        return -1;
-    }
+    if (map.cells[index] == ']')
+        destination_left--;
+    destination_left += map.step[direction];
 
     // Find the right-side destination
-    Point destination_right;
-    destination_right.row = destination_left.row;
-    destination_right.col = destination_left.col + 1;
+    int destination_right = destination_left + 1;
 
     int success;
 
     // Only check the next of the left if we aren't moving right
     // This is done because we already know the right side is a box, which will be checked later
-    if (direction != '>')
+    if (direction != GRID_EAST)
     {
         // Determine what's there and act accordingly
-        switch (map[destination_left.row][destination_left.col])
+        switch (map.cells[destination_left])
         {
         case '[':
         case ']':
             // Box
-            success = is_move_possible(map, map_size, destination_left.row, destination_left.col, direction);
+            success = is_move_possible(map, destination_left, direction);
             break;
         case '.':
             // Empty space
             success = 1;
             break;
         case '#':
-            // Wall: do nothing
+            // Wall (or the edge of the map): do nothing
             success = 0;
             break;
         default:
-            fprintf(stderr, "Unexpected object: '%c'\n", map[destination_left.row][destination_left.col]);
+            fprintf(stderr, "Unexpected object: '%c'\n", map.cells[destination_left]);
             return -1;
         }
     }
@@ -328,26 +286,26 @@ int is_move_possible(char **map, size_t map_size, int row, int col, char directi
 
     // If the previous was successful and the direction is not left, check the right side
     // Same reason as not checking the left if we are moving right
-    if (success && (direction != '<'))
+    if (success && (direction != GRID_WEST))
     {
         // Determine what's there and act accordingly
-        switch (map[destination_right.row][destination_right.col])
+        switch (map.cells[destination_right])
         {
         case '[':
         case ']':
             // Box
-            success = is_move_possible(map, map_size, destination_right.row, destination_right.col, direction);
+            success = is_move_possible(map, destination_right, direction);
             break;
         case '.':
             // Empty space
             success = 1;
             break;
         case '#':
-            // Wall: do nothing
+            // Wall (or the edge of the map): do nothing
             success = 0;
             break;
         default:
-            fprintf(stderr, "Unexpected object: '%c'\n", map[destination_right.row][destination_right.col]);
+            fprintf(stderr, "Unexpected object: '%c'\n", map.cells[destination_right]);
             return -1;
         }
     }
@@ -359,81 +317,52 @@ int is_move_possible(char **map, size_t map_size, int row, int col, char directi
 ///
 /// Assumes the move is actually possible and ignores map boundaries and walls
 /// @param map The map
-/// @param row The row of the box to move
-/// @param col The column of the box to move
+/// @param index The index of the box to move
 /// @param direction The direction to move
-void do_moves(char **map, int row, int col, char direction)
+void do_moves(Grid map, int index, GridDirection direction)
 {
     // Don't try to move empty space
-    if (map[row][col] == '.')
+    if (map.cells[index] == '.')
         return;
-    Point this_left, this_right;
-    this_right.row = this_left.row = row;
-    if (map[row][col] == '[')
+    int this_left, this_right;
+    if (map.cells[index] == '[')
     {
-        this_left.col = col;
-        this_right.col = col + 1;
+        this_left = index;
+        this_right = index + 1;
     }
-    else if (map[row][col] == ']')
+    else if (map.cells[index] == ']')
     {
-        this_left.col = col - 1;
-        this_right.col = col;
+        this_left = index - 1;
+        this_right = index;
     }
     else
     {
         // Panic if the box is not a box
-        fprintf(stderr, "do_moves(): Unexpected box type: '%c'\n", map[row][col]);
-        exit(1);
-    }
-
-    Point destination_left = this_left;
-    switch (direction)
-    {
-    case '>':
-        // Right
-        // Ensure this move is not off the map
-        destination_left.col++;
-        break;
-    case '^':
-        // Up
-        destination_left.row--;
-        break;
-    case '<':
-        // Left
-        destination_left.col--;
-        break;
-    case 'v':
-        // Down
-        destination_left.row++;
-        break;
-    default:
-        // Something is wrong, so end the function early
-        fprintf(stderr, "Unexpected move: '%c'\n", direction);
+        fprintf(stderr, "do_moves(): Unexpected box type: '%c'\n", map.cells[index]);
         exit(1);
     }
 
-    Point destination_right;
-    destination_right.row = destination_left.row;
-    destination_right.col = destination_left.col + 1;
+    int destination_left = this_left + map.step[direction];
+    int destination_right = destination_left + 1;
 
-    if (direction != '>')
+    if (direction != GRID_EAST)
         // Unless we are moving right, move whatever is in the destination of the left out of the way
         // If we are moving right, that's the box itself, which will be handled later
-        do_moves(map, destination_left.row, destination_left.col, direction);
-    if (direction != '<')
+        do_moves(map, destination_left, direction);
+    if (direction != GRID_WEST)
         // Unless we are moving left, move everything out of the way of the right
         // Same reason for excluding leftward as above
-        do_moves(map, destination_right.row, destination_right.col, direction);
+        do_moves(map, destination_right, direction);
 
     // Do this move now that other boxes are moved
-    map[destination_left.row][destination_left.col] = '[';
-    map[destination_right.row][destination_right.col] = ']';
+    map.cells[destination_left] = '[';
+    map.cells[destination_right] = ']';
 
-    if (direction != '<')
+    if (direction != GRID_WEST)
         // Only clear this left side if we are not moving left
         // If we are moving left, this has already been overwritten by the right
-        map[this_left.row][this_left.col] = '.';
-    if (direction != '>')
+        map.cells[this_left] = '.';
+    if (direction != GRID_EAST)
         // Only clear the right side if we are not moving right for the same reason
-        map[this_right.row][this_right.col] = '.';
+        map.cells[this_right] = '.';
 }
@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// Roughly 1 in LOOP_RARITY inside walls is removed so there is more than one best path
+#define LOOP_RARITY 10
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 141, 5, 65535, "The number of rows and columns. Even sizes are rounded down");
+    if (size == -1)
+        return 1;
+    if (!(size & 1))
+        size--;
+
+    // Start in the bottom left and end in the top right like the real input
+    long long start = (size - 2) * size + 1;
+    long long end = size + size - 2;
+    char *map = malloc(size * size);
+    generate_maze(map, size, start, NULL);
+
+    // Only remove walls between 2 open tiles in a line
+    for (long long row = 1; row < size - 1; row++)
+        for (long long col = 1; col < size - 1; col++)
+            if (map[row * size + col] == '#' && random_range(1, LOOP_RARITY) == 1 &&
+                ((map[(row - 1) * size + col] == '.' && map[(row + 1) * size + col] == '.' && map[row * size + col - 1] == '#' && map[row * size + col + 1] == '#') ||
+                 (map[row * size + col - 1] == '.' && map[row * size + col + 1] == '.' && map[(row - 1) * size + col] == '#' && map[(row + 1) * size + col] == '#')))
+                map[row * size + col] = '.';
+
+    map[start] = 'S';
+    map[end] = 'E';
+    for (long long row = 0; row < size; row++)
+    {
+        fwrite(map + row * size, 1, size, stdout);
+        putchar('\n');
+    }
+
+    free(map);
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include <stdbool.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/priority_queue.h"
 
 #define MOVE_COST 1
 #define TURN_COST 1000
@@ -57,12 +58,7 @@ typedef struct MazeMove
     MoveType move_type;
 } MazeMove;
 
-typedef struct MazeMoveHeap
-{
-    MazeMove *arr;
-    int len;
-    int cap;
-} MazeMoveHeap;
+DEF_PQ(MazeMove, score)
 
 typedef struct MazeMoveMapElement
 {
@@ -84,13 +80,6 @@ int check_is_found(char *found_map, int map_size, int map_row_size, int row, int
 void mark_found(char *found_map, int map_size, int map_row_size, int row, int col, Direction direction);
 void mark_final_paths(char **map, size_t map_size, size_t map_row_size, MazeMoveMapElement *maze_move_map, Point start, Point end, Direction end_direction);
 
-// Priority queue stuff
-void resize_pq(MazeMoveHeap *heap, int new_cap);
-void push_pq(MazeMoveHeap *heap, MazeMove val);
-void pop_pq(MazeMoveHeap *heap);
-void sift_down_pq(MazeMoveHeap *heap, int parent_index);
-MazeMove peek_pq(MazeMoveHeap heap);
-
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -213,7 +202,7 @@ int get_min_score_paths(char **map, size_t map_size, Point start, Point end)
     size_t map_row_size = map_size ? strlen(map[0]) : 0;
     // A map of what elements we have already found, all zeroed because nothing has been found yet
     char *found_map = calloc(map_size * map_row_size, sizeof(found_map[0]));
-    MazeMoveHeap heap = {.arr = NULL, .len = 0, .cap = 0};
+    MazeMove_BucketPQ queue = new_MazeMove_BucketPQ(TURN_COST);
 
     MazeMoveMapElement *maze_move_map = calloc(map_size * map_row_size * 4, sizeof(maze_move_map[0]));
 
@@ -262,23 +251,23 @@ int get_min_score_paths(char **map, size_t map_size, Point start, Point end)
             }
 
             if (valid_point && (map[next_point.row][next_point.col] == '.') && !check_is_found(found_map, map_size, map_row_size, next_point.row, next_point.col, this_move.dir))
-                push_pq(&heap, (MazeMove){.score = this_move.score + MOVE_COST, .row = next_point.row, .col = next_point.col, .dir = this_move.dir, .move_type = FORWARD_MV});
+                push_MazeMove_BucketPQ(&queue, (MazeMove){.score = this_move.score + MOVE_COST, .row = next_point.row, .col = next_point.col, .dir = this_move.dir, .move_type = FORWARD_MV});
         }
 
-        // Add turn left and right to the heap with some modulo arithmetic
+        // Add turn left and right to the queue with some modulo arithmetic
         // Left
         Direction next_dir = (this_move.dir + 1) & 0b11;
         if (!check_is_found(found_map, map_size, map_row_size, this_move.row, this_move.col, next_dir))
-            push_pq(&heap, (MazeMove){.score = this_move.score + TURN_COST, .row = this_move.row, .col = this_move.col, .dir = next_dir, .move_type = LEFT_TURN});
+            push_MazeMove_BucketPQ(&queue, (MazeMove){.score = this_move.score + TURN_COST, .row = this_move.row, .col = this_move.col, .dir = next_dir, .move_type = LEFT_TURN});
 
         // Right
         next_dir = (this_move.dir - 1) & 0b11;
         if (!check_is_found(found_map, map_size, map_row_size, this_move.row, this_move.col, next_dir))
-            push_pq(&heap, (MazeMove){.score = this_move.score + TURN_COST, .row = this_move.row, .col = this_move.col, .dir = next_dir, .move_type = RIGHT_TURN});
+            push_MazeMove_BucketPQ(&queue, (MazeMove){.score = this_move.score + TURN_COST, .row = this_move.row, .col = this_move.col, .dir = next_dir, .move_type = RIGHT_TURN});
 
         // Finally get the cheapest next move
-        this_move = peek_pq(heap);
-        pop_pq(&heap);
+        if (!pop_MazeMove_BucketPQ(&queue, &this_move))
+            break;
 
         if (this_move.row == end.row && this_move.col == end.col && this_move.score < min_score)
             min_score = this_move.score;
@@ -294,7 +283,7 @@ int get_min_score_paths(char **map, size_t map_size, Point start, Point end)
             if (map[i][j] == 'O')
                 tile_count++;
 CLEANUP:
-    free(heap.arr);
+    delete_MazeMove_BucketPQ(&queue);
     free(found_map);
     free(maze_move_map);
     return tile_count;
@@ -326,109 +315,6 @@ int check_is_found(char *found_map, int map_size, int map_row_size, int row, int
     return IDX_2D(found_map, row, col) & (1 << direction);
 }
 
-/// @brief Resize a heap
-/// @param heap The heap
-/// @param new_cap The new capacity
-void resize_pq(MazeMoveHeap *heap, int new_cap)
-{
-    heap->arr = realloc(heap->arr, sizeof(heap->arr[0]) * new_cap);
-    heap->cap = new_cap;
-}
-
-/// @brief Push a value onto the heap
-/// @param heap The heap
-/// @param val The new value
-void push_pq(MazeMoveHeap *heap, MazeMove val)
-{
-    /* From Wikipedia https://en.wikipedia.org/wiki/Binary_heap Heap operations
-       1. Add the element to the bottom level of the heap at the leftmost open space.
-       2. Compare the added element with its parent; if they are in the correct order, stop.
-       3. If not, swap the element with its parent and return to the previous step.
-    */
-    int this_element = heap->len;
-    int parent = (this_element - 1) / 2;
-
-    // Double capacity if necessary
-    if (heap->len + 1 > heap->cap)
-        resize_pq(heap, heap->cap ? heap->cap * 2 : 1);
-
-    // Add the element to the bottom level of the heap at the leftmost open space.
-    heap->arr[heap->len++] = val;
-
-    // Compare the added element with its parent; if they are in the correct order, stop.
-    // `&& thisElement` to stop when thisElement is root
-    while ((heap->arr[this_element].score < heap->arr[parent].score) && this_element)
-    {
-        // If not, swap the element with its parent and return to the previous step.
-        MazeMove temp = heap->arr[this_element];
-        heap->arr[this_element] = heap->arr[parent];
-        heap->arr[parent] = temp;
-
-        // For previous step
-        this_element = parent;
-        parent = (this_element - 1) / 2;
-    }
-}
-
-/// @brief Pop the top value off of the heap
-/// @param heap The heap
-void pop_pq(MazeMoveHeap *heap)
-{
-    MazeMove new_root = heap->arr[--(heap->len)];
-    heap->arr[0] = new_root;
-    sift_down_pq(heap, 0);
-}
-
-/// @brief Sift down operation on heap
-/// @param heap The heap
-/// @param index The index of the parent element to sift down
-void sift_down_pq(MazeMoveHeap *heap, int parent_index)
-{
-    int left = (parent_index * 2) + 1;
-    int right = left + 1;
-    int parent_val = heap->arr[parent_index].score;
-    int min_val = parent_val;
-    int min_index = parent_index;
-
-    // Check if left is min
-    if (left < heap->len)
-    {
-        int left_val = heap->arr[left].score;
-        if (left_val < min_val)
-        {
-            min_index = left;
-            min_val = left_val;
-        }
-    }
-
-    // Check if right is min
-    if (right < heap->len)
-    {
-        int right_val = heap->arr[right].score;
-        if (right_val < min_val)
-        {
-            min_index = right;
-            min_val = right_val;
-        }
-    }
-
-    // Check if parent is still min
-    if (min_index != parent_index)
-    {
-        // Swap
-        MazeMove temp = heap->arr[parent_index];
-        heap->arr[parent_index] = heap->arr[min_index];
-        heap->arr[min_index] = temp;
-        sift_down_pq(heap, min_index);
-    }
-}
-
-// Peek at the top of the heap
-MazeMove peek_pq(MazeMoveHeap heap)
-{
-    return heap.arr[0];
-}
-
 void mark_final_paths(char **map, size_t map_size, size_t map_row_size, MazeMoveMapElement *maze_move_map, Point start, Point end, Direction end_direction)
 {
     map[end.row][end.col] = 'O';
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+#define PROGRAM_SIZE 16
+
+long long find_quine_ra(int *program, int digit_index, long long previous_digits);
+
+int main(int argc, char *argv[])
+{
+    long long digits = parse_generator_args(argc, argv, 16, 1, 21, "The number of octal digits in register A, which is the number of outputs");
+    if (digits == -1)
+        return 1;
+
+    // Register A with exactly `digits` octal digits
+    long long ra = random_range(1, 7);
+    for (long long i = 1; i < digits; i++)
+        ra = (ra << 3) | random_range(0, 7);
+
+    // Every real input is this loop with different constants:
+    // bst A, bxl a, cdv B, bxl b, bxc, out B, adv 3, jnz 0
+    // Part 2 needs some register A that makes the program output itself, which not every pair of constants has
+    int program[PROGRAM_SIZE] = {2, 4, 1, 0, 7, 5, 1, 0, 4, 0, 5, 5, 0, 3, 3, 0};
+    do
+    {
+        program[3] = random_range(0, 7);
+        program[7] = random_range(0, 7);
+        program[9] = random_range(0, 7);
+    } while (find_quine_ra(program, PROGRAM_SIZE - 1, 0) == -1);
+
+    printf("Register A: %lld\nRegister B: 0\nRegister C: 0\n\nProgram: %d", ra, program[0]);
+    for (int i = 1; i < PROGRAM_SIZE; i++)
+        printf(",%d", program[i]);
+    printf("\n");
+
+    return 0;
+}
+
+/// @brief Find the register A that makes the program output itself, one octal digit at a time from the last output
+/// @param program The program, which must be in the form above
+/// @param digit_index The index of the output to match next
+/// @param previous_digits The digits of A that already match the later outputs
+/// @return The register A, or -1 if there is none
+long long find_quine_ra(int *program, int digit_index, long long previous_digits)
+{
+    if (digit_index == -1)
+        return previous_digits;
+
+    for (long long digit = 0; digit < 8; digit++)
+    {
+        long long ra = (previous_digits << 3) | digit;
+        // The first iteration of the loop only depends on A
+        long long rb = (ra & 7) ^ program[3];
+        long long rc = ra >> rb;
+        rb = rb ^ program[7] ^ rc;
+        if ((rb & 7) == program[digit_index] && ra != 0)
+        {
+            long long result = find_quine_ra(program, digit_index - 1, ra);
+            if (result != -1)
+                return result;
+        }
+    }
+    return -1;
+}
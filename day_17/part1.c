@@ -2,6 +2,8 @@
 #include <stdlib.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
 
 DEF_VEC(int)
 
@@ -9,10 +11,24 @@ DEF_VEC(int)
 int ip = 0;
 // "Registers"
 long long ra, rb, rc;
+// Output of the `out` instruction, separated by commas
+char output[ANSWER_SIZE];
+size_t output_len = 0;
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    int_Vec program;
+    long long ra, rb, rc;
+} Puzzle;
 
 int parse_input(char *input_file, int_Vec *program);
 void execute_program(int *program, size_t program_size);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -23,71 +39,100 @@ int main(int argc, char *argv[])
         return 1;
 
     execute_program(program.arr, program.len);
+    puts(output);
 
     free(program.arr);
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->program))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    // The registers are global, so save them for `solve_puzzle`
+    puzzle->ra = ra;
+    puzzle->rb = rb;
+    puzzle->rc = rc;
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    ra = p->ra;
+    rb = p->rb;
+    rc = p->rc;
+    execute_program(p->program.arr, p->program.len);
+    snprintf(answer, ANSWER_SIZE, "%s", output);
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    free(p->program.arr);
+    free(p);
+}
+
+DEF_SOLVER(17, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The input file
 /// @param program Out: The program array
 /// @return 0 if successful, 1 if failed
 int parse_input(char *input_file, int_Vec *program)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    int scanf_result = fscanf(f, "Register A: %lld\n", &ra);
-    if (!scanf_result || (scanf_result == EOF))
+    Span span = input_span(&input);
+    Span line;
+    if (!next_line(&span, &line) || !skip_prefix(&line, "Register A: ") || !parse_number(&line, &ra))
     {
         fprintf(stderr, "Error reading register A\n");
+        close_input(&input);
         return 1;
     }
-    scanf_result = fscanf(f, "Register B: %lld\n", &rb);
-    if (!scanf_result || (scanf_result == EOF))
+    if (!next_line(&span, &line) || !skip_prefix(&line, "Register B: ") || !parse_number(&line, &rb))
     {
         fprintf(stderr, "Error reading register B\n");
+        close_input(&input);
         return 1;
     }
-    scanf_result = fscanf(f, "Register C: %lld\n", &rc);
-    if (!scanf_result || (scanf_result == EOF))
+    if (!next_line(&span, &line) || !skip_prefix(&line, "Register C: ") || !parse_number(&line, &rc))
     {
         fprintf(stderr, "Error reading register C\n");
+        close_input(&input);
         return 1;
     }
 
-    int program_num;
-    scanf_result = fscanf(f, "\nProgram: %d", &program_num);
-    if (!scanf_result || (scanf_result == EOF))
+    // Skip the blank line before the program
+    while (next_line(&span, &line) && line.start == line.end)
+        ;
+    if (!skip_prefix(&line, "Program: "))
     {
         fprintf(stderr, "Error reading program\n");
+        close_input(&input);
         return 1;
     }
 
-    // Initialize program array
-    program->arr = malloc(sizeof(program->arr[0]));
-    program->len = 0;
-    program->cap = 1;
-
     // Loop over the program array
-    while (scanf_result && (scanf_result != EOF))
-    {
+    *program = new_int_Vec();
+    long long program_num;
+    while (next_number(&line, &program_num))
         append_int_Vec(program, program_num);
-        scanf_result = fscanf(f, ",%d", &program_num);
-    }
 
+    close_input(&input);
     return 0;
 }
 
 // Solution
 
-// A flag to determine if a comma should be printed before the `out` instruction
-int should_print_comma = 0;
 
 // Instructions
 void adv(int op);
@@ -106,6 +151,9 @@ const void (*instructions[])(int) = {adv, bxl, bst, jnz, bxc, out, bdv, cdv};
 
 void execute_program(int *program, size_t program_size)
 {
+    ip = 0;
+    output_len = 0;
+    output[0] = '\0';
     // The maximum valid instruction pointer (exclusive)
     int too_large_ip = program_size - 1;
     while (ip < too_large_ip)
@@ -113,7 +161,6 @@ void execute_program(int *program, size_t program_size)
     #pragma GCC diagnostic ignored "-Wsequence-point"
         instructions[program[ip++]](program[ip++]);
     #pragma GCC diagnostic pop
-    putchar('\n');
 }
 
 long long get_combo_op(int op)
@@ -175,14 +222,17 @@ void bxc(int op)
 // Print combo mod 8
 void out(int op)
 {
-    // Conditional logic to make sure a comma is only printed if this isn't the first `out`
-    if (should_print_comma)
-        putchar(',');
-    else
-        should_print_comma = 1;
+    // Leave room for the comma, digit, and null terminator
+    if (output_len + 3 > ANSWER_SIZE)
+        return;
+
+    // Make sure a comma is only printed if this isn't the first `out`
+    if (output_len)
+        output[output_len++] = ',';
 
     // Print combo mod 8
-    putchar((get_combo_op(op) & 07) + '0');
+    output[output_len++] = (get_combo_op(op) & 07) + '0';
+    output[output_len] = '\0';
 }
 
 // Division: rb = ra / (2^combo)
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/trace.h"
 
 DEF_VEC(int)
 
@@ -16,6 +19,10 @@ int parse_input(char *input_file, int_Vec *program);
 void execute_program(int *program, size_t program_size, long long initial_ra);
 long long find_initial_ra(int *program, size_t program_size, int this_digit_index, long long previous_digits);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -31,59 +38,81 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    int_Vec *program = malloc(sizeof(int_Vec));
+    if (parse_input(input_file, program))
+    {
+        free(program);
+        return NULL;
+    }
+    return program;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    int_Vec *program = puzzle;
+    long long initial_ra = find_initial_ra(program->arr, program->len, program->len - 1, 0);
+    snprintf(answer, ANSWER_SIZE, "%lld", initial_ra);
+    return initial_ra == -1;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((int_Vec *)puzzle)->arr);
+    free(puzzle);
+}
+
+DEF_SOLVER(17, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The input file
 /// @param program Out: The program array
 /// @return 0 if successful, 1 if failed
 int parse_input(char *input_file, int_Vec *program)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    int scanf_result = fscanf(f, "Register A: %lld\n", &ra);
-    if (!scanf_result || (scanf_result == EOF))
+    Span span = input_span(&input);
+    Span line;
+    if (!next_line(&span, &line) || !skip_prefix(&line, "Register A: ") || !parse_number(&line, &ra))
     {
         fprintf(stderr, "Error reading register A\n");
+        close_input(&input);
         return 1;
     }
-    scanf_result = fscanf(f, "Register B: %lld\n", &rb);
-    if (!scanf_result || (scanf_result == EOF))
+    if (!next_line(&span, &line) || !skip_prefix(&line, "Register B: ") || !parse_number(&line, &rb))
     {
         fprintf(stderr, "Error reading register B\n");
+        close_input(&input);
         return 1;
     }
-    scanf_result = fscanf(f, "Register C: %lld\n", &rc);
-    if (!scanf_result || (scanf_result == EOF))
+    if (!next_line(&span, &line) || !skip_prefix(&line, "Register C: ") || !parse_number(&line, &rc))
     {
         fprintf(stderr, "Error reading register C\n");
+        close_input(&input);
         return 1;
     }
 
-    int program_num;
-    scanf_result = fscanf(f, "\nProgram: %d", &program_num);
-    if (!scanf_result || (scanf_result == EOF))
+    // Skip the blank line before the program
+    while (next_line(&span, &line) && line.start == line.end)
+        ;
+    if (!skip_prefix(&line, "Program: "))
     {
         fprintf(stderr, "Error reading program\n");
+        close_input(&input);
         return 1;
     }
 
-    // Initialize program array
-    program->arr = malloc(sizeof(program->arr[0]));
-    program->len = 0;
-    program->cap = 1;
-
     // Loop over the program array
-    while (scanf_result && (scanf_result != EOF))
-    {
+    *program = new_int_Vec();
+    long long program_num;
+    while (next_number(&line, &program_num))
         append_int_Vec(program, program_num);
-        scanf_result = fscanf(f, ",%d", &program_num);
-    }
 
+    close_input(&input);
     return 0;
 }
 
@@ -210,6 +239,7 @@ long long find_initial_ra(int *program, size_t program_size, int this_digit_inde
 {
     if (this_digit_index == -1)
         return previous_digits;
+    TRACE_SCOPE_ARG("find_initial_ra", "digit_index", this_digit_index);
     long long initial_ra = previous_digits;
     // Loop over program backwards
     // for (int i = 0; i < program_size; i++)
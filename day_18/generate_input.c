@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "../runner/generator.h"
+
+// The real input has bytes for about 68% of the grid
+#define BYTES_PERCENT 68
+// The first 90% of the bytes never block a planted path, so part 1 works with any prefix in that range
+#define OPEN_PERCENT 90
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 71, 2, 32767, "The number of rows and columns in the grid");
+    if (size == -1)
+        return 1;
+
+    // Random bytes would block the grid too early, so plant a path that goes right and down at random
+    bool *on_path = calloc(size * size, sizeof(on_path[0]));
+    long long row = 0, col = 0;
+    on_path[0] = true;
+    while (row < size - 1 || col < size - 1)
+    {
+        if (col == size - 1 || (row < size - 1 && (next_random() & 1)))
+            row++;
+        else
+            col++;
+        on_path[row * size + col] = true;
+    }
+
+    // Split every tile except the start and end into the ones off of the path and the ones on it
+    int tiles_size = size * size - 2;
+    int *tiles = malloc(sizeof(tiles[0]) * tiles_size);
+    int off_path_size = 0;
+    for (int i = 1; i <= tiles_size; i++)
+        if (!on_path[i])
+            tiles[off_path_size++] = i;
+    for (int i = 1, j = off_path_size; i <= tiles_size; i++)
+        if (on_path[i])
+            tiles[j++] = i;
+
+    // The first bytes only come from off of the path, then the rest can come from anywhere
+    int bytes = tiles_size * BYTES_PERCENT / 100;
+    int open_bytes = bytes * OPEN_PERCENT / 100;
+    if (open_bytes > off_path_size)
+        open_bytes = off_path_size;
+    shuffle_ints(tiles, off_path_size);
+    shuffle_ints(tiles + open_bytes, tiles_size - open_bytes);
+
+    for (int i = 0; i < bytes; i++)
+        printf("%lld,%lld\n", tiles[i] % size, tiles[i] / size);
+
+    free(on_path);
+    free(tiles);
+    return 0;
+}
@@ -2,6 +2,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/grid.h"
+#include "../runner/bitboard.h"
+
+// The size of the real puzzle's grid and the number of points to read. The runner takes the grid size from the input,
+// and reads the same fraction of the grid at any other size
+#define PUZZLE_GRID_SIZE 71
+#define PUZZLE_POINT_COUNT 1024
 
 typedef struct Point
 {
@@ -9,32 +18,24 @@ typedef struct Point
     short col;
 } Point;
 
-typedef struct MazeMove
-{
-    Point p;
-    int steps;
-} MazeMove;
-
-typedef struct MazeMoveHeap
+// IO
+// The parsed input for the runner
+typedef struct Puzzle
 {
-    MazeMove *arr;
-    int len;
-    int cap;
-} MazeMoveHeap;
+    Point *points;
+    int point_count;
+    int grid_size;
+} Puzzle;
 
-// IO
 int parse_input(char *input_file, Point **points, int *point_count);
-void print_grid(char **grid, int map_size);
+int get_grid_size(Point *points, int points_size);
 
 // Problem steps
 long long get_min_steps(Point *obstacles, int obstacles_size, int grid_size);
 
-// Priority queue
-void resize_pq(MazeMoveHeap *heap, int new_cap);
-void push_pq(MazeMoveHeap *heap, MazeMove val);
-MazeMove pop_pq(MazeMoveHeap *heap);
-void sift_down_pq(MazeMoveHeap *heap, int parent_index);
-// MazeMove peek_pq(MazeMoveHeap heap);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
@@ -56,40 +57,84 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    // Every point is read to find the size, then only the first ones are kept
+    puzzle->point_count = 0;
+    if (parse_input(input_file, &puzzle->points, &puzzle->point_count))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    puzzle->grid_size = get_grid_size(puzzle->points, puzzle->point_count);
+    long long scaled_count = (long long)PUZZLE_POINT_COUNT * puzzle->grid_size * puzzle->grid_size / (PUZZLE_GRID_SIZE * PUZZLE_GRID_SIZE);
+    if (scaled_count < puzzle->point_count)
+        puzzle->point_count = scaled_count;
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", get_min_steps(p->points, p->point_count, p->grid_size));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((Puzzle *)puzzle)->points);
+    free(puzzle);
+}
+
+DEF_SOLVER(18, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse input.txt
 /// @param input_file The file to read
 /// @param points Out: The point array to read into
-/// @param point_count In/out: The maximum number of points to read. Will be updated to reflect the number of points actually read
+/// @param point_count In/out: The maximum number of points to read, or 0 to read every point. Will be updated to reflect the number of points actually read
 /// @return 0 if success. 1 if failure.
 int parse_input(char *input_file, Point **points, int *point_count)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
-        fclose(f);
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
     // Store the original value of *point_count as max_points so we can have a limit, then zero *point_count so we can actually count
-    int max_points = *point_count;
+    // Each point is on its own line, so there are at most as many points as lines
+    Span span = input_span(&input);
+    int max_points = *point_count > 0 ? *point_count : (int)count_lines(span);
     *point_count = 0;
     *points = malloc(sizeof((*points)[0]) * max_points);
 
-    // Read while below maximum point count
-    while (*point_count < max_points && fscanf(f, "%hd,%hd\n", &((*points)[*point_count].col), &((*points)[*point_count].row)) == 2)
+    // Read while below maximum point count. Each point is "col,row"
+    long long col, row;
+    while (*point_count < max_points && next_number(&span, &col) && next_number(&span, &row))
+    {
+        (*points)[*point_count] = (Point){.row = row, .col = col};
         (*point_count)++;
+    }
 
-    fclose(f);
+    close_input(&input);
     return 0;
 }
 
-// Print every line in `grid`
-void print_grid(char **grid, int map_size)
+/// @brief Get the size of the smallest square grid that holds every point. The points cover most of the grid, so this is
+/// the size of the grid they fell on
+/// @param points The points
+/// @param points_size The number of points
+/// @return The number of rows/columns in the grid
+int get_grid_size(Point *points, int points_size)
 {
-    for (int i = 0; i < map_size; i++)
-        puts(grid[i]);
+    int grid_size = 1;
+    for (int i = 0; i < points_size; i++)
+    {
+        if (points[i].row >= grid_size)
+            grid_size = points[i].row + 1;
+        if (points[i].col >= grid_size)
+            grid_size = points[i].col + 1;
+    }
+    return grid_size;
 }
 
 /// @brief Count the maximum number of steps taken in a `grid_size` x `grid_size` map while avoiding each obstacle
@@ -100,20 +145,10 @@ void print_grid(char **grid, int map_size)
 long long get_min_steps(Point *obstacles, int obstacles_size, int grid_size)
 {
     long long min_steps = -1;
-    MazeMoveHeap heap = {.arr = NULL, .len = 0, .cap = 0};
-    Point target = {grid_size - 1, grid_size - 1};
 
-    // Allocate grid
-    char **grid = malloc(sizeof(grid[0]) * grid_size);
-    for (int i = 0; i < grid_size; i++)
-    {
-        // Allocate row
-        grid[i] = malloc(sizeof(grid[0][0]) * (grid_size + 1));
-        // Set the entire grid to '.'
-        memset(grid[i], '.', grid_size);
-        // Set the last character to '\0' to end the string
-        grid[i][grid_size] = '\0';
-    }
+    // Allocate grid, with the entire grid set to '.'
+    Grid grid = new_grid(grid_size, grid_size, 1, '.', '#');
+    Bitboard reached = new_bitboard(grid_size, grid_size);
 
     for (int i = 0; i < obstacles_size; i++)
     {
@@ -125,164 +160,26 @@ long long get_min_steps(Point *obstacles, int obstacles_size, int grid_size)
             goto CLEANUP;
         }
 
-        grid[p.row][p.col] = '#';
+        GRID_CELL(grid, p.row, p.col) = '#';
     }
 
-    print_grid(grid, grid_size);
-
-    MazeMove this_move = {.p = {0, 0}, .steps = 0};
-    while (this_move.steps >= 0)
-    {
-        // Skip if this point was already found
-        if (grid[this_move.p.row][this_move.p.col] != '.')
-            goto NEXT_MOVE;
-
-        // Mark this point as found
-        grid[this_move.p.row][this_move.p.col] = 'O';
-
-        // Right
-        if (this_move.p.col + 1 < grid_size && grid[this_move.p.row][this_move.p.col + 1] == '.')
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row, .col = this_move.p.col + 1}, .steps = this_move.steps + 1});
-        // Up
-        if (this_move.p.row > 0 && grid[this_move.p.row - 1][this_move.p.col] == '.')
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row - 1, .col = this_move.p.col}, .steps = this_move.steps + 1});
-        // Left
-        if (this_move.p.col > 0 && grid[this_move.p.row][this_move.p.col - 1] == '.')
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row, .col = this_move.p.col - 1}, .steps = this_move.steps + 1});
-        // Down
-        if (this_move.p.row + 1 < grid_size && grid[this_move.p.row + 1][this_move.p.col] == '.')
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row + 1, .col = this_move.p.col}, .steps = this_move.steps + 1});
+    print_grid(grid);
 
-    // Next point in the heap
-    NEXT_MOVE:
-        this_move = pop_pq(&heap);
+    // Search every free tile at the same distance at once
+    Bitboard free_tiles = bitboard_from_grid(grid, '.');
+    min_steps = bitboard_min_steps(free_tiles, 0, 0, grid_size - 1, grid_size - 1, &reached);
+    delete_bitboard(&free_tiles);
 
-        // Check if we found the end
-        if (this_move.p.row == target.row && this_move.p.col == target.col)
-        {
-            min_steps = this_move.steps;
-            break;
-        }
-    }
+    // Mark every tile the search found
+    BITBOARD_FOR_EACH(reached, bit)
+        GRID_CELL(grid, bitboard_row(reached, bit), bitboard_col(reached, bit)) = 'O';
 
     printf("\n");
-    print_grid(grid, grid_size);
+    print_grid(grid);
     printf("\n");
 
 CLEANUP:
-    for (int i = 0; i < grid_size; i++)
-        free(grid[i]);
-    free(grid);
-    free(heap.arr);
+    delete_grid(&grid);
+    delete_bitboard(&reached);
     return min_steps;
 }
-
-/// @brief Resize a heap
-/// @param heap The heap
-/// @param new_cap The new capacity
-void resize_pq(MazeMoveHeap *heap, int new_cap)
-{
-    heap->arr = realloc(heap->arr, sizeof(heap->arr[0]) * new_cap);
-    heap->cap = new_cap;
-}
-
-/// @brief Push a value onto the heap
-/// @param heap The heap
-/// @param val The new value
-void push_pq(MazeMoveHeap *heap, MazeMove val)
-{
-    /* From Wikipedia https://en.wikipedia.org/wiki/Binary_heap Heap operations
-       1. Add the element to the bottom level of the heap at the leftmost open space.
-       2. Compare the added element with its parent; if they are in the correct order, stop.
-       3. If not, swap the element with its parent and return to the previous step.
-    */
-    int this_element = heap->len;
-    int parent = (this_element - 1) / 2;
-
-    // Double capacity if necessary
-    if (heap->len + 1 > heap->cap)
-        resize_pq(heap, heap->cap ? heap->cap * 2 : 1);
-
-    // Add the element to the bottom level of the heap at the leftmost open space.
-    heap->arr[heap->len++] = val;
-
-    // Compare the added element with its parent; if they are in the correct order, stop.
-    // `&& thisElement` to stop when thisElement is root
-    while ((heap->arr[this_element].steps < heap->arr[parent].steps) && this_element)
-    {
-        // If not, swap the element with its parent and return to the previous step.
-        MazeMove temp = heap->arr[this_element];
-        heap->arr[this_element] = heap->arr[parent];
-        heap->arr[parent] = temp;
-
-        // For previous step
-        this_element = parent;
-        parent = (this_element - 1) / 2;
-    }
-}
-
-/// @brief Pop the top value off of the heap
-/// @param heap The heap
-/// @return The old top
-MazeMove pop_pq(MazeMoveHeap *heap)
-{
-    // Do nothing if the heap is empty
-    // Indicate the heap is empty with negative steps, though
-    if (heap->len <= 0)
-        return (MazeMove){.p = {0, 0}, .steps = -1};
-    MazeMove top = heap->arr[0];
-    MazeMove new_root = heap->arr[--(heap->len)];
-    heap->arr[0] = new_root;
-    sift_down_pq(heap, 0);
-    return top;
-}
-
-/// @brief Sift down operation on heap
-/// @param heap The heap
-/// @param index The index of the parent element to sift down
-void sift_down_pq(MazeMoveHeap *heap, int parent_index)
-{
-    int left = (parent_index * 2) + 1;
-    int right = left + 1;
-    int parent_val = heap->arr[parent_index].steps;
-    int min_val = parent_val;
-    int min_index = parent_index;
-
-    // Check if left is min
-    if (left < heap->len)
-    {
-        int left_val = heap->arr[left].steps;
-        if (left_val < min_val)
-        {
-            min_index = left;
-            min_val = left_val;
-        }
-    }
-
-    // Check if right is min
-    if (right < heap->len)
-    {
-        int right_val = heap->arr[right].steps;
-        if (right_val < min_val)
-        {
-            min_index = right;
-            min_val = right_val;
-        }
-    }
-
-    // Check if parent is still min
-    if (min_index != parent_index)
-    {
-        // Swap
-        MazeMove temp = heap->arr[parent_index];
-        heap->arr[parent_index] = heap->arr[min_index];
-        heap->arr[min_index] = temp;
-        sift_down_pq(heap, min_index);
-    }
-}
-
-// // Peek at the top of the heap
-// MazeMove peek_pq(MazeMoveHeap heap)
-// {
-//     return heap.arr[0];
-// }
@@ -1,12 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdbit.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-
-// Helper to index a 1D array as 2D
-#define IDX_2D(arr, row, col) arr[((row) * map_row_size) + (col)]
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/bitboard.h"
+#include "../runner/trace.h"
 
 typedef struct Point
 {
@@ -15,46 +16,26 @@ typedef struct Point
 } Point;
 
 DEF_VEC(Point)
+DEF_VEC_CAPACITY(Point)
 
-typedef enum Direction
-{
-    EAST = 0,
-    NORTH = 1,
-    WEST = 2,
-    SOUTH = 3,
-} Direction;
-
-typedef struct MazeMove
+// The parsed input for the runner, which takes the grid size from the input
+typedef struct Puzzle
 {
-    Point p;
-    int steps;
-    Direction dir;
-} MazeMove;
-
-typedef struct MazeMoveHeap
-{
-    MazeMove *arr;
-    int len;
-    int cap;
-} MazeMoveHeap;
+    Point_Vec points;
+    int grid_size;
+} Puzzle;
 
 // IO
 int parse_input(char *input_file, Point_Vec *points);
-void print_grid(char **grid, int map_size);
+int get_grid_size(Point *points, size_t points_size);
 
 // Problem steps
-long long get_min_steps(char **grid, int grid_size);
+bool check_is_blocked(Bitboard free_tiles, Point *obstacles, size_t obstacles_size);
 Point get_first_blocker(Point *obstacles, size_t obstacles_size, int grid_size);
-int check_is_found(char *found_map, int map_size, int map_row_size, int row, int col);
-void mark_found(char *found_map, int map_size, int map_row_size, int row, int col, Direction direction);
-void mark_min_path(char **grid, char *found_map, int map_size, int map_row_size, int row, int col);
 
-// Priority queue
-void resize_pq(MazeMoveHeap *heap, int new_cap);
-void push_pq(MazeMoveHeap *heap, MazeMove val);
-MazeMove pop_pq(MazeMoveHeap *heap);
-void sift_down_pq(MazeMoveHeap *heap, int parent_index);
-// MazeMove peek_pq(MazeMoveHeap heap);
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
@@ -78,363 +59,124 @@ int main(int argc, char *argv[])
     return 0;
 }
 
-/// @brief Parse input.txt
-/// @param input_file The file to read
-/// @param points Out: The point array to read into
-/// @return 0 if success. 1 if failure.
-int parse_input(char *input_file, Point_Vec *points)
+void *parse_puzzle(char *input_file)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->points))
     {
-        perror("Error opening input file");
-        fclose(f);
-        return 1;
+        free(puzzle);
+        return NULL;
     }
-
-    // Store the original value of *point_count as max_points so we can have a limit, then zero *point_count so we can actually count
-    *points = new_Point_Vec();
-
-    // Read while below maximum point count
-    Point p;
-    while (fscanf(f, "%hd,%hd\n", &p.col, &p.row) == 2)
-        append_Point_Vec(points, p);
-
-    fclose(f);
-    return 0;
+    puzzle->grid_size = get_grid_size(puzzle->points.arr, puzzle->points.len);
+    return puzzle;
 }
 
-// Print every line in `grid`
-void print_grid(char **grid, int map_size)
+int solve_puzzle(void *puzzle, char *answer)
 {
-    for (int i = 0; i < map_size; i++)
-        puts(grid[i]);
+    Puzzle *p = puzzle;
+    Point first_blocker = get_first_blocker(p->points.arr, p->points.len, p->grid_size);
+    snprintf(answer, ANSWER_SIZE, "%hd,%hd", first_blocker.col, first_blocker.row);
+    return 0;
 }
 
-/// @brief Count the maximum number of steps taken in a `grid_size` x `grid_size` map while avoiding each obstacle
-/// @param grid The map of free spaces and obstacles
-/// @param grid_size The number of rows/columns in the grid
-/// @return The minimum number of steps needed to go from (0,0) to (`grid_size-1`,`grid_size-1`)
-long long get_min_steps(char **grid, int grid_size)
+void delete_puzzle(void *puzzle)
 {
-    long long min_steps = -1;
-    MazeMoveHeap heap = {.arr = NULL, .len = 0, .cap = 0};
-    char *found_map = calloc(grid_size * grid_size, sizeof(found_map[0]));
-    Point target = {grid_size - 1, grid_size - 1};
-
-    // print_grid(grid, grid_size);
-
-    MazeMove this_move = {.p = {0, 0}, .steps = 0};
-    while (this_move.steps >= 0)
-    {
-        // Skip if this point was already found
-        if (check_is_found(found_map, grid_size, grid_size, this_move.p.row, this_move.p.col))
-            goto NEXT_MOVE;
-
-        // Mark this point as found
-        mark_found(found_map, grid_size, grid_size, this_move.p.row, this_move.p.col, this_move.dir);
-        // grid[this_move.p.row][this_move.p.col] = 'O';
-
-        // Check if we found the end
-        if (this_move.p.row == target.row && this_move.p.col == target.col)
-        {
-            min_steps = this_move.steps;
-            break;
-        }
-
-        // Right
-        if (this_move.p.col + 1 < grid_size && grid[this_move.p.row][this_move.p.col + 1] == '.' && !check_is_found(found_map, grid_size, grid_size, this_move.p.row, this_move.p.col + 1))
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row, .col = this_move.p.col + 1}, .steps = this_move.steps + 1, .dir = EAST});
-        // Up
-        if (this_move.p.row > 0 && grid[this_move.p.row - 1][this_move.p.col] == '.' && !check_is_found(found_map, grid_size, grid_size, this_move.p.row - 1, this_move.p.col))
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row - 1, .col = this_move.p.col}, .steps = this_move.steps + 1, .dir = NORTH});
-        // Left
-        if (this_move.p.col > 0 && grid[this_move.p.row][this_move.p.col - 1] == '.' && !check_is_found(found_map, grid_size, grid_size, this_move.p.row, this_move.p.col - 1))
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row, .col = this_move.p.col - 1}, .steps = this_move.steps + 1, .dir = WEST});
-        // Down
-        if (this_move.p.row + 1 < grid_size && grid[this_move.p.row + 1][this_move.p.col] == '.' && !check_is_found(found_map, grid_size, grid_size, this_move.p.row + 1, this_move.p.col))
-            push_pq(&heap, (MazeMove){.p = {.row = this_move.p.row + 1, .col = this_move.p.col}, .steps = this_move.steps + 1, .dir = SOUTH});
-
-    // Next point in the heap
-    NEXT_MOVE:
-        this_move = pop_pq(&heap);
-    }
-
-    // printf("\n");
-    // print_grid(grid, grid_size);
-    // printf("\n");
-
-    if (min_steps > 0)
-        mark_min_path(grid, found_map, grid_size, grid_size, target.row, target.col);
-
-    free(heap.arr);
-    free(found_map);
-    return min_steps;
+    free(((Puzzle *)puzzle)->points.arr);
+    free(puzzle);
 }
 
-/// @brief Resize a heap
-/// @param heap The heap
-/// @param new_cap The new capacity
-void resize_pq(MazeMoveHeap *heap, int new_cap)
-{
-    heap->arr = realloc(heap->arr, sizeof(heap->arr[0]) * new_cap);
-    heap->cap = new_cap;
-}
+DEF_SOLVER(18, 2, parse_puzzle, solve_puzzle, delete_puzzle)
 
-/// @brief Push a value onto the heap
-/// @param heap The heap
-/// @param val The new value
-void push_pq(MazeMoveHeap *heap, MazeMove val)
+/// @brief Parse input.txt
+/// @param input_file The file to read
+/// @param points Out: The point array to read into
+/// @return 0 if success. 1 if failure.
+int parse_input(char *input_file, Point_Vec *points)
 {
-    /* From Wikipedia https://en.wikipedia.org/wiki/Binary_heap Heap operations
-       1. Add the element to the bottom level of the heap at the leftmost open space.
-       2. Compare the added element with its parent; if they are in the correct order, stop.
-       3. If not, swap the element with its parent and return to the previous step.
-    */
-    int this_element = heap->len;
-    int parent = (this_element - 1) / 2;
-
-    // Double capacity if necessary
-    if (heap->len + 1 > heap->cap)
-        resize_pq(heap, heap->cap ? heap->cap * 2 : 1);
-
-    // Add the element to the bottom level of the heap at the leftmost open space.
-    heap->arr[heap->len++] = val;
-
-    // Compare the added element with its parent; if they are in the correct order, stop.
-    // `&& thisElement` to stop when thisElement is root
-    while ((heap->arr[this_element].steps < heap->arr[parent].steps) && this_element)
-    {
-        // If not, swap the element with its parent and return to the previous step.
-        MazeMove temp = heap->arr[this_element];
-        heap->arr[this_element] = heap->arr[parent];
-        heap->arr[parent] = temp;
+    Input input;
+    if (open_input(input_file, &input))
+        return 1;
 
-        // For previous step
-        this_element = parent;
-        parent = (this_element - 1) / 2;
-    }
-}
+    // Each point is "col,row", one per line
+    Span span = input_span(&input);
+    *points = with_capacity_Point_Vec(count_lines(span));
+    long long col, row;
+    while (next_number(&span, &col) && next_number(&span, &row))
+        append_Point_Vec(points, (Point){.row = row, .col = col});
 
-/// @brief Pop the top value off of the heap
-/// @param heap The heap
-/// @return The old top
-MazeMove pop_pq(MazeMoveHeap *heap)
-{
-    // Do nothing if the heap is empty
-    // Indicate the heap is empty with negative steps, though
-    if (heap->len <= 0)
-        return (MazeMove){.p = {0, 0}, .steps = -1};
-    MazeMove top = heap->arr[0];
-    MazeMove new_root = heap->arr[--(heap->len)];
-    heap->arr[0] = new_root;
-    sift_down_pq(heap, 0);
-    return top;
+    close_input(&input);
+    return 0;
 }
 
-/// @brief Sift down operation on heap
-/// @param heap The heap
-/// @param index The index of the parent element to sift down
-void sift_down_pq(MazeMoveHeap *heap, int parent_index)
+/// @brief Get the size of the smallest square grid that holds every point. The points cover most of the grid, so this is
+/// the size of the grid they fell on
+/// @param points The points
+/// @param points_size The number of points
+/// @return The number of rows/columns in the grid
+int get_grid_size(Point *points, size_t points_size)
 {
-    int left = (parent_index * 2) + 1;
-    int right = left + 1;
-    int parent_val = heap->arr[parent_index].steps;
-    int min_val = parent_val;
-    int min_index = parent_index;
-
-    // Check if left is min
-    if (left < heap->len)
-    {
-        int left_val = heap->arr[left].steps;
-        if (left_val < min_val)
-        {
-            min_index = left;
-            min_val = left_val;
-        }
-    }
-
-    // Check if right is min
-    if (right < heap->len)
-    {
-        int right_val = heap->arr[right].steps;
-        if (right_val < min_val)
-        {
-            min_index = right;
-            min_val = right_val;
-        }
-    }
-
-    // Check if parent is still min
-    if (min_index != parent_index)
+    int grid_size = 1;
+    for (size_t i = 0; i < points_size; i++)
     {
-        // Swap
-        MazeMove temp = heap->arr[parent_index];
-        heap->arr[parent_index] = heap->arr[min_index];
-        heap->arr[min_index] = temp;
-        sift_down_pq(heap, min_index);
+        if (points[i].row >= grid_size)
+            grid_size = points[i].row + 1;
+        if (points[i].col >= grid_size)
+            grid_size = points[i].col + 1;
     }
+    return grid_size;
 }
 
-// // Peek at the top of the heap
-// MazeMove peek_pq(MazeMoveHeap heap)
-// {
-//     return heap.arr[0];
-// }
+/// @brief Check if the first obstacles block every path from (0,0) to the far corner
+/// @param free_tiles Scratch space the size of the grid
+/// @param obstacles The array of obstacles
+/// @param obstacles_size The number of obstacles to place
+/// @return true if the far corner can't be reached
+bool check_is_blocked(Bitboard free_tiles, Point *obstacles, size_t obstacles_size)
+{
+    TRACE_SCOPE_ARG("check_is_blocked", "obstacles", obstacles_size);
+    bitboard_fill(free_tiles);
+    for (size_t i = 0; i < obstacles_size; i++)
+        bitboard_unset(free_tiles, obstacles[i].row, obstacles[i].col);
+    return bitboard_min_steps(free_tiles, 0, 0, free_tiles.rows - 1, free_tiles.cols - 1, NULL) == -1;
+}
 
 /// @brief Get the first Point that will completely block the grid
 /// @param obstacles The array of obstacles
 /// @param obstacles_size The number of elements in `obstacles`
 /// @param grid_size The number of rows/columns in the grid
-/// @return The first blocking point
+/// @return The first blocking point, or (-1,-1) if the grid is never blocked
 Point get_first_blocker(Point *obstacles, size_t obstacles_size, int grid_size)
 {
-    // Allocate grid
-    char **grid = malloc(sizeof(grid[0]) * grid_size);
-    char **grid_temp = malloc(sizeof(grid_temp[0]) * grid_size);
-    Point first_blocker;
-    for (int i = 0; i < grid_size; i++)
-    {
-        // Allocate row for both grid and temporary grid
-        grid[i] = malloc(sizeof(grid[0][0]) * (grid_size + 1));
-        grid_temp[i] = malloc(sizeof(grid_temp[0][0]) * (grid_size + 1));
-        // Set the entire grid to '.'
-        memset(grid[i], '.', grid_size);
-        // Set the last character to '\0' to end the string
-        grid[i][grid_size] = '\0';
-    }
-
-    // Put the first 1024 obstacles because we know they are safe
-    for (int i = 0; i < 1024 && i < obstacles_size; i++)
+    Point first_blocker = {.row = -1, .col = -1};
+    for (size_t i = 0; i < obstacles_size; i++)
     {
         Point p = obstacles[i];
         // Ensure the point is valid
         if (p.row < 0 || p.col < 0 || p.row >= grid_size || p.col >= grid_size)
         {
             fprintf(stderr, "Unexpected point (%hd,%hd). Points axes be in the range [0,%d)\n", p.row, p.col, grid_size);
-            goto CLEANUP;
+            return first_blocker;
         }
-
-        grid[p.row][p.col] = '#';
     }
 
-    // print_grid(grid, grid_size);
-    // printf("\n");
-
-    // Clone grid for each run
-    for (int i = 0; i < grid_size; i++)
-        memcpy(grid_temp[i], grid[i], sizeof(grid[0][0]) * (grid_size + 1));
-
-    long long min_steps = get_min_steps(grid_temp, grid_size);
-    print_grid(grid_temp, grid_size);
-    printf("Min steps: %lld\n\n", min_steps);
-
-    for (int i = 1024; i < obstacles_size; i++)
+    // Once the grid is blocked, every later obstacle keeps it blocked, so binary search for the fewest obstacles that block it
+    // Each check searches the whole grid a frontier at a time, so this is a few searches instead of one per obstacle on the path
+    Bitboard free_tiles = new_bitboard(grid_size, grid_size);
+    size_t low = 0, high = obstacles_size + 1;
+    while (low + 1 < high)
     {
-        Point p = obstacles[i];
-        grid[p.row][p.col] = '#';
-        // Go to the next obstacle if this doesn't even change the last solution
-        if (grid_temp[p.row][p.col] != 'O')
-            continue;
-
-        // Clone grid for each run
-        for (int i = 0; i < grid_size; i++)
-            memcpy(grid_temp[i], grid[i], sizeof(grid[0][0]) * grid_size);
-        
-        min_steps = get_min_steps(grid_temp, grid_size);
-        if (min_steps == -1)
-        {
-            // Once we find a blocker, return it
-            first_blocker = p;
-            printf("Blocker index: %d\n", i);
-            break;
-        }
+        size_t mid = low + (high - low) / 2;
+        if (check_is_blocked(free_tiles, obstacles, mid))
+            high = mid;
+        else
+            low = mid;
     }
+    delete_bitboard(&free_tiles);
 
-CLEANUP:
-    for (int i = 0; i < grid_size; i++)
+    if (high <= obstacles_size)
     {
-        free(grid[i]);
-        free(grid_temp[i]);
+        first_blocker = obstacles[high - 1];
+        printf("Blocker index: %zu\n", high - 1);
     }
-    free(grid);
-    free(grid_temp);
     return first_blocker;
 }
-
-/// @brief Check if a position has been marked as found
-/// @param found_map The map of found positions
-/// @param map_size The number of rows in the map
-/// @param map_row_size The number of columns in the map
-/// @param row The row to check
-/// @param col The column to check
-/// @return 0 if not marked, (1 << direction) (i.e. some nonzero value) if found
-int check_is_found(char *found_map, int map_size, int map_row_size, int row, int col)
-{
-    return IDX_2D(found_map, row, col); // & (1 << direction);
-}
-
-/// @brief Mark a position on the map as found
-/// @param found_map The map of found positions
-/// @param map_size The number of rows in the map
-/// @param map_row_size The number of columns in the map
-/// @param row The row to mark
-/// @param col The column to mark
-/// @param direction The direction to mark
-void mark_found(char *found_map, int map_size, int map_row_size, int row, int col, Direction direction)
-{
-    // Mark found with a bit, offset by the direction
-    if (direction >= 0)
-        IDX_2D(found_map, row, col) |= 1 << direction;
-}
-
-/// @brief Mark this square, and any parents of this square
-/// @param grid The grid to mark
-/// @param found_map The map of found positions
-/// @param map_size The number of rows in the map
-/// @param map_row_size The number of columns in the map
-/// @param row The row to mark
-/// @param col The column to mark
-void mark_min_path(char **grid, char *found_map, int map_size, int map_row_size, int row, int col)
-{
-    // Mark
-    grid[row][col] = 'O';
-    // Stop at the origin
-    if (!row && !col)
-        return;
-
-    // Find parent
-    char parents_bits = IDX_2D(found_map, row, col);
-    if (stdc_count_ones_uc(parents_bits) != 1)
-    {
-        fprintf(stderr, "Multiple/too few parents of (%d,%d): %hhx\n", row, col, parents_bits);
-        exit(1);
-    }
-    Direction dir = stdc_trailing_zeros_uc(parents_bits);
-
-    // We are checking behind, so this will be reversed (i.e. facing east means check paths to the west)
-    int next_row = row;
-    int next_col = col;
-    switch (dir)
-    {
-    case EAST:
-        next_col--;
-        break;
-    case NORTH:
-        next_row++;
-        break;
-    case WEST:
-        next_col++;
-        break;
-    case SOUTH:
-        next_row--;
-        break;
-    default:
-        // Panic
-        fprintf(stderr, "Unknown direction %d\n", dir);
-        return;
-    }
-
-    mark_min_path(grid, found_map, map_size, map_row_size, next_row, next_col);
-}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../runner/generator.h"
+
+#define COLORS "wubrg"
+#define TOWEL_COUNT 447
+#define MAX_TOWEL_LENGTH 8
+// The total length of all patterns, so longer patterns mean fewer of them
+#define TOTAL_PATTERN_LENGTH 24000
+// A run of one color this long has a middle that a towel can only cover if it is only that color
+#define IMPOSSIBLE_RUN_LENGTH (2 * MAX_TOWEL_LENGTH + 1)
+
+int main(int argc, char *argv[])
+{
+    long long length = parse_generator_args(argc, argv, 60, 1, 100000000, "The maximum length of a pattern. There are fewer patterns when they are longer");
+    if (length == -1)
+        return 1;
+
+    // Every single color but one is a towel, so most but not all patterns can be made
+    char towels[TOWEL_COUNT][MAX_TOWEL_LENGTH + 1];
+    int missing_color = random_range(0, 4);
+    int towels_size = 0;
+    for (int i = 0; i < 5; i++)
+        if (i != missing_color)
+        {
+            towels[towels_size][0] = COLORS[i];
+            towels[towels_size++][1] = '\0';
+        }
+
+    // The rest are random and distinct
+    while (towels_size < TOWEL_COUNT)
+    {
+        int towel_length = random_range(2, MAX_TOWEL_LENGTH);
+        for (int i = 0; i < towel_length; i++)
+            towels[towels_size][i] = COLORS[random_range(0, 4)];
+        towels[towels_size][towel_length] = '\0';
+
+        // No towel is only the missing color, so a long enough run of it can't be made
+        int is_valid = 0;
+        for (int i = 0; i < towel_length; i++)
+            is_valid |= towels[towels_size][i] != COLORS[missing_color];
+        for (int i = 0; i < towels_size && is_valid; i++)
+            is_valid = strcmp(towels[i], towels[towels_size]);
+        if (is_valid)
+            towels_size++;
+    }
+
+    printf("%s", towels[0]);
+    for (int i = 1; i < towels_size; i++)
+        printf(", %s", towels[i]);
+    printf("\n\n");
+
+    long long patterns = TOTAL_PATTERN_LENGTH / length;
+    if (patterns < 1)
+        patterns = 1;
+    char *pattern = malloc(length);
+    for (long long i = 0; i < patterns; i++)
+    {
+        long long pattern_length = random_range(length - length / 3, length);
+        // Half of the patterns are made from towels so they are possible, the rest are random
+        if (next_random() & 1)
+        {
+            for (long long j = 0; j < pattern_length;)
+            {
+                char *towel = towels[random_range(0, towels_size - 1)];
+                for (int k = 0; towel[k] && j < pattern_length; k++, j++)
+                    pattern[j] = towel[k];
+            }
+        }
+        else
+        {
+            for (long long j = 0; j < pattern_length; j++)
+                pattern[j] = COLORS[random_range(0, 4)];
+
+            // Random patterns can almost always be made, so put in a run of the missing color that is too long to cover.
+            // Any towel covering the middle of the run would have to be only the missing color
+            if (pattern_length >= IMPOSSIBLE_RUN_LENGTH)
+            {
+                long long run_start = random_range(0, pattern_length - IMPOSSIBLE_RUN_LENGTH);
+                memset(pattern + run_start, COLORS[missing_color], IMPOSSIBLE_RUN_LENGTH);
+            }
+        }
+        fwrite(pattern, 1, pattern_length, stdout);
+        putchar('\n');
+    }
+
+    free(pattern);
+    return 0;
+}
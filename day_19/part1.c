@@ -5,7 +5,12 @@
 #include <stdbool.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-#include "../c-data-structures/hash_map/hash_map.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/arena.h"
+#include "../runner/hashmap.h"
+#include "../runner/thread_pool.h"
 
 #define SET_WHITE 37
 #define SET_GREEN 32
@@ -15,10 +20,10 @@ typedef char *string;
 
 DEF_VEC(char)
 DEF_VEC(string)
+DEF_VEC_CAPACITY(string)
+// The strings point into the input, so only the array of strings is freed
 void delete_string_vec(string_Vec *vec)
 {
-    for (int i = 0; i < vec->len; i++)
-        free(vec->arr[i]);
     free(vec->arr);
     vec->arr = NULL;
     vec->len = 0UL;
@@ -43,116 +48,150 @@ typedef struct Trie
 } Trie;
 
 // IO
-int parse_input(char *input_file, string_Vec *available_towels, string_Vec *patterns);
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    // The towels and patterns point into the input
+    Input input;
+    string_Vec available_towels;
+    string_Vec patterns;
+} Puzzle;
+
+int parse_input(char *input_file, Input *input, string_Vec *available_towels, string_Vec *patterns);
 void print_trie(Trie *root, char_Vec *prefix);
 
 // Trie
-void push_trie(Trie *root, char *word);
-void delete_trie(Trie *root);
+void push_trie(Arena *arena, Trie *root, char *word);
 TowelColor get_color(char color_char);
 
+// Whether each suffix of the current pattern is possible, keyed by where the suffix starts
+DEF_HASHMAP(PtrKey, bool)
+// One cache per thread, since each thread works on its own pattern
+PtrKey_bool_HashMap valid_caches[MAX_THREADS];
+
 // Problem steps
 int get_valid_patterns(char **available_towels, size_t available_towels_size, char **patterns, size_t patterns_size);
-bool count_valid(Trie *available_towels, char *pattern);
+bool count_valid(Trie *available_towels, PtrKey_bool_HashMap *valid_cache, char *pattern);
+
+// The patterns for each thread of get_valid_patterns to count
+typedef struct PatternJob
+{
+    Trie *towels_trie;
+    char **patterns;
+} PatternJob;
+
+int count_patterns(size_t begin, size_t end, int worker, void *ctx);
+int add_int(int a, int b) { return a + b; }
+DEF_PARALLEL_REDUCE(int)
 
-HashMap valid_cache;
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
+    Input input;
     string_Vec available_towels;
     string_Vec patterns;
-    if (parse_input(input_file, &available_towels, &patterns))
+    if (parse_input(input_file, &input, &available_towels, &patterns))
         return 1;
 
     printf("Number of possible designs: %d\n", get_valid_patterns(available_towels.arr, available_towels.len, patterns.arr, patterns.len));
 
     delete_string_vec(&available_towels);
     delete_string_vec(&patterns);
+    close_input(&input);
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->input, &puzzle->available_towels, &puzzle->patterns))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%d", get_valid_patterns(p->available_towels.arr, p->available_towels.len, p->patterns.arr, p->patterns.len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    delete_string_vec(&p->available_towels);
+    delete_string_vec(&p->patterns);
+    close_input(&p->input);
+    free(p);
+}
+
+DEF_SOLVER(19, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse input.txt
 /// @param input_file The file to read
+/// @param input Out: The input, which must be closed after the towels and patterns are deleted
 /// @param available_towels Out: The list of available towels
 /// @param patterns Out: The list of patterns to make
 /// @return 0 if success. 1 if failure.
-int parse_input(char *input_file, string_Vec *available_towels, string_Vec *patterns)
+int parse_input(char *input_file, Input *input, string_Vec *available_towels, string_Vec *patterns)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
+    if (open_input(input_file, input))
+        return 1;
+
+    // Parse available towels from the first line, "towel, towel, ..."
+    // Each towel is null-terminated in place by replacing the comma or newline after it
+    Span span = input_span(input);
+    Span line;
+    if (!next_line(&span, &line))
     {
-        perror("Error opening input file");
-        fclose(f);
+        fprintf(stderr, "Reached EOF before any towels were read\n");
+        close_input(input);
         return 1;
     }
-
-    // Parse available towels
-    *available_towels = new_string_Vec();
-
-    int ch;
-    char_Vec towel = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
+    // Towels are usually a few letters and ", ", so this is about enough room
+    *available_towels = with_capacity_string_Vec(span_size(line) / 4 + 1);
+    char *ch = line.start;
+    while (ch < line.end)
     {
-        if (isalpha(ch))
-            // Alphabetic
-            append_char_Vec(&towel, ch);
-        else if (ch == ',')
-        {
-
-            // Add terminator for the string and put it on the string vector
-            append_char_Vec(&towel, '\0');
-            append_string_Vec(available_towels, towel.arr);
-            towel = new_char_Vec();
-        }
-        else if (ch == '\n')
-        {
-            // Append the last towel and stop checking for towels
-            append_char_Vec(&towel, '\0');
-            append_string_Vec(available_towels, towel.arr);
+        // Skip to the next towel
+        while (ch < line.end && !isalpha(*ch))
+            ch++;
+        if (ch >= line.end)
             break;
-        }
+
+        append_string_Vec(available_towels, ch);
+        while (ch < line.end && isalpha(*ch))
+            ch++;
+        *ch++ = '\0';
     }
 
-    // Avoid parsing the next newline as a pattern, but check to make sure it's not EOF
-    ch = getc(f);
-    if (ch == EOF)
+    // Parse patterns, one per line, after a blank line
+    if (!next_line(&span, &line))
     {
         // If EOF was reached earlier than expected
         delete_string_vec(available_towels);
         fprintf(stderr, "Reached EOF before any patterns were read\n");
-        fclose(f);
+        close_input(input);
         return 1;
     }
 
-    // Parse patterns
-    *patterns = new_string_Vec();
-    char_Vec pattern = new_char_Vec();
-    while ((ch = getc(f)) != EOF)
-    {
-        if (isalpha(ch))
-            // Alphabetic
-            append_char_Vec(&pattern, ch);
-        else if (ch == '\n')
-        {
-            // Append the last towel and stop checking for towels
-            append_char_Vec(&pattern, '\0');
-            append_string_Vec(patterns, pattern.arr);
-            pattern = new_char_Vec();
-        }
-    }
-
-    // If relevant, append__Vec the last row. Otherwise, just free the row
-    if (pattern.len > 0)
+    *patterns = with_capacity_string_Vec(count_lines(span) + 1);
+    while (next_line(&span, &line))
     {
-        append_char_Vec(&pattern, '\0');
-        append_string_Vec(patterns, pattern.arr);
+        if (line.start == line.end)
+            continue;
+        // Replace the newline with a null terminator
+        *line.end = '\0';
+        append_string_Vec(patterns, line.start);
     }
-    else
-        free(pattern.arr);
 
-    fclose(f);
     return 0;
 }
 
@@ -214,9 +253,10 @@ void print_trie(Trie *root, char_Vec *prefix)
 }
 
 /// @brief Push `word` into a trie
+/// @param arena The arena to allocate new nodes from
 /// @param root The trie
 /// @param word The word to add
-void push_trie(Trie *root, char *word)
+void push_trie(Arena *arena, Trie *root, char *word)
 {
     if (!*word)
     {
@@ -229,22 +269,10 @@ void push_trie(Trie *root, char *word)
 
     // If the correct child has not already been allocated, allocate it
     if (!root->children[color])
-        root->children[color] = calloc(1, sizeof(*(root->children[0])));
+        root->children[color] = arena_calloc(arena, sizeof(*(root->children[0])));
 
     // Recursively push onto the trie the next characters
-    push_trie(root->children[color], word + 1);
-}
-
-/// @brief Recursively delete a Trie
-/// @param root The root node of the trie to delete
-void delete_trie(Trie *root)
-{
-    // Recursively free children
-    for (int i = 0; i < sizeof(root->children) / sizeof(root->children[0]); i++)
-        if (root->children[i])
-            delete_trie(root->children[i]);
-    // Free self
-    free(root);
+    push_trie(arena, root->children[color], word + 1);
 }
 
 // Parse a color into a TowelColor variant
@@ -284,16 +312,15 @@ TowelColor get_color(char color_char)
 /// @return The number of possible patterns
 int get_valid_patterns(char **available_towels, size_t available_towels_size, char **patterns, size_t patterns_size)
 {
-    int valid_pattern_count = 0;
-    int text_color;
-
     // Construct the trie
-    Trie *towels_trie = calloc(1, sizeof(*towels_trie));
+    Arena trie_arena = new_arena(0UL);
+    Trie *towels_trie = arena_calloc(&trie_arena, sizeof(*towels_trie));
     for (size_t i = 0; i < available_towels_size; i++)
-        push_trie(towels_trie, available_towels[i]);
+        push_trie(&trie_arena, towels_trie, available_towels[i]);
 
-    // Initialize valid cache
-    valid_cache = new_HashMap();
+    // Initialize valid caches
+    for (int i = 0; i < MAX_THREADS; i++)
+        valid_caches[i] = new_PtrKey_bool_HashMap();
 
     // Debugging: Make sure trie is loaded correctly
     // char_Vec prefix_vector = new_char_Vec();
@@ -301,12 +328,40 @@ int get_valid_patterns(char **available_towels, size_t available_towels_size, ch
     // prefix_vector.len = 0;
     // print_trie(towels_trie, &prefix_vector);
     // free(prefix_vector.arr);
-    // delete_trie(towels_trie);
+    // delete_arena(&trie_arena);
     // return -1;
 
-    for (size_t i = 0; i < patterns_size; i++)
+    // Each pattern is independent, so split them between threads
+    PatternJob job = {towels_trie, patterns};
+    int valid_pattern_count = parallel_reduce_int(0UL, patterns_size, 16UL, 0, count_patterns, add_int, &job);
+
+    // Reset text color to white and print newline
+    printf("\e[%dm\n", SET_WHITE);
+
+    // Cleanup trie and caches
+    delete_arena(&trie_arena);
+    for (int i = 0; i < MAX_THREADS; i++)
+        delete_PtrKey_bool_HashMap(&valid_caches[i]);
+    return valid_pattern_count;
+}
+
+/// @brief Count the patterns in [begin, end) that can be constructed, printing each one
+/// @param begin The first pattern
+/// @param end One past the last pattern
+/// @param worker The thread running this, which picks its cache
+/// @param ctx The PatternJob
+/// @return The number of possible patterns
+int count_patterns(size_t begin, size_t end, int worker, void *ctx)
+{
+    PatternJob *job = ctx;
+    PtrKey_bool_HashMap *valid_cache = &valid_caches[worker];
+    int valid_pattern_count = 0;
+    int text_color;
+    for (size_t i = begin; i < end; i++)
     {
-        if (count_valid(towels_trie, patterns[i]))
+        // Suffixes are keyed by address, so no other pattern can use this pattern's entries
+        clear_PtrKey_bool_HashMap(valid_cache);
+        if (count_valid(job->towels_trie, valid_cache, job->patterns[i]))
         {
             valid_pattern_count++;
             text_color = SET_GREEN;
@@ -315,29 +370,24 @@ int get_valid_patterns(char **available_towels, size_t available_towels_size, ch
             text_color = SET_RED;
 
         // Print pattern in red or green
-        printf("\e[%dm%s\n", text_color, patterns[i]);
+        printf("\e[%dm%s\n", text_color, job->patterns[i]);
     }
 
-    // Reset text color to white and print newline
-    printf("\e[%dm\n", SET_WHITE);
-
-    // Cleanup trie
-    delete_trie(towels_trie);
-    delete_HashMap(&valid_cache);
     return valid_pattern_count;
 }
 
 /// @brief Check if `pattern` can be constructed using towels from `available_towels`
 /// @param available_towels The available towels
 /// @param available_towels_size The number of elements in `available_towels`
+/// @param valid_cache The results for each suffix of the current pattern
 /// @param pattern The pattern to try
 /// @return true if valid, false if invalid
-bool count_valid(Trie *available_towels, char *pattern)
+bool count_valid(Trie *available_towels, PtrKey_bool_HashMap *valid_cache, char *pattern)
 {
     // Check cache
-    union Value cached_value;
-    if (get_map(&valid_cache, pattern, &cached_value))
-        return !!(cached_value.val);
+    bool cached_value;
+    if (get_PtrKey_bool_HashMap(valid_cache, pattern, &cached_value))
+        return cached_value;
 
     // Base case: pattern == "", which is possible
     if (!*pattern)
@@ -351,9 +401,9 @@ bool count_valid(Trie *available_towels, char *pattern)
     while (this_towel)
     {
         // If the pattern has not ended yet, and we can use a new towel, check that
-        if (this_towel->is_tail && count_valid(available_towels, pattern_temp))
+        if (this_towel->is_tail && count_valid(available_towels, valid_cache, pattern_temp))
         {
-            put_map(&valid_cache, pattern, (union Value){.val = 1});
+            put_PtrKey_bool_HashMap(valid_cache, pattern, true);
             return true;
         }
 
@@ -361,7 +411,7 @@ bool count_valid(Trie *available_towels, char *pattern)
         // If the pattern is ended, check if this is a tail in the available towels
         if (!ch)
         {
-            put_map(&valid_cache, pattern, (union Value){.val = 0});
+            put_PtrKey_bool_HashMap(valid_cache, pattern, false);
             return false;
         }
         color = get_color(ch);
@@ -369,6 +419,6 @@ bool count_valid(Trie *available_towels, char *pattern)
     }
 
     // No valid pattern was found
-    put_map(&valid_cache, pattern, (union Value){.val = 0});
+    put_PtrKey_bool_HashMap(valid_cache, pattern, false);
     return false;
 }
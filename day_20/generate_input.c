@@ -0,0 +1,43 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+int main(int argc, char *argv[])
+{
+    long long size = parse_generator_args(argc, argv, 141, 5, 65535, "The number of rows and columns. Even sizes are rounded down");
+    if (size == -1)
+        return 1;
+    if (!(size & 1))
+        size--;
+
+    // The racetrack is the only path through a maze, with everything else filled in
+    char *maze = malloc(size * size);
+    long long *parent = malloc(sizeof(parent[0]) * size * size);
+    long long start = (size - 2) * size + 1;
+    long long end = size + size - 2;
+    generate_maze(maze, size, start, parent);
+
+    char *map = malloc(size * size);
+    for (long long i = 0; i < size * size; i++)
+        map[i] = '#';
+    for (long long tile = end; tile != start; tile = parent[tile])
+    {
+        // Open this tile and the wall between it and its parent
+        map[tile] = '.';
+        map[(tile + parent[tile]) / 2] = '.';
+    }
+
+    map[start] = 'S';
+    map[end] = 'E';
+    for (long long row = 0; row < size; row++)
+    {
+        fwrite(map + row * size, 1, size, stdout);
+        putchar('\n');
+    }
+
+    free(maze);
+    free(parent);
+    free(map);
+    return 0;
+}
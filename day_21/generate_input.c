@@ -0,0 +1,17 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+int main(int argc, char *argv[])
+{
+    // The solvers read CODE_COUNT codes, so extra codes are ignored
+    long long codes = parse_generator_args(argc, argv, 5, 1, 100000000, "The number of codes");
+    if (codes == -1)
+        return 1;
+
+    for (long long i = 0; i < codes; i++)
+        printf("%03lldA\n", random_range(1, 999));
+
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include <limits.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/trace.h"
 
 #define CODE_LENGTH 4
 #define CODE_COUNT 5
@@ -24,6 +27,13 @@ const short COL_OF[] = {
     0, 1, 2,
     2};
 
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    char **codes;
+    int codes_size;
+} Puzzle;
+
 int parse_input(char *input_file, char ***codes, int *codes_size);
 long long get_total_complexity(char **codes, int codes_size);
 int get_code_numeric_part(char *code);
@@ -31,6 +41,10 @@ long long get_shortest_sequence(char *code, int is_numpad, int depth);
 short get_row_of(char key, int is_numpad);
 short get_col_of(char key, int is_numpad);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -50,6 +64,35 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->codes, &puzzle->codes_size))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", get_total_complexity(p->codes, p->codes_size));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    for (int i = 0; i < p->codes_size; i++)
+        free(p->codes[i]);
+    free(p->codes);
+    free(p);
+}
+
+DEF_SOLVER(21, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param codes Out: An array of CODE_LENGTH digit codes
@@ -57,31 +100,33 @@ int main(int argc, char *argv[])
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, char ***codes, int *codes_size)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
     *codes_size = CODE_COUNT;
     *codes = malloc(sizeof(*codes[0]) * *codes_size);
 
+    Span span = input_span(&input);
+    Span line;
     for (int i = 0; i < *codes_size; i++)
     {
-        (*codes)[i] = malloc(sizeof((*codes)[0][0]) * (CODE_LENGTH + 1));
         // Exit early if bad read
-        if (fscanf(f, "%4s\n", (*codes)[i]) != 1)
+        if (!next_line(&span, &line) || span_size(line) != CODE_LENGTH)
         {
             for (int j = 0; j < i; j++)
                 free((*codes)[j]);
             free(*codes);
             fprintf(stderr, "Error reading codes\n");
+            close_input(&input);
             return 1;
         }
+        (*codes)[i] = malloc(sizeof((*codes)[0][0]) * (CODE_LENGTH + 1));
+        memcpy((*codes)[i], line.start, CODE_LENGTH);
+        (*codes)[i][CODE_LENGTH] = '\0';
     }
 
+    close_input(&input);
     return 0;
 }
 
@@ -220,6 +265,7 @@ short get_col_of(char key, int is_numpad)
 /// @return The length of the shortest sequence of inputs that will produce `code`
 long long get_shortest_sequence(char *code, int is_numpad, int depth)
 {
+    TRACE_SCOPE_ARG("get_shortest_sequence", "depth", depth);
     long long sequence_cost = 0;
     // Loop over desired keys
     char last_key = 'A';
@@ -5,7 +5,10 @@
 #include <stdckdint.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-#include "../c-data-structures/hash_map/hash_map.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/hashmap.h"
+#include "../runner/trace.h"
 
 #define CODE_LENGTH 4
 #define CODE_COUNT 5
@@ -27,6 +30,13 @@ const short COL_OF[] = {
     0, 1, 2,
     2};
 
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    char **codes;
+    int codes_size;
+} Puzzle;
+
 int parse_input(char *input_file, char ***codes, int *codes_size);
 long long get_total_complexity(char **codes, int codes_size);
 int get_code_numeric_part(char *code);
@@ -34,7 +44,16 @@ long long get_shortest_sequence(char *code, int is_numpad, int depth);
 short get_row_of(char key, int is_numpad);
 short get_col_of(char key, int is_numpad);
 
-HashMap *caches;
+// The cost of each sequence at each depth. Every sequence is at most 6 characters, so it fits in a StrKey
+typedef long long SequenceCost;
+DEF_HASHMAP(StrKey, SequenceCost)
+StrKey_SequenceCost_HashMap *caches;
+
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+void new_caches();
+void delete_caches();
 
 int main(int argc, char *argv[])
 {
@@ -45,24 +64,62 @@ int main(int argc, char *argv[])
     if (parse_input(input_file, &codes, &codes_size))
         return 1;
 
-    // Allocate caches
-    caches = malloc(sizeof(caches[0]) * (INDIRECTION + 1));
-    for (int i = 0; i <= INDIRECTION; i++)
-        caches[i] = new_HashMap();
-
+    new_caches();
     long long total_complexity = get_total_complexity(codes, codes_size);
 
     printf("\nTotal complexity: %lld\n", total_complexity);
 
-    for (int i = 0; i <= INDIRECTION; i++)
-        delete_HashMap(&(caches[i]));
-    free(caches);
+    delete_caches();
     for (int i = 0; i < codes_size; i++)
         free(codes[i]);
     free(codes);
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->codes, &puzzle->codes_size))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", get_total_complexity(p->codes, p->codes_size));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    for (int i = 0; i < p->codes_size; i++)
+        free(p->codes[i]);
+    free(p->codes);
+    free(p);
+}
+
+// The cost of a sequence doesn't depend on the codes, so the caches are kept for every puzzle in a batch
+void new_caches()
+{
+    caches = malloc(sizeof(caches[0]) * (INDIRECTION + 1));
+    for (int i = 0; i <= INDIRECTION; i++)
+        caches[i] = new_StrKey_SequenceCost_HashMap();
+}
+
+void delete_caches()
+{
+    for (int i = 0; i <= INDIRECTION; i++)
+        delete_StrKey_SequenceCost_HashMap(&(caches[i]));
+    free(caches);
+}
+
+DEF_SOLVER_WITH_TABLES(21, 2, parse_puzzle, solve_puzzle, delete_puzzle, new_caches, delete_caches)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param codes Out: An array of CODE_LENGTH digit codes
@@ -70,31 +127,33 @@ int main(int argc, char *argv[])
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, char ***codes, int *codes_size)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
     *codes_size = CODE_COUNT;
     *codes = malloc(sizeof(*codes[0]) * *codes_size);
 
+    Span span = input_span(&input);
+    Span line;
     for (int i = 0; i < *codes_size; i++)
     {
-        (*codes)[i] = malloc(sizeof((*codes)[0][0]) * (CODE_LENGTH + 1));
         // Exit early if bad read
-        if (fscanf(f, "%4s\n", (*codes)[i]) != 1)
+        if (!next_line(&span, &line) || span_size(line) != CODE_LENGTH)
         {
             for (int j = 0; j < i; j++)
                 free((*codes)[j]);
             free(*codes);
             fprintf(stderr, "Error reading codes\n");
+            close_input(&input);
             return 1;
         }
+        (*codes)[i] = malloc(sizeof((*codes)[0][0]) * (CODE_LENGTH + 1));
+        memcpy((*codes)[i], line.start, CODE_LENGTH);
+        (*codes)[i][CODE_LENGTH] = '\0';
     }
 
+    close_input(&input);
     return 0;
 }
 
@@ -235,12 +294,14 @@ long long get_shortest_sequence(char *code, int is_numpad, int depth)
 {
     // Check cache
     long long sequence_cost;
-    union Value sequence_cost_v;
-    if (get_map(&(caches[depth]), code, &sequence_cost_v))
-        return sequence_cost_v.val;
+    StrKey key = str_key(code);
+    if (get_StrKey_SequenceCost_HashMap(&(caches[depth]), key, &sequence_cost))
+        return sequence_cost;
     else
         // Set to zero so we can use it in the rest of the program
         sequence_cost = 0;
+    // Only cache misses are traced, so the trace shows each depth's cache filling
+    TRACE_SCOPE_ARG("get_shortest_sequence", "depth", depth);
     // Loop over desired keys
     char last_key = 'A';
     for (int i = 0; code[i]; i++)
@@ -339,6 +400,6 @@ long long get_shortest_sequence(char *code, int is_numpad, int depth)
     }
 
     // Cache
-    put_map(&(caches[depth]), code, (union Value){.val = sequence_cost});
+    put_StrKey_SequenceCost_HashMap(&(caches[depth]), key, sequence_cost);
     return sequence_cost;
 }
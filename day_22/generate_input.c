@@ -0,0 +1,19 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// Secret numbers are pruned to 24 bits
+#define MAX_SECRET 16777215
+
+int main(int argc, char *argv[])
+{
+    long long buyers = parse_generator_args(argc, argv, 2000, 1, 1000000000, "The number of buyers");
+    if (buyers == -1)
+        return 1;
+
+    for (long long i = 0; i < buyers; i++)
+        printf("%lld\n", random_range(1, MAX_SECRET));
+
+    return 0;
+}
@@ -2,17 +2,35 @@
 #include <stdlib.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/thread_pool.h"
+#include "../runner/stream.h"
 
 #define ITERATIONS 2000
 // 16777216-1
 #define PRUNE_BITMASK 16777215
 
 DEF_VEC(int)
+DEF_VEC_CAPACITY(int)
+
+// A sum of secret numbers. A single identifier so it can be reduced in parallel
+typedef long long SecretSum;
 
 int parse_input(char *input_file, int_Vec *nums);
 long long get_secret_number_sum(int *nums, size_t nums_size);
+SecretSum sum_secret_numbers(size_t begin, size_t end, int worker, void *ctx);
+int sum_secret_lines(Span lines, int worker, void *ctx, long long *sum);
+SecretSum add_secret_sums(SecretSum a, SecretSum b) { return a + b; }
+DEF_PARALLEL_REDUCE(SecretSum)
 int get_next_number(int num);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+int stream_puzzle(char *input_file, char *answer);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -29,26 +47,65 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    int_Vec *nums = malloc(sizeof(int_Vec));
+    if (parse_input(input_file, nums))
+    {
+        free(nums);
+        return NULL;
+    }
+    return nums;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    int_Vec *nums = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", get_secret_number_sum(nums->arr, nums->len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((int_Vec *)puzzle)->arr);
+    free(puzzle);
+}
+
+int stream_puzzle(char *input_file, char *answer)
+{
+    long long secret_number_sum;
+    if (stream_sum(input_file, "\n", sum_secret_lines, NULL, &secret_number_sum))
+        return 1;
+    snprintf(answer, ANSWER_SIZE, "%lld", secret_number_sum);
+    return 0;
+}
+
+DEF_STREAM_SOLVER(22, 1, parse_puzzle, solve_puzzle, delete_puzzle, stream_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param nums Out: the vector of numbers in the input file
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, int_Vec *nums)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
-
-    *nums = new_int_Vec();
 
-    int num;
-    while (fscanf(f, "%d\n", &num) == 1)
-        append_int_Vec(nums, num);
+    // One number per line, so they are allocated once at their full size
+    Span span = input_span(&input);
+    size_t lines = count_lines(span);
+    *nums = with_capacity_int_Vec(lines);
+    // Parse many numbers at a time
+    long long values[256];
+    size_t values_size;
+    while ((values_size = next_numbers(&span, values, 256)))
+    {
+        for (size_t i = 0; i < values_size; i++)
+            append_int_Vec(nums, values[i]);
+    }
 
+    close_input(&input);
     return 0;
 }
 
@@ -58,8 +115,21 @@ int parse_input(char *input_file, int_Vec *nums)
 /// @return The sum of the numbers after the hash
 long long get_secret_number_sum(int *nums, size_t nums_size)
 {
-    long long sum = 0;
-    for (size_t i = 0; i < nums_size; i++)
+    // Each buyer is independent, so split them between threads
+    return parallel_reduce_SecretSum(0UL, nums_size, 64UL, 0LL, sum_secret_numbers, add_secret_sums, nums);
+}
+
+/// @brief Get the sum of the numbers in [begin, end) after `ITERATIONS` hashes
+/// @param begin The first seed number
+/// @param end One past the last seed number
+/// @param worker The thread running this
+/// @param ctx The array of seed numbers
+/// @return The sum of the numbers after the hash
+SecretSum sum_secret_numbers(size_t begin, size_t end, int worker, void *ctx)
+{
+    int *nums = ctx;
+    SecretSum sum = 0;
+    for (size_t i = begin; i < end; i++)
     {
         int num = nums[i];
         for (int j = 0; j < ITERATIONS; j++)
@@ -70,6 +140,27 @@ long long get_secret_number_sum(int *nums, size_t nums_size)
     return sum;
 }
 
+/// @brief Sum the numbers in some lines of the input after `ITERATIONS` hashes, without keeping them. Used by stream_sum
+/// @param lines Whole lines of the input
+/// @param worker The thread running this
+/// @param ctx Unused
+/// @param sum In/out: The sum of the numbers after the hash, which these numbers are added to
+/// @return 0
+int sum_secret_lines(Span lines, int worker, void *ctx, long long *sum)
+{
+    // Parse many numbers at a time, then hash them
+    long long values[256];
+    int nums[256];
+    size_t values_size;
+    while ((values_size = next_numbers(&lines, values, 256)))
+    {
+        for (size_t i = 0; i < values_size; i++)
+            nums[i] = values[i];
+        *sum += sum_secret_numbers(0UL, values_size, worker, nums);
+    }
+    return 0;
+}
+
 /// @brief Get the next secret number using the given hash function
 /// @param num The number
 /// @return The hashed number
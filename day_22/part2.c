@@ -3,18 +3,28 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/thread_pool.h"
 
 #define ITERATIONS 2000
 // 16777216-1
 #define PRUNE_BITMASK 16777215
 
 DEF_VEC(int)
+DEF_VEC_CAPACITY(int)
 
 int parse_input(char *input_file, int_Vec *nums);
 int get_secret_number_sum(int *nums, size_t nums_size);
 int get_secret_number_sum_with_sequence(size_t nums_size, short sequence[4]);
 int find_best_change_sequence(int *nums, size_t nums_size);
 int get_next_number(int num);
+int fill_price_sequences(size_t begin, size_t end, int worker, void *ctx);
+int best_sum_from(size_t begin, size_t end, int worker, void *ctx);
+int add_int(int a, int b) { return a + b; }
+int max_int(int a, int b) { return a > b ? a : b; }
+DEF_PARALLEL_REDUCE(int)
 
 // 2D array of price sequences
 // Row is monkey, index is the number of iterations (0 is the initial state)
@@ -23,6 +33,10 @@ short **price_sequences;
 // Row is monkey, index is price_sequences[monkey][i+1] - price_sequences[monkey][i]
 short **price_diffs;
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -56,37 +70,100 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    int_Vec *nums = malloc(sizeof(int_Vec));
+    if (parse_input(input_file, nums))
+    {
+        free(nums);
+        return NULL;
+    }
+    return nums;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    int_Vec *nums = puzzle;
+
+    // Allocate everything
+    price_sequences = malloc(sizeof(price_sequences[0]) * nums->len);
+    price_diffs = malloc(sizeof(price_diffs[0]) * nums->len);
+    for (size_t i = 0; i < nums->len; i++)
+    {
+        price_sequences[i] = malloc(sizeof(price_sequences[0][0]) * (ITERATIONS + 1));
+        price_diffs[i] = malloc(sizeof(price_diffs[0][0]) * ITERATIONS);
+    }
+
+    // This fills in the price sequences and diffs
+    get_secret_number_sum(nums->arr, nums->len);
+    snprintf(answer, ANSWER_SIZE, "%d", find_best_change_sequence(nums->arr, nums->len));
+
+    for (size_t i = 0; i < nums->len; i++)
+    {
+        free(price_sequences[i]);
+        free(price_diffs[i]);
+    }
+    free(price_sequences);
+    free(price_diffs);
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((int_Vec *)puzzle)->arr);
+    free(puzzle);
+}
+
+DEF_SOLVER(22, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param nums Out: the vector of numbers in the input file
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, int_Vec *nums)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    *nums = new_int_Vec();
-
-    int num;
-    while (fscanf(f, "%d\n", &num) == 1)
-        append_int_Vec(nums, num);
+    // One number per line, so they are allocated once at their full size
+    Span span = input_span(&input);
+    size_t lines = count_lines(span);
+    *nums = with_capacity_int_Vec(lines);
+    // Parse many numbers at a time
+    long long values[256];
+    size_t values_size;
+    while ((values_size = next_numbers(&span, values, 256)))
+    {
+        for (size_t i = 0; i < values_size; i++)
+            append_int_Vec(nums, values[i]);
+    }
 
+    close_input(&input);
     return 0;
 }
 
-/// @brief Get the sum of the numbers after `ITERATIONS` hashes
+/// @brief Get the sum of the numbers after `ITERATIONS` hashes, filling in `price_sequences` and `price_diffs`
 /// @param nums The array of seed numbers
 /// @param nums_size The number of elements in `nums`
 /// @return The sum of the numbers after the hash
 int get_secret_number_sum(int *nums, size_t nums_size)
 {
+    // Each buyer has its own rows, so split them between threads
+    return parallel_reduce_int(0UL, nums_size, 64UL, 0, fill_price_sequences, add_int, nums);
+}
+
+/// @brief Fill in the rows of `price_sequences` and `price_diffs` for the buyers in [begin, end)
+/// @param begin The first buyer
+/// @param end One past the last buyer
+/// @param worker The thread running this
+/// @param ctx The array of seed numbers
+/// @return The sum of their numbers after the hash
+int fill_price_sequences(size_t begin, size_t end, int worker, void *ctx)
+{
+    int *nums = ctx;
     int sum = 0;
-    for (size_t i = 0; i < nums_size; i++)
+    for (size_t i = begin; i < end; i++)
     {
         int num = nums[i];
         price_sequences[i][0] = num % 10;
@@ -137,28 +214,35 @@ int get_next_number(int num)
 /// @return The change sequence that will yield the largest secret number sum
 int find_best_change_sequence(int *nums, size_t nums_size)
 {
+    // Check every change sequence, splitting the 19 * 19 choices of the first two changes between threads
+    return parallel_reduce_int(0UL, 19UL * 19UL, 1UL, -1, best_sum_from, max_int, &nums_size);
+}
+
+/// @brief Find the best sum of the change sequences whose first two changes are in [begin, end)
+/// @param begin The first choice of the first two changes, as (first + 9) * 19 + (second + 9)
+/// @param end One past the last choice
+/// @param worker The thread running this
+/// @param ctx The number of buyers
+/// @return The best sum, or -1 if there are no choices
+int best_sum_from(size_t begin, size_t end, int worker, void *ctx)
+{
+    size_t nums_size = *(size_t *)ctx;
     short this_change_sequence[4];
     int best_sum = -1;
 
-    // Check every change sequence
-    for (short i = -9; i <= 9; i++)
+    for (size_t first_two = begin; first_two < end; first_two++)
     {
-        printf("%d\n", i);
-        this_change_sequence[0] = i;
-        for (short j = -9; j <= 9; j++)
+        this_change_sequence[0] = (short)(first_two / 19) - 9;
+        this_change_sequence[1] = (short)(first_two % 19) - 9;
+        for (short k = -9; k <= 9; k++)
         {
-            printf("\t%d\n", j);
-            this_change_sequence[1] = j;
-            for (short k = -9; k <= 9; k++)
+            this_change_sequence[2] = k;
+            for (short l = -9; l <= 9; l++)
             {
-                this_change_sequence[2] = k;
-                for (short l = -9; l <= 9; l++)
-                {
-                    this_change_sequence[3] = l;
-                    int this_sum = get_secret_number_sum_with_sequence(nums_size, this_change_sequence);
-                    if (this_sum > best_sum)
-                        best_sum = this_sum;
-                }
+                this_change_sequence[3] = l;
+                int this_sum = get_secret_number_sum_with_sequence(nums_size, this_change_sequence);
+                if (this_sum > best_sum)
+                    best_sum = this_sum;
             }
         }
     }
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "../runner/generator.h"
+
+// Names are 2 lowercase letters, so there can't be more computers than this
+#define MAX_COMPUTERS 676
+// Every computer in the real input has this many connections, and the LAN party has this many computers
+#define DEGREE 13
+// Give up on adding connections to a computer after this many random tries
+#define MAX_TRIES 1000
+
+int main(int argc, char *argv[])
+{
+    long long computers = parse_generator_args(argc, argv, 520, DEGREE + 1, MAX_COMPUTERS, "The number of computers");
+    if (computers == -1)
+        return 1;
+
+    // Give the computers random distinct names
+    int names[MAX_COMPUTERS];
+    for (int i = 0; i < MAX_COMPUTERS; i++)
+        names[i] = i;
+    shuffle_ints(names, MAX_COMPUTERS);
+
+    bool *connected = calloc(computers * computers, sizeof(connected[0]));
+    int *degree = calloc(computers, sizeof(degree[0]));
+    int *connections = malloc(sizeof(connections[0]) * computers * DEGREE);
+    int connections_size = 0;
+
+    // Plant the LAN party as the first DEGREE computers all connected to each other
+    for (int i = 0; i < DEGREE; i++)
+        for (int j = i + 1; j < DEGREE; j++)
+        {
+            connected[i * computers + j] = connected[j * computers + i] = true;
+            degree[i]++;
+            degree[j]++;
+            connections[connections_size++] = i * computers + j;
+        }
+
+    // Connect everything else at random until it has DEGREE connections
+    for (int i = 0; i < computers; i++)
+        for (int tries = 0; degree[i] < DEGREE && tries < MAX_TRIES; tries++)
+        {
+            int j = random_range(DEGREE, computers - 1);
+            if (j == i || degree[j] >= DEGREE || connected[i * computers + j])
+                continue;
+            connected[i * computers + j] = connected[j * computers + i] = true;
+            degree[i]++;
+            degree[j]++;
+            connections[connections_size++] = i * computers + j;
+        }
+
+    shuffle_ints(connections, connections_size);
+    for (int i = 0; i < connections_size; i++)
+    {
+        int lhs = names[connections[i] / computers];
+        int rhs = names[connections[i] % computers];
+        // Either order
+        if (next_random() & 1)
+        {
+            int temp = lhs;
+            lhs = rhs;
+            rhs = temp;
+        }
+        printf("%c%c-%c%c\n", 'a' + lhs / 26, 'a' + lhs % 26, 'a' + rhs / 26, 'a' + rhs % 26);
+    }
+
+    free(connected);
+    free(degree);
+    free(connections);
+    return 0;
+}
@@ -1,8 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
 
 // 26 * 26
 #define ADJACENCY_MAT_SIZE 676
@@ -15,12 +19,17 @@ typedef struct Connection
 } Connection;
 
 DEF_VEC(Connection)
+DEF_VEC_CAPACITY(Connection)
 DEF_VEC(short)
 
 int parse_input(char *input_file, Connection_Vec *connections);
 long long count_sets_of_3(Connection *connections, size_t connections_size);
 long long count_adjacencies(bool **adjacency_matrix, short original_element, short this_element, short *neighbors_to_try, size_t neighbors_to_try_size);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -37,25 +46,55 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Connection_Vec *connections = malloc(sizeof(Connection_Vec));
+    if (parse_input(input_file, connections))
+    {
+        free(connections);
+        return NULL;
+    }
+    return connections;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Connection_Vec *connections = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", count_sets_of_3(connections->arr, connections->len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((Connection_Vec *)puzzle)->arr);
+    free(puzzle);
+}
+
+DEF_SOLVER(23, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param connections Out: the vector of connections in input.txt
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, Connection_Vec *connections)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
-
-    *connections = new_Connection_Vec();
 
-    Connection conn;
-    while (fscanf(f, "%2c-%2c\n", conn.lhs, conn.rhs) == 2)
+    // Each line is "ab-cd"
+    Span span = input_span(&input);
+    *connections = with_capacity_Connection_Vec(count_lines(span));
+    Span line;
+    while (next_line(&span, &line) && span_size(line) == 5 && line.start[2] == '-')
+    {
+        Connection conn;
+        memcpy(conn.lhs, line.start, 2);
+        memcpy(conn.rhs, line.start + 3, 2);
         append_Connection_Vec(connections, conn);
+    }
+
+    close_input(&input);
     return 0;
 }
 
@@ -4,6 +4,9 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
 
 // 26 * 26
 #define ADJACENCY_MAT_SIZE 676
@@ -21,6 +24,7 @@ typedef struct Connection
 } Connection;
 
 DEF_VEC(Connection)
+DEF_VEC_CAPACITY(Connection)
 DEF_VEC(short)
 
 int parse_input(char *input_file, Connection_Vec *connections);
@@ -30,6 +34,10 @@ short *find_lan_party(Connection *connections, size_t connections_size, int *ret
 bool is_neighbor_of_all(bool **adjacency_matrix, short *computers, int computers_size, short new_computer);
 bool is_clique(bool **adjacency_matrix, short *computers, int computers_size);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -54,25 +62,64 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Connection_Vec *connections = malloc(sizeof(Connection_Vec));
+    if (parse_input(input_file, connections))
+    {
+        free(connections);
+        return NULL;
+    }
+    return connections;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Connection_Vec *connections = puzzle;
+    int lan_party_size;
+    short *lan_party = find_lan_party(connections->arr, connections->len, &lan_party_size);
+
+    // Write the password as comma separated names, stopping if the answer is full
+    size_t answer_len = 0;
+    answer[0] = '\0';
+    for (int i = 0; i < lan_party_size && answer_len + 4 <= ANSWER_SIZE; i++)
+        answer_len += snprintf(answer + answer_len, ANSWER_SIZE - answer_len, i ? ",%c%c" : "%c%c", (lan_party[i] / 26) + 'a', (lan_party[i] % 26) + 'a');
+
+    free(lan_party);
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((Connection_Vec *)puzzle)->arr);
+    free(puzzle);
+}
+
+DEF_SOLVER(23, 2, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param connections Out: the vector of connections in input.txt
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, Connection_Vec *connections)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
-
-    *connections = new_Connection_Vec();
 
-    Connection conn;
-    while (fscanf(f, "%2c-%2c\n", conn.lhs, conn.rhs) == 2)
+    // Each line is "ab-cd"
+    Span span = input_span(&input);
+    *connections = with_capacity_Connection_Vec(count_lines(span));
+    Span line;
+    while (next_line(&span, &line) && span_size(line) == 5 && line.start[2] == '-')
+    {
+        Connection conn;
+        memcpy(conn.lhs, line.start, 2);
+        memcpy(conn.rhs, line.start + 3, 2);
         append_Connection_Vec(connections, conn);
+    }
+
+    close_input(&input);
     return 0;
 }
 
@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "../runner/generator.h"
+
+// z is stored in a long long, so it can have at most 63 bits, one more than x and y
+#define MAX_BITS 62
+// The number of pairs of gates with their outputs swapped
+#define SWAP_COUNT 4
+// Internal wires are named with 3 lowercase letters, but can't start with x, y, or z
+#define NAME_COUNT (23 * 26 * 26)
+
+typedef struct Gate
+{
+    // Wire ids. x00 to x(bits-1) first, then y, then z, then internal wires
+    int lhs, rhs, result;
+    const char *type;
+} Gate;
+
+bool is_acyclic(Gate *gates, int gates_size, int wires_size);
+void print_wire(int wire, int bits, int *names);
+
+int main(int argc, char *argv[])
+{
+    long long bits = parse_generator_args(argc, argv, 45, 2, MAX_BITS, "The number of bits in x and y");
+    if (bits == -1)
+        return 1;
+
+    // The first internal wire. z has one more bit than x and y for the carry
+    int internal = 3 * bits + 1;
+    int gates_size = 2 + 5 * (bits - 1);
+    int wires_size = internal + 4 * (bits - 1) + 1;
+    Gate *gates = malloc(sizeof(gates[0]) * gates_size);
+    int g = 0;
+
+#define X(i) (i)
+#define Y(i) (bits + (i))
+#define Z(i) (2 * bits + (i))
+
+    // Ripple carry adder, the same as generate_adder.c
+    // Bit 0 is a half adder
+    int carry = internal++;
+    gates[g++] = (Gate){X(0), Y(0), Z(0), "XOR"};
+    gates[g++] = (Gate){X(0), Y(0), carry, "AND"};
+    for (int i = 1; i < bits; i++)
+    {
+        int half_sum = internal++;
+        int and_xy = internal++;
+        int and_carry = internal++;
+        // The last carry is the top bit of z
+        int next_carry = i == bits - 1 ? Z(bits) : internal++;
+        gates[g++] = (Gate){X(i), Y(i), half_sum, "XOR"};
+        gates[g++] = (Gate){half_sum, carry, Z(i), "XOR"};
+        gates[g++] = (Gate){X(i), Y(i), and_xy, "AND"};
+        gates[g++] = (Gate){half_sum, carry, and_carry, "AND"};
+        gates[g++] = (Gate){and_xy, and_carry, next_carry, "OR"};
+        carry = next_carry;
+    }
+
+    // Swap the outputs of random pairs of gates, as long as that doesn't create a loop
+    bool *swapped = calloc(gates_size, sizeof(swapped[0]));
+    for (int swaps = 0; swaps < SWAP_COUNT;)
+    {
+        int a = random_range(0, gates_size - 1);
+        int b = random_range(0, gates_size - 1);
+        if (a == b || swapped[a] || swapped[b])
+            continue;
+
+        int temp = gates[a].result;
+        gates[a].result = gates[b].result;
+        gates[b].result = temp;
+        if (!is_acyclic(gates, gates_size, wires_size))
+        {
+            gates[b].result = gates[a].result;
+            gates[a].result = temp;
+            continue;
+        }
+        swapped[a] = swapped[b] = true;
+        swaps++;
+    }
+
+    // Random distinct names for internal wires
+    int *names = malloc(sizeof(names[0]) * NAME_COUNT);
+    for (int i = 0; i < NAME_COUNT; i++)
+        names[i] = i;
+    shuffle_ints(names, NAME_COUNT);
+
+    for (int i = 0; i < bits; i++)
+        printf("x%02d: %d\n", i, (int)(next_random() & 1));
+    for (int i = 0; i < bits; i++)
+        printf("y%02d: %d\n", i, (int)(next_random() & 1));
+    putchar('\n');
+
+    int *order = malloc(sizeof(order[0]) * gates_size);
+    for (int i = 0; i < gates_size; i++)
+        order[i] = i;
+    shuffle_ints(order, gates_size);
+    for (int i = 0; i < gates_size; i++)
+    {
+        Gate gate = gates[order[i]];
+        // Either operand order
+        if (next_random() & 1)
+        {
+            int temp = gate.lhs;
+            gate.lhs = gate.rhs;
+            gate.rhs = temp;
+        }
+        print_wire(gate.lhs, bits, names);
+        printf(" %s ", gate.type);
+        print_wire(gate.rhs, bits, names);
+        printf(" -> ");
+        print_wire(gate.result, bits, names);
+        putchar('\n');
+    }
+
+#undef X
+#undef Y
+#undef Z
+
+    free(gates);
+    free(swapped);
+    free(names);
+    free(order);
+    return 0;
+}
+
+/// @brief Check that every gate can be evaluated (Kahn's algorithm)
+/// @param gates The gates
+/// @param gates_size The number of elements in `gates`
+/// @param wires_size The number of wire ids
+/// @return true if there are no loops
+bool is_acyclic(Gate *gates, int gates_size, int wires_size)
+{
+    // Gate that sets each wire, or -1 for inputs
+    int *source = malloc(sizeof(source[0]) * wires_size);
+    bool *done = calloc(gates_size, sizeof(done[0]));
+    bool *known = calloc(wires_size, sizeof(known[0]));
+    for (int i = 0; i < wires_size; i++)
+        source[i] = -1;
+    for (int i = 0; i < gates_size; i++)
+        source[gates[i].result] = i;
+    for (int i = 0; i < wires_size; i++)
+        known[i] = source[i] == -1;
+
+    // Repeatedly evaluate every gate whose inputs are known. There are few enough gates that this is fast enough
+    int done_count = 0;
+    bool progress = true;
+    while (progress)
+    {
+        progress = false;
+        for (int i = 0; i < gates_size; i++)
+            if (!done[i] && known[gates[i].lhs] && known[gates[i].rhs])
+            {
+                done[i] = known[gates[i].result] = progress = true;
+                done_count++;
+            }
+    }
+
+    free(source);
+    free(done);
+    free(known);
+    return done_count == gates_size;
+}
+
+/// @brief Print the name of a wire
+/// @param wire The wire id
+/// @param bits The number of bits in x and y
+/// @param names The name index of each internal wire
+void print_wire(int wire, int bits, int *names)
+{
+    if (wire < bits)
+        printf("x%02d", wire);
+    else if (wire < 2 * bits)
+        printf("y%02d", wire - bits);
+    else if (wire < 3 * bits + 1)
+        printf("z%02d", wire - 2 * bits);
+    else
+    {
+        // The first letter is at most 'w', so it is never x, y, or z
+        int name = names[wire - (3 * bits + 1)];
+        printf("%c%c%c", 'a' + name / (26 * 26), 'a' + name / 26 % 26, 'a' + name % 26);
+    }
+}
@@ -3,6 +3,10 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
+#include "../runner/arena.h"
 
 typedef enum OperationType
 {
@@ -26,10 +30,22 @@ typedef struct OperationListNode
 } OperationListNode;
 
 DEF_VEC(Operation)
+DEF_VEC_CAPACITY(Operation)
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    long long x, y;
+    Operation_Vec operations;
+} Puzzle;
 
 int parse_input(char *input_file, long long *x, long long *y, Operation_Vec *operations);
 long long perform_all_operations(long long x, long long y, Operation *operations, size_t operations_size);
-OperationListNode *to_linked_list(Operation *arr, size_t size, OperationListNode **tail);
+OperationListNode *to_linked_list(Arena *arena, Operation *arr, size_t size, OperationListNode **tail);
+
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
 
 int main(int argc, char *argv[])
 {
@@ -48,6 +64,32 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->x, &puzzle->y, &puzzle->operations))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", perform_all_operations(p->x, p->y, p->operations.arr, p->operations.len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    free(((Puzzle *)puzzle)->operations.arr);
+    free(puzzle);
+}
+
+DEF_SOLVER(24, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param x Out: The x value
@@ -56,83 +98,95 @@ int main(int argc, char *argv[])
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, long long *x, long long *y, Operation_Vec *operations)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    // Parse x and y initial state
+    Span span = input_span(&input);
+    Span line;
+
+    // Parse x and y initial state, "x00: 1", until the blank line
+    *x = 0;
+    *y = 0;
+    while (next_line(&span, &line) && line.start != line.end)
     {
-        *x = 0;
-        *y = 0;
-        int variable_name = getc(f);
-        int index;
-        int value;
+        // Find variable by name
         long long *variable;
-        while (variable_name != '\n' && variable_name != EOF)
+        if (*line.start == 'x')
+            variable = x;
+        else if (*line.start == 'y')
+            variable = y;
+        else
         {
-            // Find variable by name
-            if (variable_name == 'x')
-                variable = x;
-            else if (variable_name == 'y')
-                variable = y;
-            else
-            {
-                fprintf(stderr, "Unexpected variable: '%c'\n", (char)variable_name);
-                fclose(f);
-                return 1;
-            }
-
-            fscanf(f, "%2d: %1d", &index, &value);
-
-            // Put the value into the variable
-            if (value)
-                *variable |= 1LL << index;
-
-            // getc(...) to check for double newline
-            getc(f);
-            variable_name = getc(f);
+            fprintf(stderr, "Unexpected variable: '%c'\n", *line.start);
+            close_input(&input);
+            return 1;
         }
+
+        Span text = line;
+        line.start++;
+        long long index, value;
+        if (!parse_number(&line, &index) || !skip_prefix(&line, ": ") || !parse_number(&line, &value))
+        {
+            fprintf(stderr, "Unexpected initial value: '%.*s'\n", (int)span_size(text), text.start);
+            close_input(&input);
+            return 1;
+        }
+
+        // Put the value into the variable
+        if (value)
+            *variable |= 1LL << index;
     }
 
-    // Parse operations
+    // Parse operations, "lhs OP rhs -> result", where every wire name is 3 characters
+    *operations = with_capacity_Operation_Vec(count_lines(span));
+    while (next_line(&span, &line) && span_size(line) > 3)
     {
-        *operations = new_Operation_Vec();
         Operation op;
-        char operation_type[4];
+        Span text = line;
+        memcpy(op.lhs, line.start, 3);
+        line.start += 3;
+
+        // Parse operation type
+        if (skip_prefix(&line, " AND "))
+            op.type = AND;
+        else if (skip_prefix(&line, " OR "))
+            op.type = OR;
+        else if (skip_prefix(&line, " XOR "))
+            op.type = XOR;
+        else
+        {
+            fprintf(stderr, "Unknown operation type in '%.*s'\n", (int)span_size(text), text.start);
+            free(operations->arr);
+            close_input(&input);
+            return 1;
+        }
 
-        while (fscanf(f, "%3s %3s %3s -> %3s", op.lhs, operation_type, op.rhs, op.result) == 4)
+        // The rest is "rhs -> result"
+        if (span_size(line) != 10 || memcmp(line.start + 3, " -> ", 4))
         {
-            // Parse operation type
-            if (!strcmp("AND", operation_type))
-                op.type = AND;
-            else if (!strcmp("OR", operation_type))
-                op.type = OR;
-            else if (!strcmp("XOR", operation_type))
-                op.type = XOR;
-            else
-            {
-                fprintf(stderr, "Unknown operation type '%4s'\n", operation_type);
-                free(operations->arr);
-                return 1;
-            }
-            append_Operation_Vec(operations, op);
+            fprintf(stderr, "Unexpected operation '%.*s'\n", (int)span_size(text), text.start);
+            free(operations->arr);
+            close_input(&input);
+            return 1;
         }
+        memcpy(op.rhs, line.start, 3);
+        memcpy(op.result, line.start + 7, 3);
+        op.lhs[3] = op.rhs[3] = op.result[3] = '\0';
+        append_Operation_Vec(operations, op);
     }
 
-    fclose(f);
+    close_input(&input);
     return 0;
 }
 
 /// @brief Convert operation array to linked list
+/// @param arena The arena to allocate the nodes from
 /// @param arr The array of operations
 /// @param size Tne number of elements in `operations`
 /// @param tail Out: The tail node of the linked list
 /// @return The head node of the linked list
-OperationListNode *to_linked_list(Operation *arr, size_t size, OperationListNode **tail)
+OperationListNode *to_linked_list(Arena *arena, Operation *arr, size_t size, OperationListNode **tail)
 {
     // Return NULL,NULL if there is no array
     if (size <= 0)
@@ -142,14 +196,14 @@ OperationListNode *to_linked_list(Operation *arr, size_t size, OperationListNode
     }
 
     // Put the head
-    OperationListNode *head = malloc(sizeof(*head));
+    OperationListNode *head = ARENA_NEW(arena, OperationListNode);
     head->op = arr[0];
 
     // Put the rest of the nodes
     OperationListNode *node = head;
     for (size_t i = 1; i < size; i++)
     {
-        node = node->next = malloc(sizeof(*node));
+        node = node->next = ARENA_NEW(arena, OperationListNode);
         node->op = arr[i];
     }
     // Finish the tail node
@@ -160,6 +214,8 @@ OperationListNode *to_linked_list(Operation *arr, size_t size, OperationListNode
 }
 
 #define INDEX_BY_STR(arr, str) (arr)[(((str)[0] - 'a') * 26 * 26) + (((str)[1] - 'a') * 26) + ((str[2] - 'a'))]
+// The bit of x, y, or z for a wire like "x07". Wire names always have 2 digits
+#define WIRE_BIT(str) ((((str)[1] - '0') * 10) + ((str)[2] - '0'))
 
 /// @brief Perform all operations in `operations` and find the final value of `z`
 /// @param x The initial state of x
@@ -171,9 +227,10 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 {
     long long z = 0;
 
-    // Linked list
+    // Linked list. Nodes are only freed at the end, all at once
+    Arena arena = new_arena(operations_size * sizeof(OperationListNode));
     OperationListNode *tail;
-    OperationListNode *head = to_linked_list(operations, operations_size, &tail);
+    OperationListNode *head = to_linked_list(&arena, operations, operations_size, &tail);
     char other_variables[26 * 26 * 26];
     // -1 means not set yet
     memset(other_variables, -1, 26 * 26 * 26);
@@ -187,9 +244,9 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 
         // Get lhs
         if (op.lhs[0] == 'x')
-            lhs = (x >> atoi(op.lhs + 1)) & 1;
+            lhs = (x >> WIRE_BIT(op.lhs)) & 1;
         else if (op.lhs[0] == 'y')
-            lhs = (y >> atoi(op.lhs + 1)) & 1;
+            lhs = (y >> WIRE_BIT(op.lhs)) & 1;
         else
             lhs = INDEX_BY_STR(other_variables, op.lhs);
 
@@ -205,9 +262,9 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 
         // Get rhs
         if (op.rhs[0] == 'x')
-            rhs = (x >> atoi(op.rhs + 1)) & 1;
+            rhs = (x >> WIRE_BIT(op.rhs)) & 1;
         else if (op.rhs[0] == 'y')
-            rhs = (y >> atoi(op.rhs + 1)) & 1;
+            rhs = (y >> WIRE_BIT(op.rhs)) & 1;
         else
             rhs = INDEX_BY_STR(other_variables, op.rhs);
 
@@ -236,13 +293,13 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 
         // Store result
         if (op.result[0] == 'z')
-            z |= (long long)result << atoi(op.result + 1);
+            z |= (long long)result << WIRE_BIT(op.result);
         else
             INDEX_BY_STR(other_variables, op.result) = result;
 
-        free(head);
         head = next;
     }
 
+    delete_arena(&arena);
     return z;
 }
@@ -3,7 +3,9 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
-#include "../c-data-structures/hash_map/hash_map.h"
+#include "../runner/vector.h"
+#include "../runner/input.h"
+#include "../runner/hashmap.h"
 
 #define ADDER_REF_NAME "45-bit_adder.txt"
 
@@ -29,6 +31,7 @@ typedef struct OperationListNode
 } OperationListNode;
 
 DEF_VEC(Operation)
+DEF_VEC_CAPACITY(Operation)
 
 typedef struct OperationTreeNode
 {
@@ -37,6 +40,10 @@ typedef struct OperationTreeNode
     char result[4];
 } OperationTreeNode;
 
+// Each operation tree, keyed by the 3 character name of its result
+typedef OperationTreeNode *OperationTree;
+DEF_HASHMAP(StrKey, OperationTree)
+
 // Part 1
 int parse_input(char *input_file, long long *x, long long *y, Operation_Vec *operations);
 long long perform_all_operations(long long x, long long y, Operation *operations, size_t operations_size);
@@ -45,7 +52,9 @@ OperationListNode *to_linked_list(Operation *arr, size_t size, OperationListNode
 // Part 2
 void print_z_equations(Operation *operations, size_t operations_size);
 int print_equation(Operation *operations, size_t operations_size, char *result);
-HashMap get_operation_tree(Operation *operations, size_t operations_size);
+StrKey_OperationTree_HashMap get_operation_tree(Operation *operations, size_t operations_size);
+OperationTreeNode *get_operation_node(StrKey_OperationTree_HashMap *map, char *name);
+void delete_operation_tree(StrKey_OperationTree_HashMap *map);
 void print_operation_tree(OperationTreeNode *root);
 void print_all_incorrect_operations(Operation *operations, size_t operations_size);
 int are_operation_trees_equal(OperationTreeNode *expected, OperationTreeNode *actual);
@@ -65,8 +74,8 @@ int main(int argc, char *argv[])
 
     print_all_incorrect_operations(operations.arr, operations.len);
 
-    HashMap map = get_operation_tree(operations.arr, operations.len);
-    delete_HashMap_and_values(&map);
+    StrKey_OperationTree_HashMap map = get_operation_tree(operations.arr, operations.len);
+    delete_operation_tree(&map);
 
     free(operations.arr);
     return 0;
@@ -80,74 +89,85 @@ int main(int argc, char *argv[])
 /// @return 0 if successful, 1 if unsuccessful
 int parse_input(char *input_file, long long *x, long long *y, Operation_Vec *operations)
 {
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
 
-    // Parse x and y initial state
+    Span span = input_span(&input);
+    Span line;
+
+    // Parse x and y initial state, "x00: 1", until the blank line
+    *x = 0;
+    *y = 0;
+    while (next_line(&span, &line) && line.start != line.end)
     {
-        *x = 0;
-        *y = 0;
-        int variable_name = getc(f);
-        int index;
-        int value;
+        // Find variable by name
         long long *variable;
-        while (variable_name != '\n' && variable_name != EOF)
+        if (*line.start == 'x')
+            variable = x;
+        else if (*line.start == 'y')
+            variable = y;
+        else
         {
-            // Find variable by name
-            if (variable_name == 'x')
-                variable = x;
-            else if (variable_name == 'y')
-                variable = y;
-            else
-            {
-                fprintf(stderr, "Unexpected variable: '%c'\n", (char)variable_name);
-                fclose(f);
-                return 1;
-            }
-
-            fscanf(f, "%2d: %1d", &index, &value);
-
-            // Put the value into the variable
-            if (value)
-                *variable |= 1LL << index;
+            fprintf(stderr, "Unexpected variable: '%c'\n", *line.start);
+            close_input(&input);
+            return 1;
+        }
 
-            // getc(...) to check for double newline
-            getc(f);
-            variable_name = getc(f);
+        Span text = line;
+        line.start++;
+        long long index, value;
+        if (!parse_number(&line, &index) || !skip_prefix(&line, ": ") || !parse_number(&line, &value))
+        {
+            fprintf(stderr, "Unexpected initial value: '%.*s'\n", (int)span_size(text), text.start);
+            close_input(&input);
+            return 1;
         }
+
+        // Put the value into the variable
+        if (value)
+            *variable |= 1LL << index;
     }
 
-    // Parse operations
+    // Parse operations, "lhs OP rhs -> result", where every wire name is 3 characters
+    *operations = with_capacity_Operation_Vec(count_lines(span));
+    while (next_line(&span, &line) && span_size(line) > 3)
     {
-        *operations = new_Operation_Vec();
         Operation op;
-        char operation_type[4];
+        Span text = line;
+        memcpy(op.lhs, line.start, 3);
+        line.start += 3;
+
+        // Parse operation type
+        if (skip_prefix(&line, " AND "))
+            op.type = AND;
+        else if (skip_prefix(&line, " OR "))
+            op.type = OR;
+        else if (skip_prefix(&line, " XOR "))
+            op.type = XOR;
+        else
+        {
+            fprintf(stderr, "Unknown operation type in '%.*s'\n", (int)span_size(text), text.start);
+            free(operations->arr);
+            close_input(&input);
+            return 1;
+        }
 
-        while (fscanf(f, "%3s %3s %3s -> %3s", op.lhs, operation_type, op.rhs, op.result) == 4)
+        // The rest is "rhs -> result"
+        if (span_size(line) != 10 || memcmp(line.start + 3, " -> ", 4))
         {
-            // Parse operation type
-            if (!strcmp("AND", operation_type))
-                op.type = AND;
-            else if (!strcmp("OR", operation_type))
-                op.type = OR;
-            else if (!strcmp("XOR", operation_type))
-                op.type = XOR;
-            else
-            {
-                fprintf(stderr, "Unknown operation type '%4s'\n", operation_type);
-                free(operations->arr);
-                return 1;
-            }
-            append_Operation_Vec(operations, op);
+            fprintf(stderr, "Unexpected operation '%.*s'\n", (int)span_size(text), text.start);
+            free(operations->arr);
+            close_input(&input);
+            return 1;
         }
+        memcpy(op.rhs, line.start, 3);
+        memcpy(op.result, line.start + 7, 3);
+        op.lhs[3] = op.rhs[3] = op.result[3] = '\0';
+        append_Operation_Vec(operations, op);
     }
 
-    fclose(f);
+    close_input(&input);
     return 0;
 }
 
@@ -184,6 +204,8 @@ OperationListNode *to_linked_list(Operation *arr, size_t size, OperationListNode
 }
 
 #define INDEX_BY_STR(arr, str) (arr)[(((str)[0] - 'a') * 26 * 26) + (((str)[1] - 'a') * 26) + ((str[2] - 'a'))]
+// The bit of x, y, or z for a wire like "x07". Wire names always have 2 digits
+#define WIRE_BIT(str) ((((str)[1] - '0') * 10) + ((str)[2] - '0'))
 
 /// @brief Perform all operations in `operations` and find the final value of `z`
 /// @param x The initial state of x
@@ -211,9 +233,9 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 
         // Get lhs
         if (op.lhs[0] == 'x')
-            lhs = (x >> atoi(op.lhs + 1)) & 1;
+            lhs = (x >> WIRE_BIT(op.lhs)) & 1;
         else if (op.lhs[0] == 'y')
-            lhs = (y >> atoi(op.lhs + 1)) & 1;
+            lhs = (y >> WIRE_BIT(op.lhs)) & 1;
         else
             lhs = INDEX_BY_STR(other_variables, op.lhs);
 
@@ -229,9 +251,9 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 
         // Get rhs
         if (op.rhs[0] == 'x')
-            rhs = (x >> atoi(op.rhs + 1)) & 1;
+            rhs = (x >> WIRE_BIT(op.rhs)) & 1;
         else if (op.rhs[0] == 'y')
-            rhs = (y >> atoi(op.rhs + 1)) & 1;
+            rhs = (y >> WIRE_BIT(op.rhs)) & 1;
         else
             rhs = INDEX_BY_STR(other_variables, op.rhs);
 
@@ -260,7 +282,7 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 
         // Store result
         if (op.result[0] == 'z')
-            z |= (long long)result << atoi(op.result + 1);
+            z |= (long long)result << WIRE_BIT(op.result);
         else
             INDEX_BY_STR(other_variables, op.result) = result;
 
@@ -276,7 +298,7 @@ long long perform_all_operations(long long x, long long y, Operation *operations
 /// @param operations_size The number of elements in `operations`
 void print_z_equations(Operation *operations, size_t operations_size)
 {
-    HashMap operations_map = get_operation_tree(operations, operations_size);
+    StrKey_OperationTree_HashMap operations_map = get_operation_tree(operations, operations_size);
     char z_identifier[4];
     // Infinite loop, will break when we can't find an additional z
     // printf("{\n");
@@ -289,7 +311,7 @@ void print_z_equations(Operation *operations, size_t operations_size)
         snprintf(z_identifier, sizeof(z_identifier), "z%02d", i);
 #pragma GCC diagnostic pop
 
-        OperationTreeNode *operation_node = get_map_as_ptr(&operations_map, z_identifier);
+        OperationTreeNode *operation_node = get_operation_node(&operations_map, z_identifier);
         if (operation_node)
         {
             printf("\"%s\": ", z_identifier);
@@ -302,7 +324,7 @@ void print_z_equations(Operation *operations, size_t operations_size)
     }
     // printf("}\n");
 
-    delete_HashMap_and_values(&operations_map);
+    delete_operation_tree(&operations_map);
 }
 
 /// @brief Recursively print an equation resulting in `result` to stdout
@@ -370,10 +392,12 @@ int print_equation(Operation *operations, size_t operations_size, char *result)
 /// @brief Convert an array of operations into a hashmap of connected OperationTreeNodes
 /// @param operations The array of operations to do
 /// @param operations_size The number of elements in `operations`
-/// @return A HashMap containing each operation tree
-HashMap get_operation_tree(Operation *operations, size_t operations_size)
+/// @return A map containing each operation tree. Delete with delete_operation_tree
+StrKey_OperationTree_HashMap get_operation_tree(Operation *operations, size_t operations_size)
 {
-    HashMap map = new_HashMap();
+    StrKey_OperationTree_HashMap map = new_StrKey_OperationTree_HashMap();
+    // Every result and input has an entry
+    reserve_StrKey_OperationTree_HashMap(&map, operations_size * 2);
 
     // Linked list
     OperationListNode *tail;
@@ -386,7 +410,7 @@ HashMap get_operation_tree(Operation *operations, size_t operations_size)
         // char lhs, rhs, result;
         Operation op = head->op;
 
-        OperationTreeNode *lhs = get_map_as_ptr(&map, op.lhs);
+        OperationTreeNode *lhs = get_operation_node(&map, op.lhs);
         if (!lhs)
         {
             // x.. or y.. not being found is expected, other variables should be found at some point
@@ -396,7 +420,7 @@ HashMap get_operation_tree(Operation *operations, size_t operations_size)
                 lhs = calloc(1, sizeof(*lhs));
                 memcpy(lhs->result, op.lhs, sizeof(op.lhs));
 
-                put_map_as_ptr(&map, op.lhs, lhs);
+                put_StrKey_OperationTree_HashMap(&map, str_key(op.lhs), lhs);
             }
             else
             {
@@ -409,7 +433,7 @@ HashMap get_operation_tree(Operation *operations, size_t operations_size)
         }
 
         // Do the same thing for rhs
-        OperationTreeNode *rhs = get_map_as_ptr(&map, op.rhs);
+        OperationTreeNode *rhs = get_operation_node(&map, op.rhs);
         if (!rhs)
         {
             // x.. or y.. not being found is expected, other variables should be found at some point
@@ -419,7 +443,7 @@ HashMap get_operation_tree(Operation *operations, size_t operations_size)
                 rhs = calloc(1, sizeof(*rhs));
                 memcpy(rhs->result, op.rhs, sizeof(op.rhs));
 
-                put_map_as_ptr(&map, op.rhs, rhs);
+                put_StrKey_OperationTree_HashMap(&map, str_key(op.rhs), rhs);
             }
             else
             {
@@ -439,7 +463,7 @@ HashMap get_operation_tree(Operation *operations, size_t operations_size)
         this_op->type = op.type;
 
         // Store result
-        put_map_as_ptr(&map, op.result, this_op);
+        put_StrKey_OperationTree_HashMap(&map, str_key(op.result), this_op);
 
         free(head);
         head = next;
@@ -448,6 +472,22 @@ HashMap get_operation_tree(Operation *operations, size_t operations_size)
     return map;
 }
 
+// Get the operation tree that results in `name`, or NULL if there is none
+OperationTreeNode *get_operation_node(StrKey_OperationTree_HashMap *map, char *name)
+{
+    OperationTreeNode *node;
+    return get_StrKey_OperationTree_HashMap(map, str_key(name), &node) ? node : NULL;
+}
+
+// Free every node in the map from get_operation_tree, then the map itself
+void delete_operation_tree(StrKey_OperationTree_HashMap *map)
+{
+    for (size_t i = 0; i < map->cap; i++)
+        if (map->entries[i].hash)
+            free(map->entries[i].value);
+    delete_StrKey_OperationTree_HashMap(map);
+}
+
 /// @brief Recursively print the tree of operations to stdout
 /// @param root The root of the operations tree
 void print_operation_tree(OperationTreeNode *root)
@@ -558,8 +598,8 @@ void print_all_incorrect_operations(Operation *operations, size_t operations_siz
     }
 
     // Convert those into maps
-    HashMap actual_operations = get_operation_tree(operations, operations_size);
-    HashMap expected_operations = get_operation_tree(expected_operations_vec.arr, expected_operations_vec.len);
+    StrKey_OperationTree_HashMap actual_operations = get_operation_tree(operations, operations_size);
+    StrKey_OperationTree_HashMap expected_operations = get_operation_tree(expected_operations_vec.arr, expected_operations_vec.len);
 
     // Iterate over nodes
     char z_identifier[4];
@@ -572,8 +612,8 @@ void print_all_incorrect_operations(Operation *operations, size_t operations_siz
 #pragma GCC diagnostic ignored "-Wformat-truncation"
         snprintf(z_identifier, sizeof(z_identifier), "z%02d", i);
 #pragma GCC diagnostic pop
-        actual_node = get_map_as_ptr(&actual_operations, z_identifier);
-        expected_node = get_map_as_ptr(&expected_operations, z_identifier);
+        actual_node = get_operation_node(&actual_operations, z_identifier);
+        expected_node = get_operation_node(&expected_operations, z_identifier);
 
         // Stop when we can't find any more bits
         if (!actual_node || !expected_node)
@@ -585,7 +625,7 @@ void print_all_incorrect_operations(Operation *operations, size_t operations_siz
             printf("%s\n", z_identifier);
     }
 
-    delete_HashMap_and_values(&actual_operations);
-    delete_HashMap_and_values(&expected_operations);
+    delete_operation_tree(&actual_operations);
+    delete_operation_tree(&expected_operations);
     free(expected_operations_vec.arr);
 }
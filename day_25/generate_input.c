@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../runner/generator.h"
+
+// These match day 25's KEY_WIDTH and KEY_HEIGHT
+#define KEY_WIDTH 5
+#define KEY_HEIGHT 7
+
+int main(int argc, char *argv[])
+{
+    long long schematics = parse_generator_args(argc, argv, 500, 1, 100000000, "The number of keys and locks");
+    if (schematics == -1)
+        return 1;
+
+    int heights[KEY_WIDTH];
+    for (long long i = 0; i < schematics; i++)
+    {
+        // Locks are filled from the top, keys from the bottom
+        int is_lock = next_random() & 1;
+        for (int col = 0; col < KEY_WIDTH; col++)
+            heights[col] = random_range(0, KEY_HEIGHT - 2);
+
+        if (i)
+            putchar('\n');
+        for (int row = 0; row < KEY_HEIGHT; row++)
+        {
+            // The row counted from the filled side, where the top or bottom row is always filled
+            int depth = is_lock ? row : KEY_HEIGHT - 1 - row;
+            for (int col = 0; col < KEY_WIDTH; col++)
+                putchar(depth <= heights[col] ? '#' : '.');
+            putchar('\n');
+        }
+    }
+
+    return 0;
+}
@@ -3,6 +3,9 @@
 #include <string.h>
 
 #include "../c-data-structures/vector/vector_template.h"
+#include "../runner/vector.h"
+#include "../runner/solver.h"
+#include "../runner/input.h"
 
 #define KEY_WIDTH 5
 #define KEY_HEIGHT 7
@@ -13,12 +16,23 @@ typedef struct KeyLock
 } KeyLock;
 
 DEF_VEC(KeyLock)
+DEF_VEC_CAPACITY(KeyLock)
+
+// The parsed input for the runner
+typedef struct Puzzle
+{
+    KeyLock_Vec keys, locks;
+} Puzzle;
 
 int parse_input(char *input_file, KeyLock_Vec *keys, KeyLock_Vec *locks);
 long long count_unique_valid_pairs(KeyLock *keys, size_t keys_size, KeyLock *locks, size_t locks_size);
 int is_valid_pair(KeyLock key, KeyLock lock);
 void print_key_lock(KeyLock key_lock);
 
+void *parse_puzzle(char *input_file);
+int solve_puzzle(void *puzzle, char *answer);
+void delete_puzzle(void *puzzle);
+
 int main(int argc, char *argv[])
 {
     char *input_file = (argc >= 2) ? argv[1] : NULL;
@@ -50,6 +64,34 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+void *parse_puzzle(char *input_file)
+{
+    Puzzle *puzzle = malloc(sizeof(Puzzle));
+    if (parse_input(input_file, &puzzle->keys, &puzzle->locks))
+    {
+        free(puzzle);
+        return NULL;
+    }
+    return puzzle;
+}
+
+int solve_puzzle(void *puzzle, char *answer)
+{
+    Puzzle *p = puzzle;
+    snprintf(answer, ANSWER_SIZE, "%lld", count_unique_valid_pairs(p->keys.arr, p->keys.len, p->locks.arr, p->locks.len));
+    return 0;
+}
+
+void delete_puzzle(void *puzzle)
+{
+    Puzzle *p = puzzle;
+    free(p->keys.arr);
+    free(p->locks.arr);
+    free(p);
+}
+
+DEF_SOLVER(25, 1, parse_puzzle, solve_puzzle, delete_puzzle)
+
 /// @brief Parse the input file
 /// @param input_file The path of the file to input from. If null, stdin will be used
 /// @param keys Out: A vector if keys
@@ -58,90 +100,59 @@ int main(int argc, char *argv[])
 int parse_input(char *input_file, KeyLock_Vec *keys, KeyLock_Vec *locks)
 {
     int is_error = 0;
-    // Open input.txt or panic
-    FILE *f = input_file ? fopen(input_file, "r") : stdin;
-    if (f == NULL)
-    {
-        perror("Error opening input file");
+    Input input;
+    if (open_input(input_file, &input))
         return 1;
-    }
-
-    *keys = new_KeyLock_Vec();
-    *locks = new_KeyLock_Vec();
 
-    char input_buffer[KEY_WIDTH + 2];
+    // Every schematic is KEY_HEIGHT rows and a blank line. Either kind could be all of them
+    Span span = input_span(&input);
+    size_t schematics = (span_size(span) + 1) / ((KEY_WIDTH + 1) * KEY_HEIGHT + 1) + 1;
+    *keys = with_capacity_KeyLock_Vec(schematics);
+    *locks = with_capacity_KeyLock_Vec(schematics);
+    GridView schematic;
 
-    while (fgets(input_buffer, sizeof(input_buffer), f))
+    while (next_grid(&span, &schematic))
     {
+        if (schematic.rows != KEY_HEIGHT || schematic.cols != KEY_WIDTH)
+        {
+            fprintf(stderr, "Incorrectly formed key/lock found: Expected %dx%d, found %zux%zu\n", KEY_WIDTH, KEY_HEIGHT, schematic.cols, schematic.rows);
+            is_error = 1;
+            goto CLOSE_FILE;
+        }
+
         KeyLock this_key_lock = {{0}};
-        int is_key;
-
-        // Determine if key or lock
-        if (!strcmp(input_buffer, "#####\n"))
-            // The locks are schematics that have the top row filled (#)
-            is_key = 0;
-        else if (!strcmp(input_buffer, ".....\n"))
-            // the keys have the top row empty
-            is_key = 1;
-
-        // Parse key/lock
-        for (int i = 0; i < KEY_HEIGHT - 2; i++)
+        // The locks are schematics that have the top row filled (#), and the keys have the top row empty
+        int is_key = GRID_AT(schematic, 0, 0) == '.';
+        char start_char = is_key ? '.' : '#';
+        char end_char = is_key ? '#' : '.';
+
+        for (size_t j = 0; j < KEY_WIDTH; j++)
         {
-            // Get the next line
-            if (!fgets(input_buffer, sizeof(input_buffer), f))
+            // Assert that the first and last lines are correct (opposite of each other)
+            if (GRID_AT(schematic, 0, j) != start_char || GRID_AT(schematic, KEY_HEIGHT - 1, j) != end_char)
             {
-                fprintf(stderr, "Incorrectly formed key/lock found: EOF found too early.\n");
+                fprintf(stderr, "Unexpected start or end to %s at column %zu\n", is_key ? "key" : "lock", j);
                 is_error = 1;
                 goto CLOSE_FILE;
             }
 
-            // Parse the line
-            for (int j = 0; (j < KEY_WIDTH) && input_buffer[j]; j++)
+            // Parse key/lock
+            for (size_t i = 1; i < KEY_HEIGHT - 1; i++)
             {
+                char ch = GRID_AT(schematic, i, j);
                 // If a filled space was found, increment the height of the key or lock
-                if (input_buffer[j] == '#')
+                if (ch == '#')
                     this_key_lock.pins[j]++;
                 // If the space was not '#' or '.', print an error
-                else if (input_buffer[j] != '.')
+                else if (ch != '.')
                 {
-                    fprintf(stderr, "Incorrectly formed key/lock found: Unexpected character '%c'\n", input_buffer[j]);
+                    fprintf(stderr, "Incorrectly formed key/lock found: Unexpected character '%c'\n", ch);
                     is_error = 1;
                     goto CLOSE_FILE;
                 }
             }
         }
 
-        // Get the last line of the key/lock
-        if (!fgets(input_buffer, sizeof(input_buffer), f))
-        {
-            fprintf(stderr, "Incorrectly formed key/lock found: EOF found before end line.\n");
-            is_error = 1;
-            goto CLOSE_FILE;
-        }
-
-        // Assert that the last line is correct (opposite of start line)
-        if (is_key)
-        {
-            if (strcmp(input_buffer, "#####\n"))
-            {
-                fprintf(stderr, "Unexpected end to key: '%s'\n", input_buffer);
-                is_error = 1;
-                goto CLOSE_FILE;
-            }
-        }
-        else
-        {
-            if (strcmp(input_buffer, ".....\n"))
-            {
-                fprintf(stderr, "Unexpected end to lock: '%s'\n", input_buffer);
-                is_error = 1;
-                goto CLOSE_FILE;
-            }
-        }
-
-        // Finally, discard the newline between keys/locks
-        fgets(input_buffer, sizeof(input_buffer), f);
-
         // Put the key/lock into the appropriate vector
         if (is_key)
             append_KeyLock_Vec(keys, this_key_lock);
@@ -150,7 +161,7 @@ int parse_input(char *input_file, KeyLock_Vec *keys, KeyLock_Vec *locks)
     }
 
 CLOSE_FILE:
-    fclose(f);
+    close_input(&input);
     if (is_error)
     {
         free(keys->arr);
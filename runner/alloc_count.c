@@ -0,0 +1,221 @@
+#define _GNU_SOURCE
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#include "alloc_count.h"
+
+// The real allocator, provided by the linker because of --wrap
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__real_aligned_alloc(size_t alignment, size_t size);
+void __real_free(void *ptr);
+
+// Atomic because solvers using parallel_for allocate from several threads
+_Atomic long long alloc_count = 0LL;
+
+// Everything below is only used while profiling, and is protected by profile_lock
+static _Atomic bool profiling = false;
+static atomic_flag profile_lock = ATOMIC_FLAG_INIT;
+static AllocStats profile;
+// Bytes live now, relative to the start of the profile. Negative if more was freed than allocated since then
+static long long live_bytes;
+// An open addressing table of call sites, keyed by address. Unused slots have a NULL address
+static AllocSite sites[ALLOC_PROFILE_SITES];
+
+static void lock_profile()
+{
+    while (atomic_flag_test_and_set_explicit(&profile_lock, memory_order_acquire))
+        ;
+}
+
+static void unlock_profile() { atomic_flag_clear_explicit(&profile_lock, memory_order_release); }
+
+// Record an allocation of `size` bytes (`usable` after rounding up) made from `site`
+static void profile_alloc(void *site, size_t size, size_t usable)
+{
+    lock_profile();
+    profile.allocations++;
+    profile.bytes += size;
+    live_bytes += usable;
+    if (live_bytes > profile.peak_live_bytes)
+        profile.peak_live_bytes = live_bytes;
+
+    size_t mask = ALLOC_PROFILE_SITES - 1;
+    for (size_t i = ((uintptr_t)site >> 2) & mask, probes = 0; probes < ALLOC_PROFILE_SITES; i = (i + 1) & mask, probes++)
+    {
+        if (sites[i].address == site || !sites[i].address)
+        {
+            sites[i].address = site;
+            sites[i].allocations++;
+            sites[i].bytes += size;
+            break;
+        }
+    }
+    unlock_profile();
+}
+
+// Record freeing `usable` bytes
+static void profile_free(size_t usable)
+{
+    lock_profile();
+    profile.frees++;
+    live_bytes -= usable;
+    unlock_profile();
+}
+
+void *__wrap_malloc(size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    void *ptr = __real_malloc(size);
+    if (atomic_load_explicit(&profiling, memory_order_relaxed) && ptr)
+        profile_alloc(__builtin_return_address(0), size, malloc_usable_size(ptr));
+    return ptr;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    void *ptr = __real_calloc(nmemb, size);
+    if (atomic_load_explicit(&profiling, memory_order_relaxed) && ptr)
+        profile_alloc(__builtin_return_address(0), nmemb * size, malloc_usable_size(ptr));
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    if (!atomic_load_explicit(&profiling, memory_order_relaxed))
+        return __real_realloc(ptr, size);
+
+    // Counted as freeing the old block and allocating the new one
+    size_t old_usable = ptr ? malloc_usable_size(ptr) : 0UL;
+    void *new_ptr = __real_realloc(ptr, size);
+    if (new_ptr)
+    {
+        if (ptr)
+            profile_free(old_usable);
+        profile_alloc(__builtin_return_address(0), size, malloc_usable_size(new_ptr));
+    }
+    return new_ptr;
+}
+
+void *__wrap_aligned_alloc(size_t alignment, size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    void *ptr = __real_aligned_alloc(alignment, size);
+    if (atomic_load_explicit(&profiling, memory_order_relaxed) && ptr)
+        profile_alloc(__builtin_return_address(0), size, malloc_usable_size(ptr));
+    return ptr;
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr && atomic_load_explicit(&profiling, memory_order_relaxed))
+        profile_free(malloc_usable_size(ptr));
+    __real_free(ptr);
+}
+
+long long get_alloc_count()
+{
+    return atomic_load(&alloc_count);
+}
+
+// Start profiling, forgetting the last profile
+void start_alloc_profile()
+{
+    lock_profile();
+    memset(&profile, 0, sizeof(profile));
+    memset(sites, 0, sizeof(sites));
+    live_bytes = 0LL;
+    atomic_store(&profiling, true);
+    unlock_profile();
+}
+
+/// @brief Stop profiling. The call sites stay available from get_alloc_sites until the next start_alloc_profile
+/// @return What was allocated since start_alloc_profile
+AllocStats stop_alloc_profile()
+{
+    lock_profile();
+    atomic_store(&profiling, false);
+    AllocStats stats = profile;
+    unlock_profile();
+    return stats;
+}
+
+// Sort call sites by allocations, most first, then by bytes
+static int compare_sites(const void *a, const void *b)
+{
+    const AllocSite *lhs = a;
+    const AllocSite *rhs = b;
+    if (lhs->allocations != rhs->allocations)
+        return (lhs->allocations < rhs->allocations) - (lhs->allocations > rhs->allocations);
+    return (lhs->bytes < rhs->bytes) - (lhs->bytes > rhs->bytes);
+}
+
+/// @brief Get the call sites of the last profile that allocated the most
+/// @param top_sites Out: The sites, most allocations first
+/// @param top_sites_size The most sites to get
+/// @return The number of sites written to `top_sites`
+size_t get_alloc_sites(AllocSite *top_sites, size_t top_sites_size)
+{
+    // Compact the table in place, then sort it. It is cleared by the next start_alloc_profile anyway
+    lock_profile();
+    size_t used = 0;
+    for (size_t i = 0; i < ALLOC_PROFILE_SITES; i++)
+        if (sites[i].address)
+            sites[used++] = sites[i];
+    memset(sites + used, 0, sizeof(sites[0]) * (ALLOC_PROFILE_SITES - used));
+    qsort(sites, used, sizeof(sites[0]), compare_sites);
+
+    size_t count = used < top_sites_size ? used : top_sites_size;
+    memcpy(top_sites, sites, sizeof(sites[0]) * count);
+    unlock_profile();
+    return count;
+}
+
+/// @brief Describe a call site as its function and source line, using addr2line on this program
+/// @param address The return address of the call
+/// @param description Out: "function (file:line)", or the address relative to the program if it can't be looked up
+/// @param description_size The size of `description`
+void describe_alloc_site(void *address, char *description, size_t description_size)
+{
+    // addr2line wants addresses relative to where the program was loaded
+    extern char __executable_start;
+    uintptr_t offset = (uintptr_t)address - (uintptr_t)&__executable_start;
+    snprintf(description, description_size, "0x%lx", (unsigned long)offset);
+
+    char command[128];
+    // The return address is just after the call, so look up the byte before it
+    snprintf(command, sizeof(command), "addr2line -f -e /proc/%d/exe 0x%lx 2>/dev/null", (int)getpid(), (unsigned long)(offset - 1));
+    FILE *f = popen(command, "r");
+    if (f == NULL)
+        return;
+    char function[256], line[512];
+    if (fgets(function, sizeof(function), f) && fgets(line, sizeof(line), f) && strncmp(function, "??", 2))
+    {
+        function[strcspn(function, "\n")] = '\0';
+        // Drop the newline and any " (discriminator N)"
+        line[strcspn(line, " \n")] = '\0';
+        // Without debug info (as in the release build) there is no line, and the file is only a guess
+        size_t line_len = strlen(line);
+        if (line_len >= 2 && !strcmp(line + line_len - 2, ":?"))
+        {
+            snprintf(description, description_size, "%s", function);
+            pclose(f);
+            return;
+        }
+        // Keep only the day's directory and the file name of the source path
+        char *file = line + strlen(line);
+        for (int slashes = 0; file > line && slashes < 2; file--)
+            slashes += file[-1] == '/';
+        snprintf(description, description_size, "%s (%s)", function, file + (*file == '/'));
+    }
+    pclose(f);
+}
@@ -0,0 +1,48 @@
+#ifndef ALLOC_COUNT_H
+#define ALLOC_COUNT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Programs using this are linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=aligned_alloc,--wrap=free
+// so every allocation by the solvers goes through alloc_count.c. No LD_PRELOAD is needed.
+// Counting allocations is always on and costs one atomic increment. Profiling (bytes, peak live bytes, and call sites)
+// is only done between start_alloc_profile and stop_alloc_profile.
+
+// The most call sites a profile keeps. Calls from any more sites are only counted in the totals
+#define ALLOC_PROFILE_SITES 4096
+
+// What was allocated during a profile
+typedef struct AllocStats
+{
+    // Calls to malloc, calloc, realloc, and aligned_alloc
+    long long allocations;
+    // Bytes requested by those calls
+    long long bytes;
+    // Calls to free with a non-null pointer
+    long long frees;
+    // The most bytes that were live at once, counting from the start of the profile.
+    // Sizes are the allocator's usable sizes, which are a little over the sizes requested
+    long long peak_live_bytes;
+} AllocStats;
+
+// One place that calls the allocator
+typedef struct AllocSite
+{
+    // The return address of the call
+    void *address;
+    long long allocations;
+    long long bytes;
+} AllocSite;
+
+/// @brief Get the number of calls to malloc, calloc, realloc, and aligned_alloc since the program started.
+/// Allocations made inside libc itself (e.g. by fopen) are not counted.
+/// @return The number of allocations
+long long get_alloc_count();
+
+void start_alloc_profile();
+AllocStats stop_alloc_profile();
+size_t get_alloc_sites(AllocSite *sites, size_t sites_size);
+void describe_alloc_site(void *address, char *description, size_t description_size);
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+// Bump pointer allocation for structures made of many small nodes (tries, linked lists)
+// Nodes are carved out of large blocks one after another, so they sit next to each other in memory,
+// and all of them are freed at once by resetting or deleting the arena instead of walking the structure.
+// Nodes are never freed individually; a node removed from a structure stays allocated until the arena is reset.
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The size of the first block of an arena when none is given. Each new block is twice the size of the last
+#define ARENA_DEFAULT_BLOCK_SIZE 4096UL
+// Every allocation is aligned to this, which is enough for any type
+#define ARENA_ALIGNMENT _Alignof(max_align_t)
+
+typedef struct ArenaBlock
+{
+    // The block allocated before this one
+    struct ArenaBlock *prev;
+    // The number of bytes in `data`
+    size_t size;
+    // The number of bytes of `data` that have been allocated
+    size_t used;
+    _Alignas(ARENA_ALIGNMENT) char data[];
+} ArenaBlock;
+
+typedef struct Arena
+{
+    // The newest block, which allocations come from
+    ArenaBlock *block;
+    // The size of the next block to allocate
+    size_t next_size;
+} Arena;
+
+// A point to reset an arena back to, from arena_mark
+typedef struct ArenaMark
+{
+    ArenaBlock *block;
+    size_t used;
+} ArenaMark;
+
+// Allocate an uninitialized `type` from an arena
+#define ARENA_NEW(arena, type) ((type *)arena_alloc(arena, sizeof(type)))
+
+/// @brief Make an empty arena. Nothing is allocated until the first arena_alloc
+/// @param block_size The size of the first block, or 0 for ARENA_DEFAULT_BLOCK_SIZE
+/// @return The arena. Delete with delete_arena
+static inline Arena new_arena(size_t block_size)
+{
+    return (Arena){.block = NULL, .next_size = block_size ? block_size : ARENA_DEFAULT_BLOCK_SIZE};
+}
+
+/// @brief Allocate `size` bytes from an arena
+/// @param arena The arena
+/// @param size The number of bytes
+/// @return Uninitialized memory, valid until the arena is reset past this allocation or deleted
+static inline void *arena_alloc(Arena *arena, size_t size)
+{
+    size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    ArenaBlock *block = arena->block;
+    if (!block || block->size - block->used < size)
+    {
+        while (arena->next_size < size)
+            arena->next_size *= 2;
+        block = malloc(sizeof(ArenaBlock) + arena->next_size);
+        block->prev = arena->block;
+        block->size = arena->next_size;
+        block->used = 0UL;
+        arena->block = block;
+        arena->next_size *= 2;
+    }
+    void *ptr = block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+// Allocate `size` zeroed bytes from an arena
+static inline void *arena_calloc(Arena *arena, size_t size)
+{
+    return memset(arena_alloc(arena, size), 0, size);
+}
+
+// Save the current end of an arena, to free everything allocated after this with arena_reset
+static inline ArenaMark arena_mark(Arena *arena)
+{
+    return (ArenaMark){.block = arena->block, .used = arena->block ? arena->block->used : 0UL};
+}
+
+/// @brief Free everything allocated from an arena since `mark` was taken
+///
+/// Blocks allocated after the mark are freed, except that resetting to a mark taken when the arena was empty keeps
+/// the newest (and largest) block, so an arena that is filled and reset repeatedly stops calling malloc.
+/// @param arena The arena
+/// @param mark A mark from arena_mark on this arena. Marks taken after this one can not be used again
+static inline void arena_reset(Arena *arena, ArenaMark mark)
+{
+    if (!mark.block)
+    {
+        // Keep only the newest block
+        ArenaBlock *newest = arena->block;
+        if (!newest)
+            return;
+        ArenaBlock *older = newest->prev;
+        while (older)
+        {
+            ArenaBlock *prev = older->prev;
+            free(older);
+            older = prev;
+        }
+        newest->prev = NULL;
+        newest->used = 0UL;
+        return;
+    }
+    while (arena->block != mark.block)
+    {
+        ArenaBlock *prev = arena->block->prev;
+        free(arena->block);
+        arena->block = prev;
+    }
+    arena->block->used = mark.used;
+}
+
+// Free every block of an arena. It can still be used afterwards, like a new arena
+static inline void delete_arena(Arena *arena)
+{
+    while (arena->block)
+    {
+        ArenaBlock *prev = arena->block->prev;
+        free(arena->block);
+        arena->block = prev;
+    }
+}
+
+#endif
@@ -0,0 +1,361 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "solvers.h"
+#include "result_cache.h"
+
+// The input files to solve
+typedef struct InputList
+{
+    char **files;
+    size_t len;
+    size_t cap;
+} InputList;
+
+// Shared by every worker process, so each input is claimed by exactly one of them
+typedef struct BatchProgress
+{
+    // The index of the next input to claim
+    _Atomic size_t next_input;
+    // The number of inputs that failed to parse or solve
+    _Atomic size_t failures;
+    // The number of answers that came from the result cache
+    _Atomic size_t cached;
+} BatchProgress;
+
+void print_usage(char *program_name);
+void add_input(InputList *inputs, const char *file);
+int add_directory(InputList *inputs, const char *dir);
+int add_manifest(InputList *inputs, const char *manifest_file);
+int compare_strings(const void *a, const void *b);
+void solve_inputs(const Solver *solver, InputList *inputs, BatchProgress *progress, int results_fd, ResultCache *cache, bool refresh);
+int write_all(int fd, const char *buf, size_t size);
+
+int main(int argc, char *argv[])
+{
+    // The number of worker processes
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    // A file listing more inputs, one per line, or NULL for none
+    char *manifest_file = NULL;
+    // The result cache directory, or NULL to not cache
+    char *cache_dir = getenv("AOC_CACHE_DIR");
+    // Whether to solve again and replace cached answers instead of reading them
+    bool refresh = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:m:C:BRh")) != -1)
+    {
+        switch (opt)
+        {
+        case 'j':
+            jobs = atol(optarg);
+            break;
+        case 'm':
+            manifest_file = optarg;
+            break;
+        case 'C':
+            cache_dir = optarg;
+            break;
+        case 'B':
+            cache_dir = NULL;
+            break;
+        case 'R':
+            refresh = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (jobs < 1)
+        jobs = 1;
+
+    // The solver is the first argument, and must be exactly one part
+    bool selected[all_solvers_size];
+    if (optind >= argc || select_solvers(1, argv + optind, selected))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const Solver *solver = NULL;
+    for (size_t i = 0; i < all_solvers_size; i++)
+    {
+        if (!selected[i])
+            continue;
+        if (solver)
+        {
+            fprintf(stderr, "Select one part, e.g. %d.%d\n", solver->day, solver->part);
+            return 1;
+        }
+        solver = all_solvers[i];
+    }
+
+    InputList inputs = {NULL, 0UL, 0UL};
+    int error = manifest_file && add_manifest(&inputs, manifest_file);
+    for (int i = optind + 1; i < argc && !error; i++)
+    {
+        struct stat st;
+        if (stat(argv[i], &st))
+        {
+            perror(argv[i]);
+            error = 1;
+        }
+        else if (S_ISDIR(st.st_mode))
+            error = add_directory(&inputs, argv[i]);
+        else
+            add_input(&inputs, argv[i]);
+    }
+    if (error || !inputs.len)
+    {
+        if (!error)
+            fprintf(stderr, "No inputs given\n");
+        for (size_t i = 0; i < inputs.len; i++)
+            free(inputs.files[i]);
+        free(inputs.files);
+        return 1;
+    }
+    if ((size_t)jobs > inputs.len)
+        jobs = (long)inputs.len;
+
+    BatchProgress *progress = mmap(NULL, sizeof(*progress), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (progress == MAP_FAILED)
+    {
+        perror("Error mapping shared memory");
+        return 1;
+    }
+    atomic_init(&progress->next_input, 0UL);
+    atomic_init(&progress->failures, 0UL);
+    atomic_init(&progress->cached, 0UL);
+
+    ResultCache cache;
+    ResultCache *result_cache = NULL;
+    if (cache_dir && cache_dir[0] && !open_result_cache(&cache, cache_dir))
+        result_cache = &cache;
+
+    // Results go to the real stdout, and everything the solvers print goes to /dev/null
+    fflush(stdout);
+    int results_fd = dup(STDOUT_FILENO);
+    silence_stdout(true);
+
+    long long start = now_ns();
+    // The tables are built once, before forking, so every worker starts with them
+    init_solver_tables(solver);
+    int workers = 0;
+    if (jobs == 1)
+        solve_inputs(solver, &inputs, progress, results_fd, result_cache, refresh);
+    else
+    {
+        // Processes rather than threads, because solvers keep their state in globals
+        for (long i = 0; i < jobs; i++)
+        {
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                solve_inputs(solver, &inputs, progress, results_fd, result_cache, refresh);
+                exit(0);
+            }
+            if (pid == -1)
+            {
+                perror("Error starting a worker");
+                break;
+            }
+            workers++;
+        }
+        // If no worker could be started, solve everything here
+        if (!workers)
+            solve_inputs(solver, &inputs, progress, results_fd, result_cache, refresh);
+    }
+
+    int crashed = 0;
+    for (int i = 0; i < workers; i++)
+    {
+        int status;
+        if (wait(&status) == -1 || !WIFEXITED(status) || WEXITSTATUS(status))
+            crashed++;
+    }
+    long long elapsed = now_ns() - start;
+    delete_solver_tables(solver);
+
+    silence_stdout(false);
+    close(results_fd);
+
+    size_t failures = atomic_load(&progress->failures);
+    fprintf(stderr, "%zu inputs in %.3f s with %d worker(s): %.1f inputs/s\n", inputs.len, elapsed / 1e9, workers ? workers : 1,
+            inputs.len / (elapsed / 1e9));
+    if (result_cache)
+        fprintf(stderr, "%zu answer(s) from the cache\n", atomic_load(&progress->cached));
+    if (failures)
+        fprintf(stderr, "%zu input(s) failed\n", failures);
+    if (crashed)
+        fprintf(stderr, "%d worker(s) crashed, so some inputs have no result\n", crashed);
+
+    munmap(progress, sizeof(*progress));
+    for (size_t i = 0; i < inputs.len; i++)
+        free(inputs.files[i]);
+    free(inputs.files);
+    return (failures || crashed) ? 1 : 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr,
+            "Usage: %s [-j JOBS] [-m MANIFEST] [-C CACHE_DIR] [-B] [-R] DAY.PART [INPUT ...]\n"
+            "Solve many inputs with one solver, printing INPUT<TAB>ANSWER for each as soon as it is solved.\n"
+            "Each INPUT is a file, or a directory whose files are all solved. Throughput goes to stderr.\n"
+            "  -j JOBS      Worker processes (default: the number of online CPUs)\n"
+            "  -m MANIFEST  Also solve every file listed in MANIFEST, one per line\n"
+            "  -C CACHE_DIR Reuse answers for unchanged inputs from CACHE_DIR, and save new ones (default: $AOC_CACHE_DIR)\n"
+            "  -B           Bypass the cache: don't read or write it\n"
+            "  -R           Refresh the cache: solve again and replace the cached answers\n",
+            program_name);
+}
+
+// Append a copy of `file` to the inputs
+void add_input(InputList *inputs, const char *file)
+{
+    if (inputs->len == inputs->cap)
+    {
+        inputs->cap = inputs->cap ? inputs->cap * 2 : 64UL;
+        inputs->files = realloc(inputs->files, sizeof(inputs->files[0]) * inputs->cap);
+    }
+    inputs->files[inputs->len++] = strdup(file);
+}
+
+/// @brief Add every file in a directory (not its subdirectories or hidden files) to the inputs, sorted by name
+/// @param inputs The inputs
+/// @param dir The directory
+/// @return 0 if success, 1 if the directory can't be read
+int add_directory(InputList *inputs, const char *dir)
+{
+    DIR *d = opendir(dir);
+    if (d == NULL)
+    {
+        perror(dir);
+        return 1;
+    }
+
+    size_t first = inputs->len;
+    char file[INPUT_FILE_SIZE];
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+        snprintf(file, sizeof(file), "%s/%s", dir, entry->d_name);
+        struct stat st;
+        if (!stat(file, &st) && S_ISREG(st.st_mode))
+            add_input(inputs, file);
+    }
+    closedir(d);
+
+    // readdir is in no particular order
+    qsort(inputs->files + first, inputs->len - first, sizeof(inputs->files[0]), compare_strings);
+    return 0;
+}
+
+/// @brief Add every file listed in a manifest to the inputs, skipping blank lines
+/// @param inputs The inputs
+/// @param manifest_file The manifest, with one path per line
+/// @return 0 if success, 1 if the manifest can't be read
+int add_manifest(InputList *inputs, const char *manifest_file)
+{
+    FILE *f = fopen(manifest_file, "r");
+    if (f == NULL)
+    {
+        perror(manifest_file);
+        return 1;
+    }
+
+    char *line = NULL;
+    size_t line_cap = 0UL;
+    ssize_t line_len;
+    while ((line_len = getline(&line, &line_cap, f)) != -1)
+    {
+        while (line_len && (line[line_len - 1] == '\n' || line[line_len - 1] == '\r'))
+            line[--line_len] = '\0';
+        if (line_len)
+            add_input(inputs, line);
+    }
+    free(line);
+    fclose(f);
+    return 0;
+}
+
+// Compare function for qsort over an array of strings
+int compare_strings(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/// @brief Claim inputs until there are none left, writing a result line for each
+/// @param solver The solver, whose tables are already built
+/// @param inputs The inputs
+/// @param progress The progress shared by every worker
+/// @param results_fd Where to write each INPUT<TAB>ANSWER line
+/// @param cache The result cache, or NULL to not cache
+/// @param refresh Whether to solve even if the answer is cached, replacing it
+void solve_inputs(const Solver *solver, InputList *inputs, BatchProgress *progress, int results_fd, ResultCache *cache, bool refresh)
+{
+    char answer[ANSWER_SIZE];
+    char line[INPUT_FILE_SIZE + ANSWER_SIZE + 2];
+    size_t i;
+    while ((i = atomic_fetch_add(&progress->next_input, 1UL)) < inputs->len)
+    {
+        int error = 1;
+        ResultKey key;
+        bool use_cache = cache && !get_result_key(cache, solver, inputs->files[i], &key);
+        if (use_cache && !refresh && get_cached_result(cache, solver, key, answer))
+        {
+            error = 0;
+            atomic_fetch_add(&progress->cached, 1UL);
+        }
+        else
+        {
+            void *puzzle = solver->parse(inputs->files[i]);
+            if (puzzle)
+            {
+                error = solver->solve(puzzle, answer);
+                solver->delete(puzzle);
+            }
+            if (use_cache && !error)
+                put_cached_result(cache, solver, key, answer);
+        }
+        if (error)
+            atomic_fetch_add(&progress->failures, 1UL);
+
+        // One write per line, so lines from different workers don't interleave
+        int line_len = snprintf(line, sizeof(line), "%s\t%s\n", inputs->files[i], error ? "FAILED" : answer);
+        if (line_len >= (int)sizeof(line))
+        {
+            line_len = sizeof(line) - 1;
+            line[line_len - 1] = '\n';
+        }
+        write_all(results_fd, line, line_len);
+    }
+}
+
+/// @brief Write all of `buf`, continuing after partial writes
+/// @param fd Where to write
+/// @param buf What to write
+/// @param size The number of bytes in `buf`
+/// @return 0 if success, 1 if failure
+int write_all(int fd, const char *buf, size_t size)
+{
+    while (size)
+    {
+        ssize_t written = write(fd, buf, size);
+        if (written <= 0)
+            return 1;
+        buf += written;
+        size -= written;
+    }
+    return 0;
+}
@@ -0,0 +1,414 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <getopt.h>
+
+#include "solvers.h"
+#include "alloc_count.h"
+#include "thread_pool.h"
+
+typedef struct BenchResult
+{
+    int day;
+    int part;
+    // Statistics of the time spent in `solve` in nanoseconds
+    long long min_ns;
+    long long median_ns;
+    long long p99_ns;
+    // The number of allocations made by one call to `solve`
+    long long allocations;
+    // 0 if success, non-zero if failure
+    int error;
+} BenchResult;
+
+// The number of call sites shown for each phase of a profile
+#define TOP_ALLOC_SITES 5
+
+// Where one solver allocates, in each phase
+typedef struct AllocProfile
+{
+    int day;
+    int part;
+    // Parse, then solve
+    AllocStats phases[2];
+    AllocSite sites[2][TOP_ALLOC_SITES];
+    size_t sites_size[2];
+} AllocProfile;
+
+void print_usage(char *program_name);
+BenchResult bench_solver(const Solver *solver, char *input_dir, int warmup, int repetitions);
+int profile_solver(const Solver *solver, char *input_dir, AllocProfile *profile);
+int compare_profiles(const void *a, const void *b);
+void print_profiles(AllocProfile *profiles, size_t profiles_size);
+int compare_long_long(const void *a, const void *b);
+int write_json(char *output_file, BenchResult *results, size_t results_size, int warmup, int repetitions);
+int read_baseline(char *baseline_file, BenchResult **baseline, size_t *baseline_size);
+BenchResult *find_result(BenchResult *results, size_t results_size, int day, int part);
+
+int main(int argc, char *argv[])
+{
+    // The directory containing day_XX/input.txt
+    char *input_dir = ".";
+    // The number of untimed runs before timing
+    int warmup = 1;
+    // The number of timed runs
+    int repetitions = 10;
+    // Where to write the results as JSON, or NULL to not write them
+    char *output_file = NULL;
+    // The results to compare against, or NULL to not compare
+    char *baseline_file = NULL;
+    // How much slower than the baseline median a solver can be before it is a regression, in percent
+    double threshold = 10.0;
+    // The number of threads for solvers that use parallel_for
+    int threads = 1;
+    // Whether to profile allocations in each phase after timing
+    bool profile_allocations = false;
+
+    static const struct option long_options[] = {{"threads", required_argument, NULL, 'j'}, {NULL, 0, NULL, 0}};
+    int opt;
+    while ((opt = getopt_long(argc, argv, "i:w:n:o:b:t:j:ah", long_options, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 'i':
+            input_dir = optarg;
+            break;
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 'n':
+            repetitions = atoi(optarg);
+            break;
+        case 'o':
+            output_file = optarg;
+            break;
+        case 'b':
+            baseline_file = optarg;
+            break;
+        case 't':
+            threshold = atof(optarg);
+            break;
+        case 'j':
+            threads = atoi(optarg);
+            break;
+        case 'a':
+            profile_allocations = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (warmup < 0 || repetitions < 1)
+    {
+        fprintf(stderr, "Warmup must be at least 0 and repetitions must be at least 1\n");
+        return 1;
+    }
+    if (threads < 1 || threads > MAX_THREADS)
+    {
+        fprintf(stderr, "Threads must be between 1 and %d\n", MAX_THREADS);
+        return 1;
+    }
+
+    bool selected[all_solvers_size];
+    if (select_solvers(argc - optind, argv + optind, selected))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    BenchResult *baseline = NULL;
+    size_t baseline_size = 0;
+    if (baseline_file && read_baseline(baseline_file, &baseline, &baseline_size))
+        return 1;
+    set_thread_count(threads);
+
+    BenchResult results[all_solvers_size];
+    size_t results_size = 0;
+    AllocProfile profiles[all_solvers_size];
+    size_t profiles_size = 0;
+    int failures = 0;
+    int regressions = 0;
+
+    printf("%-4s %-4s %12s %12s %12s %12s", "Day", "Part", "Min (ms)", "Median (ms)", "p99 (ms)", "Allocations");
+    if (baseline)
+        printf(" %12s %9s", "Base (ms)", "Change");
+    printf("\n");
+
+    for (size_t i = 0; i < all_solvers_size; i++)
+    {
+        if (!selected[i])
+            continue;
+
+        const Solver *solver = all_solvers[i];
+        BenchResult result = bench_solver(solver, input_dir, warmup, repetitions);
+        if (result.error)
+        {
+            failures++;
+            printf("%-4d %-4d %12s\n", solver->day, solver->part, "FAILED");
+            continue;
+        }
+        results[results_size++] = result;
+
+        printf("%-4d %-4d %12.3f %12.3f %12.3f %12lld", result.day, result.part, result.min_ns / 1e6, result.median_ns / 1e6, result.p99_ns / 1e6, result.allocations);
+
+        // Compare medians, since the minimum is too optimistic and p99 is too noisy
+        BenchResult *base = baseline ? find_result(baseline, baseline_size, result.day, result.part) : NULL;
+        if (base && base->median_ns > 0)
+        {
+            double change = (result.median_ns - base->median_ns) * 100.0 / base->median_ns;
+            bool is_regression = change > threshold;
+            regressions += is_regression;
+            printf(" %12.3f %+8.1f%%%s", base->median_ns / 1e6, change, is_regression ? " REGRESSION" : "");
+        }
+        else if (baseline)
+            printf(" %12s", "-");
+        printf("\n");
+
+        // A separate run, so profiling doesn't slow down the timed runs
+        if (profile_allocations && !profile_solver(solver, input_dir, &profiles[profiles_size]))
+            profiles_size++;
+    }
+
+    if (profiles_size)
+        print_profiles(profiles, profiles_size);
+
+    if (output_file && write_json(output_file, results, results_size, warmup, repetitions))
+        failures++;
+
+    if (regressions)
+        printf("%d solver(s) regressed by more than %.1f%%\n", regressions, threshold);
+
+    free(baseline);
+    set_thread_count(1);
+    return (failures || regressions) ? 1 : 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr,
+            "Usage: %s [-i INPUT_DIR] [-w WARMUP] [-n REPETITIONS] [-o OUTPUT_FILE] [-b BASELINE_FILE] [-t THRESHOLD] [-j THREADS] [-a] [DAY[.PART] ...]\n"
+            "Time the solve step of the given solvers, or every solver if none are given.\n"
+            "  -i INPUT_DIR      Read each day's input from INPUT_DIR/day_XX/input.txt (default: .)\n"
+            "  -w WARMUP         Untimed runs before timing (default: 1)\n"
+            "  -n REPETITIONS    Timed runs (default: 10)\n"
+            "  -o OUTPUT_FILE    Write the results as JSON\n"
+            "  -b BASELINE_FILE  Compare against JSON written by -o, failing if any median is slower\n"
+            "  -t THRESHOLD      Percent slower than the baseline that counts as a regression (default: 10)\n"
+            "  -j THREADS        Run the loops of solvers that use parallel_for on THREADS threads (default: 1). Also --threads\n"
+            "  -a                Profile the allocations, bytes, peak live bytes, and top call sites of each phase\n",
+            program_name);
+}
+
+/// @brief Run a solver `warmup + repetitions` times, timing only `solve`.
+/// The puzzle is parsed again for every run because `solve` may modify it.
+/// @param solver The solver to run
+/// @param input_dir The directory containing day_XX/input.txt
+/// @param warmup The number of untimed runs
+/// @param repetitions The number of timed runs
+/// @return The statistics of the timed runs
+BenchResult bench_solver(const Solver *solver, char *input_dir, int warmup, int repetitions)
+{
+    BenchResult result = {.day = solver->day, .part = solver->part, .error = 1};
+    char input_file[INPUT_FILE_SIZE];
+    get_input_file(input_file, sizeof(input_file), input_dir, solver->day);
+    char answer[ANSWER_SIZE];
+    long long *times = malloc(sizeof(times[0]) * repetitions);
+
+    silence_stdout(true);
+    for (int i = 0; i < warmup + repetitions; i++)
+    {
+        // Fresh tables for every run, or each run after the first would only be timing lookups
+        init_solver_tables(solver);
+        void *puzzle = solver->parse(input_file);
+        if (!puzzle)
+        {
+            delete_solver_tables(solver);
+            goto CLEANUP;
+        }
+
+        long long allocations = get_alloc_count();
+        long long start = now_ns();
+        int error = solver->solve(puzzle, answer);
+        long long elapsed = now_ns() - start;
+        allocations = get_alloc_count() - allocations;
+
+        solver->delete(puzzle);
+        delete_solver_tables(solver);
+        if (error)
+            goto CLEANUP;
+
+        if (i >= warmup)
+        {
+            times[i - warmup] = elapsed;
+            result.allocations = allocations;
+        }
+    }
+    result.error = 0;
+
+    qsort(times, repetitions, sizeof(times[0]), compare_long_long);
+    result.min_ns = times[0];
+    result.median_ns = (repetitions & 1) ? times[repetitions / 2] : (times[repetitions / 2 - 1] + times[repetitions / 2]) / 2;
+    // Nearest rank: the smallest time that is at least 99% of the times
+    result.p99_ns = times[(repetitions * 99 + 99) / 100 - 1];
+
+CLEANUP:
+    silence_stdout(false);
+    free(times);
+    return result;
+}
+
+/// @brief Parse and solve once, profiling the allocations in each phase
+/// @param solver The solver to run
+/// @param input_dir The directory containing day_XX/input.txt
+/// @param profile Out: The profile
+/// @return 0 if success, 1 if failure
+int profile_solver(const Solver *solver, char *input_dir, AllocProfile *profile)
+{
+    char input_file[INPUT_FILE_SIZE];
+    get_input_file(input_file, sizeof(input_file), input_dir, solver->day);
+    char answer[ANSWER_SIZE];
+    profile->day = solver->day;
+    profile->part = solver->part;
+
+    silence_stdout(true);
+    init_solver_tables(solver);
+    start_alloc_profile();
+    void *puzzle = solver->parse(input_file);
+    profile->phases[0] = stop_alloc_profile();
+    profile->sites_size[0] = get_alloc_sites(profile->sites[0], TOP_ALLOC_SITES);
+
+    int error = 1;
+    if (puzzle)
+    {
+        start_alloc_profile();
+        error = solver->solve(puzzle, answer);
+        profile->phases[1] = stop_alloc_profile();
+        profile->sites_size[1] = get_alloc_sites(profile->sites[1], TOP_ALLOC_SITES);
+        solver->delete(puzzle);
+    }
+    delete_solver_tables(solver);
+    silence_stdout(false);
+    return error ? 1 : 0;
+}
+
+// Compare function for qsort: the most allocations in solve first, since those are repeated for every input
+int compare_profiles(const void *a, const void *b)
+{
+    long long lhs = ((const AllocProfile *)a)->phases[1].allocations;
+    long long rhs = ((const AllocProfile *)b)->phases[1].allocations;
+    return (lhs < rhs) - (lhs > rhs);
+}
+
+/// @brief Print the profiles, the solvers that allocate the most in solve first
+/// @param profiles The profiles, which are sorted
+/// @param profiles_size The number of elements in `profiles`
+void print_profiles(AllocProfile *profiles, size_t profiles_size)
+{
+    static const char *phase_names[] = {"parse", "solve"};
+    qsort(profiles, profiles_size, sizeof(profiles[0]), compare_profiles);
+
+    printf("\n%-4s %-4s %-6s %12s %14s %12s %16s\n", "Day", "Part", "Phase", "Allocations", "Bytes", "Frees", "Peak live bytes");
+    for (size_t i = 0; i < profiles_size; i++)
+    {
+        for (int phase = 0; phase < 2; phase++)
+        {
+            AllocStats stats = profiles[i].phases[phase];
+            printf("%-4d %-4d %-6s %12lld %14lld %12lld %16lld\n", profiles[i].day, profiles[i].part, phase_names[phase],
+                   stats.allocations, stats.bytes, stats.frees, stats.peak_live_bytes);
+        }
+        for (int phase = 0; phase < 2; phase++)
+        {
+            for (size_t j = 0; j < profiles[i].sites_size[phase]; j++)
+            {
+                char site[256];
+                describe_alloc_site(profiles[i].sites[phase][j].address, site, sizeof(site));
+                printf("%16s %12lld %14lld  %s\n", phase_names[phase], profiles[i].sites[phase][j].allocations,
+                       profiles[i].sites[phase][j].bytes, site);
+            }
+        }
+    }
+}
+
+// Compare function for qsort
+int compare_long_long(const void *a, const void *b)
+{
+    long long lhs = *(const long long *)a;
+    long long rhs = *(const long long *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/// @brief Write the results as JSON, with one result per line so `read_baseline` can read it back
+/// @param output_file The file to write
+/// @param results The results to write
+/// @param results_size The number of elements in `results`
+/// @param warmup The number of untimed runs, for reference
+/// @param repetitions The number of timed runs, for reference
+/// @return 0 if success, 1 if failure
+int write_json(char *output_file, BenchResult *results, size_t results_size, int warmup, int repetitions)
+{
+    FILE *f = fopen(output_file, "w");
+    if (f == NULL)
+    {
+        perror("Error opening output file");
+        return 1;
+    }
+
+    fprintf(f, "{\n    \"warmup\": %d,\n    \"repetitions\": %d,\n    \"results\": [\n", warmup, repetitions);
+    for (size_t i = 0; i < results_size; i++)
+        fprintf(f, "        {\"day\": %d, \"part\": %d, \"min_ns\": %lld, \"median_ns\": %lld, \"p99_ns\": %lld, \"allocations\": %lld}%s\n",
+                results[i].day, results[i].part, results[i].min_ns, results[i].median_ns, results[i].p99_ns, results[i].allocations,
+                (i + 1 < results_size) ? "," : "");
+    fprintf(f, "    ]\n}\n");
+
+    fclose(f);
+    return 0;
+}
+
+/// @brief Read results written by `write_json`. This is not a general JSON parser, it only reads one result per line.
+/// @param baseline_file The file to read
+/// @param baseline Out: The results. Must be freed by the caller
+/// @param baseline_size Out: The number of elements in `baseline`
+/// @return 0 if success, 1 if failure
+int read_baseline(char *baseline_file, BenchResult **baseline, size_t *baseline_size)
+{
+    FILE *f = fopen(baseline_file, "r");
+    if (f == NULL)
+    {
+        perror("Error opening baseline file");
+        return 1;
+    }
+
+    size_t cap = 16;
+    *baseline = malloc(sizeof((*baseline)[0]) * cap);
+    *baseline_size = 0;
+
+    char line[1024];
+    while (fgets(line, sizeof(line), f))
+    {
+        BenchResult result = {0};
+        if (sscanf(line, " {\"day\": %d, \"part\": %d, \"min_ns\": %lld, \"median_ns\": %lld, \"p99_ns\": %lld, \"allocations\": %lld}",
+                   &result.day, &result.part, &result.min_ns, &result.median_ns, &result.p99_ns, &result.allocations) != 6)
+            continue;
+
+        if (*baseline_size == cap)
+        {
+            cap *= 2;
+            *baseline = realloc(*baseline, sizeof((*baseline)[0]) * cap);
+        }
+        (*baseline)[(*baseline_size)++] = result;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+// Find the result for a day and part, or NULL if there is none
+BenchResult *find_result(BenchResult *results, size_t results_size, int day, int part)
+{
+    for (size_t i = 0; i < results_size; i++)
+        if (results[i].day == day && results[i].part == part)
+            return &results[i];
+    return NULL;
+}
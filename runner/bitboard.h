@@ -0,0 +1,370 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+// Sets of cells of a rectangular map, one bit per cell
+// Each row is stored in whole 64 bit words, so moving every cell of the set one step is a shift of each word (east and
+// west, carrying a bit between neighbouring words) or a shift by a whole row (north and south). The bits past the last
+// column of a row are always 0, so a step off the east or west edge falls into them and is masked away.
+// Searches with unit steps expand a whole frontier at once: next = neighbours(frontier) & free & ~visited, which steps
+// 64 cells with each word operation instead of one char per cell.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "grid.h"
+
+#define BITBOARD_WORD_BITS 64
+
+typedef struct Bitboard
+{
+    // Every word, row by row
+    uint64_t *words;
+    // The size of the map
+    int rows, cols;
+    // The number of words in each row
+    int stride;
+    // The number of words
+    size_t size;
+    // The bits of the last word of a row that are in the map
+    uint64_t last_mask;
+} Bitboard;
+
+// The word holding the cell at `row` and `col`, and the cell's bit in it
+#define BITBOARD_WORD(bitboard, row, col) ((bitboard).words[((size_t)(row) * (bitboard).stride) + ((col) / BITBOARD_WORD_BITS)])
+#define BITBOARD_BIT(col) (1ULL << ((col) % BITBOARD_WORD_BITS))
+
+// Visit every cell in a bitboard, in order. `bit` is a long, which bitboard_row and bitboard_col turn into the cell
+#define BITBOARD_FOR_EACH(bitboard, bit) \
+    for (long bit = bitboard_next((bitboard), 0L); bit >= 0; bit = bitboard_next((bitboard), bit + 1))
+
+/// @brief Allocate an empty bitboard
+/// @param rows The number of rows in the map
+/// @param cols The number of columns in the map
+/// @return The bitboard. Delete with delete_bitboard
+static inline Bitboard new_bitboard(int rows, int cols)
+{
+    Bitboard bitboard = {.rows = rows, .cols = cols, .stride = (cols + BITBOARD_WORD_BITS - 1) / BITBOARD_WORD_BITS};
+    bitboard.size = (size_t)bitboard.stride * rows;
+    bitboard.last_mask = cols % BITBOARD_WORD_BITS ? BITBOARD_BIT(cols) - 1 : ~0ULL;
+    bitboard.words = calloc(bitboard.size ? bitboard.size : 1, sizeof(bitboard.words[0]));
+    return bitboard;
+}
+
+// Allocate a bitboard of the cells of a grid's map (not its border) that are `cell`
+static inline Bitboard bitboard_from_grid(Grid grid, char cell)
+{
+    Bitboard bitboard = new_bitboard(grid.rows, grid.cols);
+    for (int row = 0; row < grid.rows; row++)
+    {
+        char *cells = &GRID_CELL(grid, row, 0);
+        uint64_t *words = &bitboard.words[(size_t)row * bitboard.stride];
+        for (int col = 0; col < grid.cols; col++)
+            words[col / BITBOARD_WORD_BITS] |= (uint64_t)(cells[col] == cell) << (col % BITBOARD_WORD_BITS);
+    }
+    return bitboard;
+}
+
+// Copy every word of a bitboard into a new bitboard
+static inline Bitboard copy_bitboard(Bitboard bitboard)
+{
+    Bitboard copy = bitboard;
+    copy.words = malloc(sizeof(copy.words[0]) * (bitboard.size ? bitboard.size : 1));
+    memcpy(copy.words, bitboard.words, sizeof(copy.words[0]) * bitboard.size);
+    return copy;
+}
+
+static inline void delete_bitboard(Bitboard *bitboard)
+{
+    free(bitboard->words);
+    bitboard->words = NULL;
+    bitboard->size = 0UL;
+}
+
+static inline bool bitboard_test(Bitboard bitboard, int row, int col) { return BITBOARD_WORD(bitboard, row, col) & BITBOARD_BIT(col); }
+static inline void bitboard_set(Bitboard bitboard, int row, int col) { BITBOARD_WORD(bitboard, row, col) |= BITBOARD_BIT(col); }
+static inline void bitboard_unset(Bitboard bitboard, int row, int col) { BITBOARD_WORD(bitboard, row, col) &= ~BITBOARD_BIT(col); }
+
+// Remove every cell
+static inline void bitboard_clear(Bitboard bitboard) { memset(bitboard.words, 0, sizeof(bitboard.words[0]) * bitboard.size); }
+
+// Add every cell of the map
+static inline void bitboard_fill(Bitboard bitboard)
+{
+    if (!bitboard.stride)
+        return;
+    memset(bitboard.words, 0xff, sizeof(bitboard.words[0]) * bitboard.size);
+    for (int row = 0; row < bitboard.rows; row++)
+        bitboard.words[((size_t)row * bitboard.stride) + bitboard.stride - 1] = bitboard.last_mask;
+}
+
+// The row and column of bit `bit`, from bitboard_next or BITBOARD_FOR_EACH
+static inline int bitboard_row(Bitboard bitboard, long bit) { return bit / ((long)bitboard.stride * BITBOARD_WORD_BITS); }
+static inline int bitboard_col(Bitboard bitboard, long bit) { return bit % ((long)bitboard.stride * BITBOARD_WORD_BITS); }
+
+/// @brief Find the next cell in a bitboard
+/// @param bitboard The bitboard
+/// @param from The bit to start looking at
+/// @return The first bit at or after `from` that is set, or -1 if there are none
+static inline long bitboard_next(Bitboard bitboard, long from)
+{
+    size_t i = from / BITBOARD_WORD_BITS;
+    if (i >= bitboard.size)
+        return -1L;
+    uint64_t word = bitboard.words[i] & (~0ULL << (from % BITBOARD_WORD_BITS));
+    while (!word)
+    {
+        if (++i >= bitboard.size)
+            return -1L;
+        word = bitboard.words[i];
+    }
+    return ((long)i * BITBOARD_WORD_BITS) + __builtin_ctzll(word);
+}
+
+// The number of cells in a bitboard
+static inline long bitboard_count(Bitboard bitboard)
+{
+    long count = 0L;
+    for (size_t i = 0; i < bitboard.size; i++)
+        count += __builtin_popcountll(bitboard.words[i]);
+    return count;
+}
+
+// Whether a bitboard has any cells
+static inline bool bitboard_any(Bitboard bitboard)
+{
+    for (size_t i = 0; i < bitboard.size; i++)
+        if (bitboard.words[i])
+            return true;
+    return false;
+}
+
+// dst = a & b. Any of the bitboards may be the same, and all must be the same size
+static inline void bitboard_and(Bitboard dst, Bitboard a, Bitboard b)
+{
+    for (size_t i = 0; i < dst.size; i++)
+        dst.words[i] = a.words[i] & b.words[i];
+}
+
+// dst = a | b
+static inline void bitboard_or(Bitboard dst, Bitboard a, Bitboard b)
+{
+    for (size_t i = 0; i < dst.size; i++)
+        dst.words[i] = a.words[i] | b.words[i];
+}
+
+// dst = a & ~b
+static inline void bitboard_andnot(Bitboard dst, Bitboard a, Bitboard b)
+{
+    for (size_t i = 0; i < dst.size; i++)
+        dst.words[i] = a.words[i] & ~b.words[i];
+}
+
+/// @brief Move every cell of a bitboard one step. Cells stepping off the map are dropped
+/// @param dst Out: The moved cells. Must not be `src`
+/// @param src The cells to move
+/// @param dir The direction to move them
+static inline void bitboard_shift(Bitboard dst, Bitboard src, GridDirection dir)
+{
+    size_t row_size = sizeof(src.words[0]) * src.stride;
+    switch (dir)
+    {
+    case GRID_NORTH:
+        if (src.rows)
+        {
+            memcpy(dst.words, src.words + src.stride, row_size * (src.rows - 1));
+            memset(dst.words + (src.size - src.stride), 0, row_size);
+        }
+        break;
+    case GRID_SOUTH:
+        if (src.rows)
+        {
+            memcpy(dst.words + src.stride, src.words, row_size * (src.rows - 1));
+            memset(dst.words, 0, row_size);
+        }
+        break;
+    case GRID_EAST:
+        // Columns increase with the bits, so east is towards the high bits, carrying the top bit into the next word
+        for (int row = 0; row < src.rows; row++)
+        {
+            uint64_t *in = src.words + ((size_t)row * src.stride), *out = dst.words + ((size_t)row * dst.stride);
+            uint64_t carry = 0ULL;
+            for (int w = 0; w < src.stride; w++)
+            {
+                out[w] = (in[w] << 1) | carry;
+                carry = in[w] >> (BITBOARD_WORD_BITS - 1);
+            }
+            out[src.stride - 1] &= src.last_mask;
+        }
+        break;
+    case GRID_WEST:
+        for (int row = 0; row < src.rows; row++)
+        {
+            uint64_t *in = src.words + ((size_t)row * src.stride), *out = dst.words + ((size_t)row * dst.stride);
+            uint64_t carry = 0ULL;
+            for (int w = src.stride - 1; w >= 0; w--)
+            {
+                out[w] = (in[w] >> 1) | carry;
+                carry = in[w] << (BITBOARD_WORD_BITS - 1);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// A search outwards from a set of cells, one whole frontier of cells at the same distance at a time
+// Only the words of the frontier that have cells are kept in a list, and each step only visits them and their
+// neighbouring words, so a thin frontier (like the diagonal of a search from a corner) costs its own size, not the map's
+typedef struct BitboardSearch
+{
+    // The cells reached by the last step
+    Bitboard frontier;
+    // Where the next step collects its cells. Empty between steps
+    Bitboard next;
+    // The indices of the words of `frontier` that have cells
+    size_t *active;
+    size_t active_size;
+    // The indices of the words of `next` written by a step
+    size_t *touched;
+} BitboardSearch;
+
+/// @brief Start a search from some cells
+/// @param seeds The cells to start from
+/// @return The search. Delete with delete_bitboard_search
+static inline BitboardSearch new_bitboard_search(Bitboard seeds)
+{
+    BitboardSearch search = {.frontier = copy_bitboard(seeds), .next = new_bitboard(seeds.rows, seeds.cols), .active_size = 0UL};
+    search.active = malloc(sizeof(search.active[0]) * (seeds.size ? seeds.size : 1));
+    search.touched = malloc(sizeof(search.touched[0]) * (seeds.size ? seeds.size : 1));
+    for (size_t i = 0; i < seeds.size; i++)
+        if (seeds.words[i])
+            search.active[search.active_size++] = i;
+    return search;
+}
+
+static inline void delete_bitboard_search(BitboardSearch *search)
+{
+    delete_bitboard(&search->frontier);
+    delete_bitboard(&search->next);
+    free(search->active);
+    free(search->touched);
+    search->active = search->touched = NULL;
+    search->active_size = 0UL;
+}
+
+/// @brief Move some bits into a word of a search's next frontier, listing the word the first time it gets any
+/// @param next The next frontier
+/// @param touched The words of `next` that have been written
+/// @param touched_size In/out: The number of words in `touched`
+/// @param index The word to move the bits into
+/// @param bits The bits
+static inline void bitboard_touch(Bitboard next, size_t *touched, size_t *touched_size, size_t index, uint64_t bits)
+{
+    if (!bits)
+        return;
+    if (!next.words[index])
+        touched[(*touched_size)++] = index;
+    next.words[index] |= bits;
+}
+
+/// @brief Take one step from every cell of the frontier at once: frontier = neighbours(frontier) & free & ~visited
+/// @param search The search
+/// @param free The cells that can be stepped on
+/// @param visited In/out: The cells already reached. The new frontier is added
+/// @return Whether the step reached any new cells
+static inline bool bitboard_search_step(BitboardSearch *search, Bitboard free, Bitboard visited)
+{
+    Bitboard frontier = search->frontier, next = search->next;
+    size_t stride = frontier.stride, touched_size = 0UL;
+    size_t last_row_start = frontier.size - stride;
+
+    for (size_t a = 0; a < search->active_size; a++)
+    {
+        size_t i = search->active[a];
+        uint64_t word = frontier.words[i];
+        size_t col_word = i % stride;
+        // Columns increase with the bits, so east is towards the high bits, carrying the top bit into the next word.
+        // `free` is 0 past the last column, so a step off the east edge is dropped when it is masked
+        bitboard_touch(next, search->touched, &touched_size, i, (word << 1) | (word >> 1));
+        if (col_word > 0)
+            bitboard_touch(next, search->touched, &touched_size, i - 1, word << (BITBOARD_WORD_BITS - 1));
+        if (col_word < stride - 1)
+            bitboard_touch(next, search->touched, &touched_size, i + 1, word >> (BITBOARD_WORD_BITS - 1));
+        if (i >= stride)
+            bitboard_touch(next, search->touched, &touched_size, i - stride, word);
+        if (i < last_row_start)
+            bitboard_touch(next, search->touched, &touched_size, i + stride, word);
+    }
+
+    // Empty the old frontier, so it can collect the step after this one
+    for (size_t a = 0; a < search->active_size; a++)
+        frontier.words[search->active[a]] = 0ULL;
+
+    search->active_size = 0UL;
+    for (size_t t = 0; t < touched_size; t++)
+    {
+        size_t i = search->touched[t];
+        uint64_t word = next.words[i] & free.words[i] & ~visited.words[i];
+        next.words[i] = word;
+        if (word)
+        {
+            visited.words[i] |= word;
+            search->active[search->active_size++] = i;
+        }
+    }
+
+    search->frontier = next;
+    search->next = frontier;
+    return search->active_size;
+}
+
+/// @brief Find every free cell connected to a set of seeds
+/// @param free The cells that can be stepped on
+/// @param region In/out: The seeds, which must be free. Every cell reachable from them is added
+/// @return The number of cells in `region`
+static inline long bitboard_flood_fill(Bitboard free, Bitboard region)
+{
+    BitboardSearch search = new_bitboard_search(region);
+    while (bitboard_search_step(&search, free, region))
+        ;
+    delete_bitboard_search(&search);
+    return bitboard_count(region);
+}
+
+/// @brief Count the fewest unit steps between two cells, searching outwards from `start` one whole frontier at a time
+/// @param free The cells that can be stepped on
+/// @param start_row The row of the first cell
+/// @param start_col The column of the first cell
+/// @param end_row The row of the cell to reach
+/// @param end_col The column of the cell to reach
+/// @param reached Out, or NULL: Every cell found by the search, until it reached the end. Must be empty
+/// @return The number of steps, or -1 if the end can't be reached
+static inline long long bitboard_min_steps(Bitboard free, int start_row, int start_col, int end_row, int end_col, Bitboard *reached)
+{
+    if (!bitboard_test(free, start_row, start_col))
+        return -1LL;
+    Bitboard visited = reached ? *reached : new_bitboard(free.rows, free.cols);
+    bitboard_set(visited, start_row, start_col);
+    BitboardSearch search = new_bitboard_search(visited);
+
+    long long steps = 0LL;
+    while (!bitboard_test(visited, end_row, end_col))
+    {
+        if (!bitboard_search_step(&search, free, visited))
+        {
+            steps = -1LL;
+            break;
+        }
+        steps++;
+    }
+
+    if (!reached)
+        delete_bitboard(&visited);
+    delete_bitboard_search(&search);
+    return steps;
+}
+
+#endif
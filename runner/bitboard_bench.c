@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bitboard.h"
+#include "generator.h"
+#include "timer.h"
+
+// Compare searches of a large random map (4096x4096 by default) one cell at a time on a char grid with searches of a
+// bitboard: stepping the whole map with bitboard_shift each step, and bitboard_search_step, which only visits the words
+// of the frontier. Each finds the fewest steps from the top left to the bottom right, then floods the region of the top
+// left. Every version must get the same steps and region size, or its row is marked MISMATCH
+// Stepping the whole map costs the map's size for every step, so it is only run on maps up to WHOLE_MAP_MAX_SIZE
+
+#define WHOLE_MAP_MAX_SIZE 1024
+
+typedef struct Search
+{
+    char *name;
+    long long (*min_steps)(Grid map, Bitboard free);
+    long (*flood_fill)(Grid map, Bitboard free);
+} Search;
+
+void print_usage(char *program_name);
+Grid make_map(int size, int wall_percent);
+long grid_search(Grid map, long end, long long *steps);
+long long whole_search(Bitboard free, Bitboard visited, int end_row, int end_col);
+long long grid_min_steps(Grid map, Bitboard free);
+long grid_flood_fill(Grid map, Bitboard free);
+long long whole_min_steps(Grid map, Bitboard free);
+long whole_flood_fill(Grid map, Bitboard free);
+long long frontier_min_steps(Grid map, Bitboard free);
+long frontier_flood_fill(Grid map, Bitboard free);
+
+int main(int argc, char *argv[])
+{
+    // The number of rows and columns of the map
+    int size = 4096;
+    // The number of runs of each search. The fastest is reported
+    int repetitions = 3;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            size = atoi(optarg);
+            break;
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (size < 2 || repetitions < 1)
+    {
+        fprintf(stderr, "The map must be at least 2x2, and there must be at least 1 repetition\n");
+        return 1;
+    }
+
+    Search searches[] = {
+        {"char grid", grid_min_steps, grid_flood_fill},
+        {"whole map", whole_min_steps, whole_flood_fill},
+        {"frontier", frontier_min_steps, frontier_flood_fill},
+    };
+    // Walls on a tenth of the cells leave wide open areas. With a quarter, the free cells still connect, but the frontier
+    // is ragged, with fewer of its cells in each word
+    int wall_percents[] = {10, 25};
+
+    printf("%-6s %-10s %12s %12s %10s %14s %10s\n", "Walls", "Search", "Steps", "Steps (ms)", "Region", "Fill (ms)",
+           "Mcells/s");
+    for (size_t w = 0; w < sizeof(wall_percents) / sizeof(wall_percents[0]); w++)
+    {
+        seed_random(DEFAULT_SEED);
+        Grid map = make_map(size, wall_percents[w]);
+        Bitboard free = bitboard_from_grid(map, '.');
+
+        long long expected_steps = 0LL;
+        long expected_region = 0L;
+        for (size_t s = 0; s < sizeof(searches) / sizeof(searches[0]); s++)
+        {
+            if (searches[s].min_steps == whole_min_steps && size > WHOLE_MAP_MAX_SIZE)
+                continue;
+            long long steps_ns = -1LL, fill_ns = -1LL, steps = 0LL;
+            long region = 0L;
+            for (int r = 0; r < repetitions; r++)
+            {
+                long long start = now_ns();
+                steps = searches[s].min_steps(map, free);
+                long long ns = now_ns() - start;
+                if (steps_ns < 0 || ns < steps_ns)
+                    steps_ns = ns;
+
+                start = now_ns();
+                region = searches[s].flood_fill(map, free);
+                ns = now_ns() - start;
+                if (fill_ns < 0 || ns < fill_ns)
+                    fill_ns = ns;
+            }
+            // The char grid is first, so it gives the expected results for the rest
+            if (!s)
+            {
+                expected_steps = steps;
+                expected_region = region;
+            }
+            char walls[8];
+            snprintf(walls, sizeof(walls), "%d%%", wall_percents[w]);
+            printf("%-6s %-10s %12lld %12.3f %10ld %14.3f %10.1f%s\n", walls, searches[s].name, steps, steps_ns / 1e6,
+                   region, fill_ns / 1e6, region * 1e3 / (fill_ns ? fill_ns : 1),
+                   steps == expected_steps && region == expected_region ? "" : " MISMATCH");
+        }
+
+        delete_bitboard(&free);
+        delete_grid(&map);
+    }
+    return 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr, "Usage: %s [-n SIZE] [-r REPETITIONS]\n", program_name);
+}
+
+/// @brief Make a square map of '.' with some random cells '#'. The corners are always '.'
+/// @param size The number of rows and columns
+/// @param wall_percent The percent of cells that are '#'
+/// @return The map, with a border of '#'. Delete with delete_grid
+Grid make_map(int size, int wall_percent)
+{
+    Grid map = new_grid(size, size, 1, '.', '#');
+    for (int row = 0; row < size; row++)
+        for (int col = 0; col < size; col++)
+            if (random_range(0, 99) < wall_percent)
+                GRID_CELL(map, row, col) = '#';
+    GRID_CELL(map, 0, 0) = GRID_CELL(map, size - 1, size - 1) = '.';
+    return map;
+}
+
+/// @brief Search a char grid outwards from the top left, one cell at a time, with a queue
+/// @param map The map
+/// @param end The index of the cell to stop at, or -1 to search the whole region
+/// @param steps Out: The steps to `end`, or -1 if it wasn't reached
+/// @return The number of cells reached
+long grid_search(Grid map, long end, long long *steps)
+{
+    char *visited = NEW_GRID_LAYER(map, char);
+    int *queue = malloc(sizeof(queue[0]) * map.rows * map.cols);
+    size_t head = 0UL, tail = 0UL;
+    int start = GRID_INDEX(map, 0, 0);
+    queue[tail++] = start;
+    visited[start] = 1;
+    *steps = -1LL;
+
+    // Each pass of the outer loop takes every cell at the same distance
+    for (long long distance = 0LL; head < tail && *steps < 0; distance++)
+        for (size_t level_end = tail; head < level_end; head++)
+        {
+            int index = queue[head];
+            if (index == end)
+            {
+                *steps = distance;
+                break;
+            }
+            for (int dir = 0; dir < GRID_DIRECTIONS; dir++)
+            {
+                int next = index + map.step[dir];
+                if (map.cells[next] == '.' && !visited[next])
+                {
+                    visited[next] = 1;
+                    queue[tail++] = next;
+                }
+            }
+        }
+
+    free(visited);
+    free(queue);
+    return (long)tail;
+}
+
+long long grid_min_steps(Grid map, Bitboard free)
+{
+    long long steps;
+    grid_search(map, GRID_INDEX(map, map.rows - 1, map.cols - 1), &steps);
+    return steps;
+}
+
+long grid_flood_fill(Grid map, Bitboard free)
+{
+    long long steps;
+    return grid_search(map, -1L, &steps);
+}
+
+/// @brief Search a bitboard outwards from the top left, stepping every word of the map each step with bitboard_shift
+/// @param free The cells that can be stepped on
+/// @param visited In/out: The cells reached, starting with the top left
+/// @param end_row The row of the cell to stop at, or -1 to search the whole region
+/// @param end_col The column of the cell to stop at
+/// @return The steps to the end, or to the last cells reached if there is no end
+long long whole_search(Bitboard free, Bitboard visited, int end_row, int end_col)
+{
+    Bitboard frontier = copy_bitboard(visited), next = new_bitboard(free.rows, free.cols),
+             shifted = new_bitboard(free.rows, free.cols);
+    long long steps = 0LL;
+    while (end_row < 0 || !bitboard_test(visited, end_row, end_col))
+    {
+        bitboard_clear(next);
+        for (int dir = 0; dir < GRID_DIRECTIONS; dir++)
+        {
+            bitboard_shift(shifted, frontier, dir);
+            bitboard_or(next, next, shifted);
+        }
+        bitboard_and(next, next, free);
+        bitboard_andnot(frontier, next, visited);
+        if (!bitboard_any(frontier))
+        {
+            if (end_row >= 0)
+                steps = -1LL;
+            break;
+        }
+        bitboard_or(visited, visited, frontier);
+        steps++;
+    }
+    delete_bitboard(&frontier);
+    delete_bitboard(&next);
+    delete_bitboard(&shifted);
+    return steps;
+}
+
+long long whole_min_steps(Grid map, Bitboard free)
+{
+    Bitboard visited = new_bitboard(free.rows, free.cols);
+    bitboard_set(visited, 0, 0);
+    long long steps = whole_search(free, visited, free.rows - 1, free.cols - 1);
+    delete_bitboard(&visited);
+    return steps;
+}
+
+long whole_flood_fill(Grid map, Bitboard free)
+{
+    Bitboard region = new_bitboard(free.rows, free.cols);
+    bitboard_set(region, 0, 0);
+    whole_search(free, region, -1, -1);
+    long count = bitboard_count(region);
+    delete_bitboard(&region);
+    return count;
+}
+
+long long frontier_min_steps(Grid map, Bitboard free)
+{
+    return bitboard_min_steps(free, 0, 0, free.rows - 1, free.cols - 1, NULL);
+}
+
+long frontier_flood_fill(Grid map, Bitboard free)
+{
+    Bitboard region = new_bitboard(free.rows, free.cols);
+    bitboard_set(region, 0, 0);
+    long count = bitboard_flood_fill(free, region);
+    delete_bitboard(&region);
+    return count;
+}
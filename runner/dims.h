@@ -0,0 +1,38 @@
+#ifndef DIMS_H
+#define DIMS_H
+
+// Copies of a function for the map sizes real inputs have, so inside each copy the size is a constant
+// A day writes the function as NAME_impl, taking the size as its last parameters and marked DIMS_INLINE, and
+// DEF_SIZE_DISPATCH defines NAME, which takes the size at runtime and calls a copy of NAME_impl where the size is a
+// literal. Divisions by it become multiplications, and loops over a row can unroll. Any other size (e.g. the examples)
+// goes to NAME_generic, which reads the size at runtime like before.
+//
+// Everything NAME_impl calls with the size must be DIMS_INLINE too, or the constant stops at the call.
+// `make dims-bench` shows what each specialized size gains. Only wrapping around a size gains much; stepping through a
+// grid of a constant width doesn't, so widths alone aren't specialized.
+
+// Inline a function into every caller, even without optimization, so each copy of the caller keeps its constants
+#define DIMS_INLINE inline __attribute__((always_inline))
+
+// The map sizes (width, height) of real inputs: day 14's bathroom
+#define DIM_SIZES(X, ...) X(101, 103, __VA_ARGS__)
+
+#define DIMS_UNPAREN(...) __VA_ARGS__
+#define DIMS_SIZE_CASE(width, height, name, args) \
+    if (dims_width == (width) && dims_height == (height)) \
+        return name##_impl(DIMS_UNPAREN args, width, height);
+
+// Define `static ret name(params..., int width, int height)`, which calls `name##_impl(args..., width, height)` with both
+// as literals if they are one of DIM_SIZES, and name##_generic otherwise
+#define DEF_SIZE_DISPATCH(ret, name, params, args)                                                    \
+    static __attribute__((noinline)) ret name##_generic(DIMS_UNPAREN params, int width, int height)    \
+    {                                                                                                 \
+        return name##_impl(DIMS_UNPAREN args, width, height);                                         \
+    }                                                                                                 \
+    static ret name(DIMS_UNPAREN params, int dims_width, int dims_height)                             \
+    {                                                                                                 \
+        DIM_SIZES(DIMS_SIZE_CASE, name, args)                                                         \
+        return name##_generic(DIMS_UNPAREN args, dims_width, dims_height);                            \
+    }
+
+#endif
@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dims.h"
+#include "generator.h"
+#include "timer.h"
+
+// Compare the copies that dims.h makes for each size in DIM_SIZES with the generic copy that reads the size at runtime, on
+// a loop like day 14's. Both copies do the same work, so they must get the same checksum
+
+typedef struct Robot
+{
+    short x, y, vx, vy;
+} Robot;
+
+void print_usage(char *program_name);
+void print_result(char *kernel, char *size, long long work, long long generic_ns, long long generic_checksum,
+                  long long specialized_ns, long long specialized_checksum);
+
+/// @brief Move every robot for some seconds, wrapping around the edges, like day 14's robots
+/// @param robots The robots, which are moved
+/// @param robots_size The number of robots
+/// @param seconds The number of seconds to move them for
+/// @param width The width of the map
+/// @param height The height of the map
+/// @return The sum of the final positions
+static DIMS_INLINE long long move_robots_impl(Robot *robots, int robots_size, int seconds, int width, int height)
+{
+    for (int second = 0; second < seconds; second++)
+        for (int i = 0; i < robots_size; i++)
+        {
+            robots[i].x = ((robots[i].x + robots[i].vx) % width + width) % width;
+            robots[i].y = ((robots[i].y + robots[i].vy) % height + height) % height;
+        }
+
+    long long checksum = 0LL;
+    for (int i = 0; i < robots_size; i++)
+        checksum += (robots[i].y * width) + robots[i].x;
+    return checksum;
+}
+DEF_SIZE_DISPATCH(long long, move_robots, (Robot *robots, int robots_size, int seconds), (robots, robots_size, seconds))
+
+// Every size in DIM_SIZES, as an array
+#define SIZE_ENTRY(width, height, ...) {width, height},
+static const int SIZES[][2] = {DIM_SIZES(SIZE_ENTRY, )};
+
+// Time `call` `repetitions` times, putting the fastest time in `min_ns` and the result in `checksum`
+#define TIME_MIN(min_ns, checksum, call)               \
+    do                                                 \
+    {                                                  \
+        min_ns = -1LL;                                 \
+        for (int r = 0; r < repetitions; r++)          \
+        {                                              \
+            long long start = now_ns();                \
+            checksum = (call);                         \
+            long long ns = now_ns() - start;           \
+            if (min_ns < 0 || ns < min_ns)             \
+                min_ns = ns;                           \
+        }                                              \
+    } while (0)
+
+int main(int argc, char *argv[])
+{
+    // The number of runs of each copy. The fastest is reported
+    int repetitions = 20;
+    // The number of seconds the robots move in each run
+    int seconds = 1000;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (repetitions < 1)
+    {
+        fprintf(stderr, "The number of repetitions must be at least 1\n");
+        return 1;
+    }
+
+    printf("%-8s %-10s %14s %14s %9s %20s\n", "Kernel", "Size", "Generic (ns)", "Fixed (ns)", "Speedup", "Checksum");
+    long long generic_ns, specialized_ns, generic_checksum, specialized_checksum;
+    char size_name[32];
+    for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); s++)
+    {
+        int width = SIZES[s][0], height = SIZES[s][1];
+        snprintf(size_name, sizeof(size_name), "%dx%d", width, height);
+
+        // Per robot per second. Each run starts from the same robots
+        seed_random(DEFAULT_SEED);
+        int robots_size = 500;
+        Robot *initial = malloc(sizeof(initial[0]) * robots_size);
+        Robot *robots = malloc(sizeof(robots[0]) * robots_size);
+        for (int i = 0; i < robots_size; i++)
+            initial[i] = (Robot){random_range(0, width - 1), random_range(0, height - 1), random_range(-width + 1, width - 1),
+                                 random_range(-height + 1, height - 1)};
+        TIME_MIN(generic_ns, generic_checksum,
+                 (memcpy(robots, initial, sizeof(robots[0]) * robots_size),
+                  move_robots_generic(robots, robots_size, seconds, width, height)));
+        TIME_MIN(specialized_ns, specialized_checksum,
+                 (memcpy(robots, initial, sizeof(robots[0]) * robots_size),
+                  move_robots(robots, robots_size, seconds, width, height)));
+        print_result("robots", size_name, (long long)robots_size * seconds, generic_ns, generic_checksum, specialized_ns,
+                     specialized_checksum);
+
+        free(initial);
+        free(robots);
+    }
+    return 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr, "Usage: %s [-r REPETITIONS]\n", program_name);
+}
+
+/// @brief Print a row of the table, flagging copies that disagree
+/// @param kernel The name of the loop
+/// @param size The size of the map
+/// @param work The number of moves in each run, to report the time of each
+/// @param generic_ns The fastest run of the generic copy
+/// @param generic_checksum The result of the generic copy
+/// @param specialized_ns The fastest run of the specialized copy
+/// @param specialized_checksum The result of the specialized copy
+void print_result(char *kernel, char *size, long long work, long long generic_ns, long long generic_checksum,
+                  long long specialized_ns, long long specialized_checksum)
+{
+    printf("%-8s %-10s %14.3f %14.3f %8.2fx %20lld%s\n", kernel, size, (double)generic_ns / work, (double)specialized_ns / work,
+           (double)generic_ns / (specialized_ns ? specialized_ns : 1), specialized_checksum,
+           generic_checksum == specialized_checksum ? "" : " MISMATCH");
+}
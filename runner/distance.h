@@ -0,0 +1,110 @@
+#ifndef DISTANCE_H
+#define DISTANCE_H
+
+// The total distance between two arrays of ints: the sum of |a[i] - b[i]|
+// Each distance is max - min as an unsigned 32 bit int, which is exact for any two ints, and is summed in 64 bits so long
+// arrays can't overflow. On x86, total_distance picks the widest version the CPU runs when it is first called: AVX2 (8
+// ints at a time), SSE4.1 (4 at a time), or plain C. Each is compiled for its own instruction set with a target
+// attribute, so the same binary runs on any x86-64 CPU whatever -march it was built with.
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __x86_64__
+#define DISTANCE_X86
+#include <immintrin.h>
+#endif
+
+typedef long long (*TotalDistanceFn)(const int *a, const int *b, size_t n);
+
+/// @brief Get the total distance between two arrays one pair at a time
+/// @param a The first array
+/// @param b The second array
+/// @param n The length of both arrays
+/// @return The sum of |a[i] - b[i]|
+static inline long long total_distance_scalar(const int *a, const int *b, size_t n)
+{
+    uint64_t sum = 0ULL;
+    for (size_t i = 0; i < n; i++)
+        sum += a[i] > b[i] ? (uint32_t)a[i] - (uint32_t)b[i] : (uint32_t)b[i] - (uint32_t)a[i];
+    return (long long)sum;
+}
+
+#ifdef DISTANCE_X86
+
+// total_distance_scalar, 4 pairs at a time with SSE4.1
+__attribute__((target("sse4.1"))) static inline long long total_distance_sse41(const int *a, const int *b, size_t n)
+{
+    __m128i sums = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)&a[i]);
+        __m128i vb = _mm_loadu_si128((const __m128i *)&b[i]);
+        __m128i distances = _mm_sub_epi32(_mm_max_epi32(va, vb), _mm_min_epi32(va, vb));
+        // Widen the 4 distances to 64 bits before adding, 2 at a time
+        sums = _mm_add_epi64(sums, _mm_cvtepu32_epi64(distances));
+        sums = _mm_add_epi64(sums, _mm_cvtepu32_epi64(_mm_srli_si128(distances, 8)));
+    }
+    uint64_t sum = (uint64_t)_mm_cvtsi128_si64(sums) + (uint64_t)_mm_extract_epi64(sums, 1);
+    return (long long)sum + total_distance_scalar(a + i, b + i, n - i);
+}
+
+// total_distance_scalar, 8 pairs at a time with AVX2
+__attribute__((target("avx2"))) static inline long long total_distance_avx2(const int *a, const int *b, size_t n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    // Two blocks of 8 at a time, each with two accumulators, so each add doesn't wait for the last
+    __m256i sums[4] = {zero, zero, zero, zero};
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        for (int block = 0; block < 2; block++)
+        {
+            __m256i va = _mm256_loadu_si256((const __m256i *)&a[i + (8 * block)]);
+            __m256i vb = _mm256_loadu_si256((const __m256i *)&b[i + (8 * block)]);
+            __m256i distances = _mm256_sub_epi32(_mm256_max_epi32(va, vb), _mm256_min_epi32(va, vb));
+            // Zero extend by interleaving with zeros. The halves of each lane are mixed up, but they all get summed anyway
+            sums[2 * block] = _mm256_add_epi64(sums[2 * block], _mm256_unpacklo_epi32(distances, zero));
+            sums[(2 * block) + 1] = _mm256_add_epi64(sums[(2 * block) + 1], _mm256_unpackhi_epi32(distances, zero));
+        }
+    __m256i sum_all = _mm256_add_epi64(_mm256_add_epi64(sums[0], sums[1]), _mm256_add_epi64(sums[2], sums[3]));
+    __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sum_all), _mm256_extracti128_si256(sum_all, 1));
+    uint64_t sum = (uint64_t)_mm_cvtsi128_si64(halves) + (uint64_t)_mm_extract_epi64(halves, 1);
+    return (long long)sum + total_distance_scalar(a + i, b + i, n - i);
+}
+
+#endif
+
+/// @brief Get the version of total_distance for this CPU
+/// @return The widest version the CPU supports
+static inline TotalDistanceFn pick_total_distance()
+{
+#ifdef DISTANCE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return total_distance_avx2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return total_distance_sse41;
+#endif
+    return total_distance_scalar;
+}
+
+/// @brief Get the total distance between two arrays, with the widest SIMD the CPU supports
+/// @param a The first array
+/// @param b The second array
+/// @param n The length of both arrays
+/// @return The sum of |a[i] - b[i]|
+static inline long long total_distance(const int *a, const int *b, size_t n)
+{
+    // Threads that race to set this all pick the same version, and only the pointer is shared, so relaxed is enough
+    static _Atomic TotalDistanceFn chosen = NULL;
+    TotalDistanceFn fn = atomic_load_explicit(&chosen, memory_order_relaxed);
+    if (!fn)
+    {
+        fn = pick_total_distance();
+        atomic_store_explicit(&chosen, fn, memory_order_relaxed);
+    }
+    return fn(a, b, n);
+}
+
+#endif
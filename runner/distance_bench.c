@@ -0,0 +1,105 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "distance.h"
+#include "generator.h"
+#include "timer.h"
+
+// Compare the versions of total_distance in distance.h on arrays from the L1 cache's size to well past the last level
+// cache's, in GB/s of both arrays read. Once the arrays only fit in memory, every version is limited by memory bandwidth
+// Every version must get the same total, or its row is marked MISMATCH
+
+typedef struct Version
+{
+    char *name;
+    TotalDistanceFn fn;
+    // Whether this CPU can run it
+    bool supported;
+} Version;
+
+void print_usage(char *program_name);
+
+int main(int argc, char *argv[])
+{
+    // The number of runs of each version. The fastest is reported
+    int repetitions = 5;
+    // The largest number of pairs. Each size is 16 times the last, starting at 2^10
+    long long max_size = 1LL << 26;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            max_size = atoll(optarg);
+            break;
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (max_size < 1 || repetitions < 1)
+    {
+        fprintf(stderr, "The number of pairs and repetitions must be at least 1\n");
+        return 1;
+    }
+
+    Version versions[] = {
+        {"scalar", total_distance_scalar, true},
+#ifdef DISTANCE_X86
+        {"sse4.1", total_distance_sse41, __builtin_cpu_supports("sse4.1")},
+        {"avx2", total_distance_avx2, __builtin_cpu_supports("avx2")},
+#endif
+        {"total_distance", total_distance, true},
+    };
+
+    printf("%-14s %12s %10s %10s %22s\n", "Version", "Pairs", "ns/pair", "GB/s", "Total");
+    for (long long size = 1LL << 10; size <= max_size; size *= 16)
+    {
+        // Sorted lists of 5 digit IDs, like day 1's
+        seed_random(DEFAULT_SEED);
+        int *a = malloc(sizeof(a[0]) * size);
+        int *b = malloc(sizeof(b[0]) * size);
+        for (long long i = 0; i < size; i++)
+        {
+            a[i] = 10000 + (int)((90000 * i) / size) + random_range(0, 99);
+            b[i] = 10000 + (int)((90000 * i) / size) + random_range(0, 99);
+        }
+        // Small arrays are summed many times in each run, so the time is long enough to measure
+        long long loops = size < (1LL << 24) ? (1LL << 24) / size : 1LL;
+
+        long long expected = total_distance_scalar(a, b, size);
+        for (size_t v = 0; v < sizeof(versions) / sizeof(versions[0]); v++)
+        {
+            if (!versions[v].supported)
+                continue;
+            long long min_ns = -1LL, total = 0LL;
+            for (int r = 0; r < repetitions; r++)
+            {
+                long long start = now_ns();
+                for (long long l = 0; l < loops; l++)
+                    total = versions[v].fn(a, b, size);
+                long long ns = now_ns() - start;
+                if (min_ns < 0 || ns < min_ns)
+                    min_ns = ns;
+            }
+            double pairs = (double)size * loops;
+            printf("%-14s %12lld %10.3f %10.2f %22lld%s\n", versions[v].name, size, min_ns / pairs,
+                   pairs * 2 * sizeof(a[0]) / (min_ns ? min_ns : 1), total, total == expected ? "" : " MISMATCH");
+        }
+        free(a);
+        free(b);
+    }
+    return 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr, "Usage: %s [-n MAX_PAIRS] [-r REPETITIONS]\n", program_name);
+}
@@ -0,0 +1,136 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+// Helpers shared by each day's generate_input.c
+// Every generator is run as `generate_input [SCALE] [SEED]` and writes a valid input to stdout.
+// The same scale and seed always give the same input, so generated inputs can be used for benchmarks.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// The seed used if none is given
+#define DEFAULT_SEED 2024
+
+// State of the random number generator (splitmix64)
+static uint64_t random_state = DEFAULT_SEED;
+
+static inline void seed_random(uint64_t seed)
+{
+    random_state = seed;
+}
+
+// Get the next 64 random bits
+static inline uint64_t next_random()
+{
+    uint64_t z = (random_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Get a random number in [min, max]
+static inline long long random_range(long long min, long long max)
+{
+    return min + (long long)(next_random() % (uint64_t)(max - min + 1));
+}
+
+// Shuffle an int array in place (Fisher-Yates)
+static inline void shuffle_ints(int *arr, size_t arr_size)
+{
+    for (size_t i = arr_size; i > 1; i--)
+    {
+        size_t j = next_random() % i;
+        int temp = arr[i - 1];
+        arr[i - 1] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+/// @brief Carve a random maze with exactly one path between any two open tiles (randomized depth-first search).
+/// Open tiles are at odd rows and columns, and the tiles between them are opened to connect them.
+/// @param map Out: A size * size map, which will be filled with '#' and '.'
+/// @param size The number of rows and columns. Must be odd
+/// @param start The index in `map` to start carving from. Must be at an odd row and column
+/// @param parent Out: If not NULL, the index of the previous open tile on the path to `start` for every open tile at an odd row and column
+static inline void generate_maze(char *map, long long size, long long start, long long *parent)
+{
+    const long long STEP[] = {-size, 1, size, -1};
+
+    for (long long i = 0; i < size * size; i++)
+        map[i] = '#';
+
+    long long *stack = malloc(sizeof(stack[0]) * size * size / 4 + 1);
+    size_t stack_size = 0;
+    stack[stack_size++] = start;
+    map[start] = '.';
+    if (parent)
+        parent[start] = start;
+
+    while (stack_size)
+    {
+        long long tile = stack[stack_size - 1];
+        long long row = tile / size;
+        long long col = tile % size;
+
+        // Find the unvisited tiles 2 steps away
+        long long options[4];
+        int options_size = 0;
+        for (int dir = 0; dir < 4; dir++)
+        {
+            long long next_row = row + 2 * (STEP[dir] / size);
+            long long next_col = col + 2 * (STEP[dir] % size);
+            if (next_row > 0 && next_row < size - 1 && next_col > 0 && next_col < size - 1 && map[tile + 2 * STEP[dir]] == '#')
+                options[options_size++] = dir;
+        }
+
+        if (!options_size)
+        {
+            stack_size--;
+            continue;
+        }
+
+        // Open the wall between this and a random neighbor, then continue from there
+        long long dir = options[random_range(0, options_size - 1)];
+        long long next = tile + 2 * STEP[dir];
+        map[tile + STEP[dir]] = '.';
+        map[next] = '.';
+        if (parent)
+            parent[next] = tile;
+        stack[stack_size++] = next;
+    }
+
+    free(stack);
+}
+
+/// @brief Read SCALE and SEED from the command line, seeding the random number generator
+/// @param argc The argument count from main
+/// @param argv The arguments from main
+/// @param default_scale The scale of the real puzzle input
+/// @param min_scale The smallest scale this generator can make a valid input for
+/// @param max_scale The largest scale the input format can represent
+/// @param scale_description What the scale means for this day, for the usage message
+/// @return The scale, or -1 if the arguments are invalid
+static inline long long parse_generator_args(int argc, char *argv[], long long default_scale, long long min_scale, long long max_scale, char *scale_description)
+{
+    // "-" keeps the default scale so only the seed can be given
+    long long scale = (argc >= 2 && strcmp(argv[1], "-")) ? atoll(argv[1]) : default_scale;
+    uint64_t seed = (argc >= 3) ? strtoull(argv[2], NULL, 10) : DEFAULT_SEED;
+
+    if (argc > 3 || scale < min_scale || scale > max_scale)
+    {
+        fprintf(stderr,
+                "Usage: %s [SCALE] [SEED]\n"
+                "Write a generated input to stdout.\n"
+                "  SCALE  %s, from %lld to %lld (default or -: %lld, the size of the real input)\n"
+                "  SEED   The random seed (default: %d)\n",
+                argv[0], scale_description, min_scale, max_scale, default_scale, DEFAULT_SEED);
+        return -1;
+    }
+
+    seed_random(seed);
+    return scale;
+}
+
+#endif
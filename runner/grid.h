@@ -0,0 +1,136 @@
+#ifndef GRID_H
+#define GRID_H
+
+// Two dimensional maps in one contiguous allocation
+// The map is surrounded by a border of sentinel cells, so a step off the edge of the map lands on a sentinel instead of
+// out of bounds. As long as the border is as wide as the longest step, neighbours can be visited without bounds checks.
+// Every cell is addressed by one index, and side arrays (found flags, distances, etc.) share that index.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "input.h"
+
+// The four directions, counter-clockwise starting from east, so turning left is (dir + 1) % GRID_DIRECTIONS
+typedef enum GridDirection
+{
+    GRID_EAST,
+    GRID_NORTH,
+    GRID_WEST,
+    GRID_SOUTH,
+    GRID_DIRECTIONS,
+} GridDirection;
+
+typedef struct Grid
+{
+    // Every cell, including the border, row by row
+    char *cells;
+    // The size of the map, not including the border
+    int rows, cols;
+    // The number of sentinel cells on each side of the map
+    int border;
+    // The number of cells in each row, including the border on both sides
+    int stride;
+    // The number of cells, including the border
+    size_t size;
+    // The change in index for one step in each GridDirection
+    int step[GRID_DIRECTIONS];
+} Grid;
+
+// The index of a cell. `row` and `col` are relative to the map, so the border starts at row -1 and column -1
+#define GRID_INDEX(grid, row, col) ((((row) + (grid).border) * (grid).stride) + (col) + (grid).border)
+#define GRID_CELL(grid, row, col) ((grid).cells[GRID_INDEX(grid, row, col)])
+
+// Allocate a zeroed side array of `type` with an element for every cell of `grid`, indexed the same way as the cells
+#define NEW_GRID_LAYER(grid, type) ((type *)calloc((grid).size, sizeof(type)))
+
+/// @brief Allocate a grid
+/// @param rows The number of rows in the map
+/// @param cols The number of columns in the map
+/// @param border The number of sentinel cells on each side of the map
+/// @param fill The value of every cell in the map
+/// @param sentinel The value of every cell in the border
+/// @return The grid. Delete with delete_grid
+static inline Grid new_grid(int rows, int cols, int border, char fill, char sentinel)
+{
+    Grid grid = {.rows = rows, .cols = cols, .border = border, .stride = cols + (2 * border)};
+    grid.size = (size_t)grid.stride * (rows + (2 * border));
+    grid.step[GRID_EAST] = 1;
+    grid.step[GRID_NORTH] = -grid.stride;
+    grid.step[GRID_WEST] = -1;
+    grid.step[GRID_SOUTH] = grid.stride;
+
+    grid.cells = malloc(sizeof(grid.cells[0]) * (grid.size ? grid.size : 1));
+    memset(grid.cells, sentinel, grid.size);
+    if (fill != sentinel)
+        for (int row = 0; row < rows; row++)
+            memset(&GRID_CELL(grid, row, 0), fill, cols);
+    return grid;
+}
+
+/// @brief Copy a grid from the input into a new grid with a border
+/// @param view The grid in the input
+/// @param border The number of sentinel cells on each side of the map
+/// @param sentinel The value of every cell in the border
+/// @return The grid. Delete with delete_grid
+static inline Grid grid_from_view(GridView view, int border, char sentinel)
+{
+    Grid grid = new_grid(view.rows, view.cols, border, sentinel, sentinel);
+    for (int row = 0; row < grid.rows; row++)
+        memcpy(&GRID_CELL(grid, row, 0), &GRID_AT(view, row, 0), view.cols);
+    return grid;
+}
+
+// Copy every cell of a grid, including the border, into a new grid
+static inline Grid copy_grid(Grid grid)
+{
+    Grid copy = grid;
+    copy.cells = malloc(sizeof(copy.cells[0]) * (grid.size ? grid.size : 1));
+    memcpy(copy.cells, grid.cells, grid.size);
+    return copy;
+}
+
+static inline void delete_grid(Grid *grid)
+{
+    free(grid->cells);
+    grid->cells = NULL;
+    grid->size = 0UL;
+}
+
+// The row of the cell at `index`, relative to the map
+static inline int grid_row(Grid grid, int index) { return (index / grid.stride) - grid.border; }
+// The column of the cell at `index`, relative to the map
+static inline int grid_col(Grid grid, int index) { return (index % grid.stride) - grid.border; }
+
+/// @brief Get the direction of an arrow character
+/// @param arrow One of [>^<v]
+/// @return The direction, or -1 if `arrow` is not an arrow
+static inline int grid_direction(char arrow)
+{
+    switch (arrow)
+    {
+    case '>':
+        return GRID_EAST;
+    case '^':
+        return GRID_NORTH;
+    case '<':
+        return GRID_WEST;
+    case 'v':
+        return GRID_SOUTH;
+    default:
+        return -1;
+    }
+}
+
+// Print every row of the map to stdout, without the border
+static inline void print_grid(Grid grid)
+{
+    for (int row = 0; row < grid.rows; row++)
+    {
+        fwrite(&GRID_CELL(grid, row, 0), sizeof(grid.cells[0]), grid.cols, stdout);
+        putchar('\n');
+    }
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+// Hash maps of any key and value type, with open addressing
+// DEF_HASHMAP(K, V) defines K##_##V##_HashMap, which maps K to V. K and V must be single identifiers, so typedef
+// pointer and multi-word types first. The map uses hash_##K(K) and equal_##K(K, K), which are defined below for
+// IntKey, PtrKey, and StrKey. Define them before DEF_HASHMAP to use any other key type.
+//
+// Entries are stored in one array and collisions probe the next slots (Robin Hood hashing: an entry takes the slot of
+// one that is closer to its home slot, which keeps every probe short). Each entry keeps its hash, so most mismatches
+// are found without comparing keys, and growing never hashes a key again.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Grow when the map would be more than HASHMAP_MAX_LOAD / HASHMAP_LOAD_SCALE full
+#define HASHMAP_MAX_LOAD 7
+#define HASHMAP_LOAD_SCALE 8
+#define HASHMAP_MIN_CAP 16UL
+// Set in every stored hash, so a stored hash of 0 means the slot is empty
+#define HASHMAP_OCCUPIED 0x80000000U
+
+// Integer keys
+typedef long long IntKey;
+// Pointer keys, compared by address rather than by what they point to
+typedef const void *PtrKey;
+// Strings of at most 8 characters, packed into an integer by str_key. Compared in one instruction
+typedef uint64_t StrKey;
+
+// Spread the bits of an integer over the whole hash (the splitmix64 finalizer)
+static inline uint64_t hash_mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static inline uint64_t hash_IntKey(IntKey key) { return hash_mix((uint64_t)key); }
+static inline bool equal_IntKey(IntKey a, IntKey b) { return a == b; }
+static inline uint64_t hash_PtrKey(PtrKey key) { return hash_mix((uintptr_t)key); }
+static inline bool equal_PtrKey(PtrKey a, PtrKey b) { return a == b; }
+static inline uint64_t hash_StrKey(StrKey key) { return hash_mix(key); }
+static inline bool equal_StrKey(StrKey a, StrKey b) { return a == b; }
+
+// Pack the first 8 characters of `str` (or fewer, up to the null terminator) into a StrKey
+static inline StrKey str_key(const char *str)
+{
+    StrKey key = 0ULL;
+    memcpy(&key, str, strnlen(str, sizeof(key)));
+    return key;
+}
+
+#define DEF_HASHMAP(K, V)                                                                                             \
+    typedef struct K##_##V##_HashMapEntry                                                                             \
+    {                                                                                                                 \
+        K key;                                                                                                        \
+        V value;                                                                                                      \
+        /* The hash of `key` with HASHMAP_OCCUPIED set, or 0 if the slot is empty */                                  \
+        uint32_t hash;                                                                                                \
+    } K##_##V##_HashMapEntry;                                                                                         \
+                                                                                                                      \
+    typedef struct K##_##V##_HashMap                                                                                  \
+    {                                                                                                                 \
+        /* `cap` slots, a power of 2. Iterate over every slot with a non-zero hash to visit every entry */            \
+        K##_##V##_HashMapEntry *entries;                                                                              \
+        size_t cap;                                                                                                   \
+        size_t len;                                                                                                   \
+    } K##_##V##_HashMap;                                                                                              \
+                                                                                                                      \
+    static inline K##_##V##_HashMap new_##K##_##V##_HashMap() { return (K##_##V##_HashMap){NULL, 0UL, 0UL}; }         \
+                                                                                                                      \
+    static inline uint32_t K##_##V##_HashMap_hash(K key) { return (uint32_t)hash_##K(key) | HASHMAP_OCCUPIED; }       \
+                                                                                                                      \
+    /* Put an entry whose key is not in the map into a map with room for it */                                        \
+    static inline void K##_##V##_HashMap_insert(K##_##V##_HashMap *map, K##_##V##_HashMapEntry entry)                 \
+    {                                                                                                                 \
+        size_t mask = map->cap - 1;                                                                                   \
+        size_t i = entry.hash & mask;                                                                                 \
+        size_t dist = 0UL;                                                                                            \
+        while (map->entries[i].hash)                                                                                  \
+        {                                                                                                             \
+            /* Take the slot from an entry that is closer to home, and keep looking for a slot for that one */        \
+            size_t other_dist = (i - map->entries[i].hash) & mask;                                                    \
+            if (other_dist < dist)                                                                                    \
+            {                                                                                                         \
+                K##_##V##_HashMapEntry other = map->entries[i];                                                       \
+                map->entries[i] = entry;                                                                              \
+                entry = other;                                                                                        \
+                dist = other_dist;                                                                                    \
+            }                                                                                                         \
+            i = (i + 1) & mask;                                                                                       \
+            dist++;                                                                                                   \
+        }                                                                                                             \
+        map->entries[i] = entry;                                                                                      \
+        map->len++;                                                                                                   \
+    }                                                                                                                 \
+                                                                                                                      \
+    /* Make room for at least `len` entries without growing again */                                                  \
+    static inline void reserve_##K##_##V##_HashMap(K##_##V##_HashMap *map, size_t len)                                \
+    {                                                                                                                 \
+        size_t cap = map->cap ? map->cap : HASHMAP_MIN_CAP;                                                           \
+        while (len * HASHMAP_LOAD_SCALE > cap * HASHMAP_MAX_LOAD)                                                     \
+            cap *= 2;                                                                                                 \
+        if (cap == map->cap)                                                                                          \
+            return;                                                                                                   \
+        K##_##V##_HashMap old = *map;                                                                                 \
+        map->entries = calloc(cap, sizeof(map->entries[0]));                                                          \
+        map->cap = cap;                                                                                               \
+        map->len = 0UL;                                                                                               \
+        for (size_t i = 0; i < old.cap; i++)                                                                          \
+            if (old.entries[i].hash)                                                                                  \
+                K##_##V##_HashMap_insert(map, old.entries[i]);                                                        \
+        free(old.entries);                                                                                            \
+    }                                                                                                                 \
+                                                                                                                      \
+    /* Find the entry for `key`, or NULL if it is not in the map */                                                   \
+    static inline K##_##V##_HashMapEntry *find_##K##_##V##_HashMap(K##_##V##_HashMap *map, K key)                     \
+    {                                                                                                                 \
+        if (!map->len)                                                                                                \
+            return NULL;                                                                                              \
+        uint32_t hash = K##_##V##_HashMap_hash(key);                                                                  \
+        size_t mask = map->cap - 1;                                                                                   \
+        /* Once the probe is farther from home than the entry in the slot, the key would have taken that slot */      \
+        for (size_t i = hash & mask, dist = 0UL; map->entries[i].hash && ((i - map->entries[i].hash) & mask) >= dist; \
+             i = (i + 1) & mask, dist++)                                                                              \
+            if (map->entries[i].hash == hash && equal_##K(map->entries[i].key, key))                                  \
+                return &map->entries[i];                                                                              \
+        return NULL;                                                                                                  \
+    }                                                                                                                 \
+                                                                                                                      \
+    /* Get the value for `key` into `value`. Returns false if the key is not in the map */                            \
+    static inline bool get_##K##_##V##_HashMap(K##_##V##_HashMap *map, K key, V *value)                               \
+    {                                                                                                                 \
+        K##_##V##_HashMapEntry *entry = find_##K##_##V##_HashMap(map, key);                                           \
+        if (entry)                                                                                                    \
+            *value = entry->value;                                                                                    \
+        return entry != NULL;                                                                                         \
+    }                                                                                                                 \
+                                                                                                                      \
+    /* Set the value for `key`, adding it if it is not in the map */                                                  \
+    static inline void put_##K##_##V##_HashMap(K##_##V##_HashMap *map, K key, V value)                                \
+    {                                                                                                                 \
+        K##_##V##_HashMapEntry *entry = find_##K##_##V##_HashMap(map, key);                                           \
+        if (entry)                                                                                                    \
+        {                                                                                                             \
+            entry->value = value;                                                                                     \
+            return;                                                                                                   \
+        }                                                                                                             \
+        reserve_##K##_##V##_HashMap(map, map->len + 1);                                                               \
+        K##_##V##_HashMap_insert(map, (K##_##V##_HashMapEntry){key, value, K##_##V##_HashMap_hash(key)});             \
+    }                                                                                                                 \
+                                                                                                                      \
+    /* Remove every entry, but keep the memory to fill again */                                                       \
+    static inline void clear_##K##_##V##_HashMap(K##_##V##_HashMap *map)                                              \
+    {                                                                                                                 \
+        if (map->len)                                                                                                 \
+            memset(map->entries, 0, sizeof(map->entries[0]) * map->cap);                                              \
+        map->len = 0UL;                                                                                               \
+    }                                                                                                                 \
+                                                                                                                      \
+    static inline void delete_##K##_##V##_HashMap(K##_##V##_HashMap *map)                                             \
+    {                                                                                                                 \
+        free(map->entries);                                                                                           \
+        *map = new_##K##_##V##_HashMap();                                                                             \
+    }
+
+#endif
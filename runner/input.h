@@ -0,0 +1,401 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// Reading puzzle input without stdio
+// The input file is mapped into memory (or stdin is read into one buffer when piped), and parsing works on spans of that memory.
+// Lines, records, and grids all point into the input, so nothing is copied or allocated per line.
+// The input is mapped privately, so solvers may write to it (e.g. marking a map) without changing the file.
+// Numbers are converted 8 digits at a time within a 64 bit word (SWAR), and next_numbers and count_lines scan 16 bytes
+// at a time with SSE2 where it is available.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// The whole input, followed by a '\0' so it can also be used as a string
+typedef struct Input
+{
+    char *data;
+    size_t size;
+    // The length of the mapping, or 0 if `data` was allocated
+    size_t mapped_size;
+} Input;
+
+// A range [start, end) of an input. Only valid until the input is closed
+typedef struct Span
+{
+    char *start;
+    char *end;
+} Span;
+
+// A rectangular character grid in an input. Row `r` starts at `data + r * stride`, which skips the newline
+typedef struct GridView
+{
+    char *data;
+    size_t rows, cols, stride;
+} GridView;
+
+#define GRID_AT(grid, row, col) ((grid).data[(row) * (grid).stride + (col)])
+
+/// @brief Read all of a file descriptor that can't be mapped (a pipe or terminal) into one buffer
+/// @param fd The file descriptor to read until EOF
+/// @param input Out: The input, in a buffer from malloc
+/// @return 0 if success, non-zero if failure
+static inline int read_input_fd(int fd, Input *input)
+{
+    size_t cap = 1UL << 16;
+    input->data = malloc(cap);
+    input->size = 0UL;
+    input->mapped_size = 0UL;
+
+    ssize_t bytes_read;
+    while ((bytes_read = read(fd, input->data + input->size, cap - input->size - 1)) != 0)
+    {
+        if (bytes_read < 0)
+        {
+            perror("Error reading input");
+            free(input->data);
+            return 1;
+        }
+        input->size += bytes_read;
+        // Always leave room for the null terminator
+        if (input->size + 1 >= cap)
+        {
+            cap *= 2;
+            input->data = realloc(input->data, cap);
+        }
+    }
+    input->data[input->size] = '\0';
+    return 0;
+}
+
+/// @brief Map an input file into memory, or read stdin if there is no file
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param input Out: The input. Close with close_input
+/// @return 0 if success, non-zero if failure
+static inline int open_input(char *input_file, Input *input)
+{
+    int fd = input_file ? open(input_file, O_RDONLY) : STDIN_FILENO;
+    if (fd < 0)
+    {
+        perror("Error opening input file");
+        return 1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) || !S_ISREG(st.st_mode))
+    {
+        int result = read_input_fd(fd, input);
+        if (input_file)
+            close(fd);
+        return result;
+    }
+
+    // Reserve zeroed memory with room for at least one byte past the file, then map the file over the start of it.
+    // Then the input is always null terminated, even if the file fills its last page
+    long page_size = sysconf(_SC_PAGESIZE);
+    input->size = st.st_size;
+    input->mapped_size = (input->size / page_size + 1) * page_size;
+    input->data = mmap(NULL, input->mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (input->data == MAP_FAILED ||
+        (input->size && mmap(input->data, input->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED | MAP_POPULATE, fd, 0) == MAP_FAILED))
+    {
+        perror("Error mapping input file");
+        if (input->data != MAP_FAILED)
+            munmap(input->data, input->mapped_size);
+        if (input_file)
+            close(fd);
+        return 1;
+    }
+
+    // The mapping stays valid after closing
+    if (input_file)
+        close(fd);
+    return 0;
+}
+
+static inline void close_input(Input *input)
+{
+    if (input->mapped_size)
+        munmap(input->data, input->mapped_size);
+    else
+        free(input->data);
+    input->data = NULL;
+    input->size = 0UL;
+    input->mapped_size = 0UL;
+}
+
+static inline Span input_span(Input *input)
+{
+    return (Span){input->data, input->data + input->size};
+}
+
+/// @brief Get the next line, and move `span` past it
+/// @param span The remaining input
+/// @param line Out: The line, without the newline
+/// @return false if there are no lines left
+static inline bool next_line(Span *span, Span *line)
+{
+    if (span->start >= span->end)
+        return false;
+
+    char *newline = memchr(span->start, '\n', span->end - span->start);
+    *line = (Span){span->start, newline ? newline : span->end};
+    span->start = newline ? newline + 1 : span->end;
+    return true;
+}
+
+/// @brief Get the next group of lines separated by blank lines, and move `span` past it
+/// @param span The remaining input
+/// @param record Out: The lines of the record, without the newline after the last line
+/// @return false if there are no records left
+static inline bool next_record(Span *span, Span *record)
+{
+    // Skip any blank lines before the record
+    while (span->start < span->end && *span->start == '\n')
+        span->start++;
+    if (span->start >= span->end)
+        return false;
+
+    record->start = record->end = span->start;
+    Span line;
+    while (next_line(span, &line) && line.start != line.end)
+        record->end = line.end;
+    return true;
+}
+
+/// @brief Get a grid of equal length lines, ending at a blank line or the end of the input, and move `span` past it
+/// @param span The remaining input
+/// @param grid Out: The grid
+/// @return false if there is no grid, or if the lines are not all the same length
+static inline bool next_grid(Span *span, GridView *grid)
+{
+    Span record;
+    if (!next_record(span, &record))
+        return false;
+
+    char *newline = memchr(record.start, '\n', record.end - record.start);
+    grid->data = record.start;
+    grid->cols = (newline ? newline : record.end) - record.start;
+    grid->stride = grid->cols + 1;
+    // The last line has no newline in the record, so round up
+    grid->rows = (record.end - record.start + 1) / grid->stride;
+    return grid->rows * grid->stride == (size_t)(record.end - record.start + 1);
+}
+
+/// @brief Null terminate each row of a grid in place, replacing the newlines
+/// @param grid The grid
+/// @return An array of `grid.rows` pointers to the rows, from malloc. The rows themselves are still in the input
+static inline char **grid_rows(GridView grid)
+{
+    char **rows = malloc(sizeof(rows[0]) * (grid.rows ? grid.rows : 1));
+    for (size_t row = 0; row < grid.rows; row++)
+    {
+        rows[row] = &GRID_AT(grid, row, 0);
+        rows[row][grid.cols] = '\0';
+    }
+    return rows;
+}
+
+// 8 copies of a byte in a word
+#define SWAR_BYTES(byte) (0x0101010101010101ULL * (uint8_t)(byte))
+
+/// @brief Load up to 8 bytes, without reading past `end`
+/// @param ch The first byte
+/// @param end The end of the input
+/// @return The bytes, with the byte at `ch` lowest, and zeros past `end`
+static inline uint64_t load_word(const char *ch, const char *end)
+{
+    uint64_t word = 0ULL;
+    if (end - ch >= 8)
+        memcpy(&word, ch, 8);
+    else
+        memcpy(&word, ch, end - ch);
+    return word;
+}
+
+/// @brief Count the digits at the start of a word
+/// @param digits A word from load_word, with '0' subtracted from every byte (by XOR)
+/// @return The number of bytes before the first byte that isn't 0-9, up to 8
+static inline int count_digits(uint64_t digits)
+{
+    // A byte is over 9 if adding 0x76 sets its high bit, or it was already set. Masking first keeps carries in the byte
+    uint64_t not_digits = (((digits & SWAR_BYTES(0x7f)) + SWAR_BYTES(0x76)) | digits) & SWAR_BYTES(0x80);
+    return not_digits ? __builtin_ctzll(not_digits) / 8 : 8;
+}
+
+/// @brief Convert the first `count` digits of a word to a number, all at once
+/// @param digits A word from load_word, with '0' subtracted from every byte (by XOR)
+/// @param count The number of digits, 1 to 8
+/// @return The number
+static inline uint64_t convert_digits(uint64_t digits, int count)
+{
+    // Move the digits to the top of the word, so the zeros shifted in are leading zeros
+    digits <<= 8 * (8 - count);
+    // Combine pairs of digits, then pairs of those, then pairs of those
+    digits = ((digits & SWAR_BYTES(0x0f)) * (1 + (10 << 8))) >> 8;
+    digits = ((digits & 0x00ff00ff00ff00ffULL) * (1 + (100 << 16))) >> 16;
+    return ((digits & 0x0000ffff0000ffffULL) * (1 + (10000ULL << 32))) >> 32;
+}
+
+/// @brief Parse a run of digits, 8 at a time until a word isn't all digits
+/// @param ch The first digit. Moved past the last digit
+/// @param end The end of the input
+/// @return The number
+static inline uint64_t parse_digits(char **ch, const char *end)
+{
+    static const uint64_t POWERS_OF_10[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL};
+
+    uint64_t result = 0ULL;
+    int count;
+    do
+    {
+        uint64_t digits = load_word(*ch, end) ^ SWAR_BYTES('0');
+        count = count_digits(digits);
+        if (count)
+            result = result * POWERS_OF_10[count] + convert_digits(digits, count);
+        *ch += count;
+    } while (count == 8);
+    return result;
+}
+
+/// @brief Parse the number at the start of `span`, if there is one
+/// @param span The remaining input. Moved past the number if there is one
+/// @param value Out: The number
+/// @return false if `span` does not start with a number
+static inline bool parse_number(Span *span, long long *value)
+{
+    char *ch = span->start;
+    bool negative = ch < span->end && *ch == '-';
+    if (negative)
+        ch++;
+    if (ch >= span->end || *ch < '0' || *ch > '9')
+        return false;
+
+    uint64_t result = parse_digits(&ch, span->end);
+    *value = negative ? -(long long)result : (long long)result;
+    span->start = ch;
+    return true;
+}
+
+/// @brief Find and parse the next number in `span`, skipping anything that isn't part of a number
+/// @param span The remaining input. Moved past the number
+/// @param value Out: The number
+/// @return false if there are no numbers left
+static inline bool next_number(Span *span, long long *value)
+{
+    while (span->start < span->end)
+    {
+        if (parse_number(span, value))
+            return true;
+        span->start++;
+    }
+    return false;
+}
+
+/// @brief Find which of 64 bytes are digits
+/// @param ch The first byte
+/// @param end The end of the input. Bytes past it are not digits
+/// @return A mask with bit `i` set if `ch[i]` is a digit
+static inline uint64_t digit_mask(const char *ch, const char *end)
+{
+    char padded[64];
+    if (end - ch < 64)
+    {
+        memset(padded, 0, sizeof(padded));
+        memcpy(padded, ch, end - ch);
+        ch = padded;
+    }
+
+    uint64_t mask = 0ULL;
+#ifdef __SSE2__
+    // A byte is a digit if it's under 10 after subtracting '0'. SSE2 only compares signed bytes, so shift the range too
+    const __m128i shift = _mm_set1_epi8((char)(0x80 - '0'));
+    const __m128i limit = _mm_set1_epi8((char)(0x80 + 10));
+    for (int i = 0; i < 4; i++)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(ch + 16 * i));
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmplt_epi8(_mm_add_epi8(bytes, shift), limit)) << (16 * i);
+    }
+#else
+    for (int i = 0; i < 64; i++)
+        mask |= (uint64_t)((unsigned char)(ch[i] - '0') < 10) << i;
+#endif
+    return mask;
+}
+
+/// @brief Find and parse the next numbers in `span`, skipping anything that isn't part of a number, like calling
+/// next_number until `values` is full. Where the numbers start is found 64 bytes at a time, so finding each number
+/// doesn't have to wait for the one before it to be parsed
+/// @param span The remaining input, which doesn't start in the middle of a number. Moved past the last number parsed
+/// @param values Out: The numbers
+/// @param values_size The most numbers to parse
+/// @return The number of numbers parsed. Less than `values_size` only if there are no numbers left
+static inline size_t next_numbers(Span *span, long long *values, size_t values_size)
+{
+    size_t count = 0UL;
+    // Whether the last byte of the previous block was a digit, so the number continues in this block
+    uint64_t carry = 0ULL;
+    char *ch = span->start;
+    for (char *block = span->start; block < span->end && count < values_size; block += 64)
+    {
+        uint64_t digits = digit_mask(block, span->end);
+        uint64_t starts = digits & ~((digits << 1) | carry);
+        carry = digits >> 63;
+        for (; starts && count < values_size; starts &= starts - 1)
+        {
+            ch = block + __builtin_ctzll(starts);
+            bool negative = ch > span->start && ch[-1] == '-';
+            uint64_t result = parse_digits(&ch, span->end);
+            values[count++] = negative ? -(long long)result : (long long)result;
+        }
+    }
+    span->start = count < values_size ? span->end : ch;
+    return count;
+}
+
+/// @brief Count the lines in `span`, for sizing arrays before parsing into them
+/// @param span The text
+/// @return The number of newlines, plus one if the last line has no newline
+static inline size_t count_lines(Span span)
+{
+    size_t lines = 0UL;
+    char *ch = span.start;
+#ifdef __SSE2__
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; span.end - ch >= 16; ch += 16)
+        lines += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)ch), newline)));
+#endif
+    for (; ch < span.end; ch++)
+        lines += *ch == '\n';
+    return lines + (span.end > span.start && span.end[-1] != '\n');
+}
+
+/// @brief Skip `prefix` if `span` starts with it
+/// @param span The remaining input
+/// @param prefix The expected text
+/// @return true if `span` started with `prefix`
+static inline bool skip_prefix(Span *span, const char *prefix)
+{
+    size_t prefix_size = strlen(prefix);
+    if ((size_t)(span->end - span->start) < prefix_size || memcmp(span->start, prefix, prefix_size))
+        return false;
+    span->start += prefix_size;
+    return true;
+}
+
+static inline size_t span_size(Span span)
+{
+    return span.end - span.start;
+}
+
+#endif
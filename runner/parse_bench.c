@@ -0,0 +1,213 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "input.h"
+#include "timer.h"
+
+// Compare ways of parsing the numbers in the puzzle inputs: fscanf, one byte at a time, and input.h's SWAR and SSE2
+// Each run parses the whole input from memory and sums its numbers, so every way must get the same checksum
+
+// Sums the numbers of an input, returning the number of numbers found
+typedef long long (*ParseFn)(Input *input, long long *checksum);
+
+typedef struct Format
+{
+    int day;
+    // What a line of the input looks like
+    char *name;
+    ParseFn fscanf_parse;
+} Format;
+
+void print_usage(char *program_name);
+bool scalar_parse_number(Span *span, long long *value);
+long long parse_bytes(Input *input, long long *checksum);
+long long parse_next_number(Input *input, long long *checksum);
+long long parse_next_numbers(Input *input, long long *checksum);
+
+// How parse_number and next_number in input.h worked before they used SWAR and SSE2, for comparison
+bool scalar_parse_number(Span *span, long long *value)
+{
+    char *ch = span->start;
+    bool negative = ch < span->end && *ch == '-';
+    if (negative)
+        ch++;
+    if (ch >= span->end || *ch < '0' || *ch > '9')
+        return false;
+
+    long long result = 0LL;
+    while (ch < span->end && *ch >= '0' && *ch <= '9')
+        result = result * 10 + (*ch++ - '0');
+
+    *value = negative ? -result : result;
+    span->start = ch;
+    return true;
+}
+
+// Every format: find each number one byte at a time
+long long parse_bytes(Input *input, long long *checksum)
+{
+    Span span = input_span(input);
+    long long count = 0LL, value;
+    *checksum = 0LL;
+    while (span.start < span.end)
+    {
+        if (scalar_parse_number(&span, &value))
+        {
+            *checksum += value;
+            count++;
+        }
+        else
+            span.start++;
+    }
+    return count;
+}
+
+// Define fscanf_N, which reads `record` (with `n` numbers) with fscanf until it stops matching
+#define DEF_FSCANF_PARSE(N, record, n, ...)                 \
+    long long fscanf_##N(Input *input, long long *checksum) \
+    {                                                       \
+        FILE *f = fmemopen(input->data, input->size, "r");  \
+        long long count = 0LL, v[6];                        \
+        *checksum = 0LL;                                    \
+        while (fscanf(f, record, __VA_ARGS__) == n)         \
+        {                                                   \
+            for (int i = 0; i < n; i++)                     \
+                *checksum += v[i];                          \
+            count += n;                                     \
+        }                                                   \
+        fclose(f);                                          \
+        return count;                                       \
+    }
+
+DEF_FSCANF_PARSE(pairs, "%lld %lld", 2, &v[0], &v[1])
+DEF_FSCANF_PARSE(robots, " p=%lld,%lld v=%lld,%lld", 4, &v[0], &v[1], &v[2], &v[3])
+DEF_FSCANF_PARSE(machines, " Button A: X+%lld, Y+%lld Button B: X+%lld, Y+%lld Prize: X=%lld, Y=%lld", 6,
+                 &v[0], &v[1], &v[2], &v[3], &v[4], &v[5])
+DEF_FSCANF_PARSE(numbers, "%lld", 1, &v[0])
+
+// Day 7: "target: a b c", with any number of operands
+long long fscanf_equations(Input *input, long long *checksum)
+{
+    FILE *f = fmemopen(input->data, input->size, "r");
+    long long count = 0LL, value;
+    *checksum = 0LL;
+    while (fscanf(f, "%lld:", &value) == 1)
+    {
+        do
+        {
+            *checksum += value;
+            count++;
+        } while (fgetc(f) == ' ' && fscanf(f, "%lld", &value) == 1);
+    }
+    fclose(f);
+    return count;
+}
+
+// Every format: input.h, one number at a time
+long long parse_next_number(Input *input, long long *checksum)
+{
+    Span span = input_span(input);
+    long long count = 0LL, value;
+    *checksum = 0LL;
+    while (next_number(&span, &value))
+    {
+        *checksum += value;
+        count++;
+    }
+    return count;
+}
+
+// Every format: input.h, many numbers at a time
+long long parse_next_numbers(Input *input, long long *checksum)
+{
+    Span span = input_span(input);
+    long long count = 0LL, values[256];
+    size_t values_size;
+    *checksum = 0LL;
+    while ((values_size = next_numbers(&span, values, 256)))
+    {
+        for (size_t i = 0; i < values_size; i++)
+            *checksum += values[i];
+        count += values_size;
+    }
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    // The directory containing day_XX/input.txt
+    char *input_dir = ".";
+    // The number of runs of each way. The fastest is reported
+    int repetitions = 100;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "i:r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'i':
+            input_dir = optarg;
+            break;
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (repetitions < 1)
+    {
+        fprintf(stderr, "The number of repetitions must be at least 1\n");
+        return 1;
+    }
+
+    Format formats[] = {
+        {1, "a   b", fscanf_pairs},
+        {7, "target: a b c", fscanf_equations},
+        {13, "Button A: X+a, Y+b", fscanf_machines},
+        {14, "p=x,y v=dx,dy", fscanf_robots},
+        {22, "n", fscanf_numbers},
+    };
+    char *parser_names[] = {"fscanf", "bytes", "next_number", "next_numbers"};
+
+    printf("%-4s %-20s %-12s %10s %10s %10s %20s\n", "Day", "Format", "Parser", "Bytes", "ns/number", "GB/s", "Checksum");
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+    {
+        char input_file[PATH_MAX];
+        snprintf(input_file, sizeof(input_file), "%s/day_%02d/input.txt", input_dir, formats[i].day);
+        if (access(input_file, R_OK))
+            continue;
+        Input input;
+        if (open_input(input_file, &input))
+            return 1;
+
+        ParseFn parsers[] = {formats[i].fscanf_parse, parse_bytes, parse_next_number, parse_next_numbers};
+        for (size_t p = 0; p < sizeof(parsers) / sizeof(parsers[0]); p++)
+        {
+            long long min_ns = -1LL;
+            long long checksum, count = 0LL;
+            for (int r = 0; r < repetitions; r++)
+            {
+                long long start = now_ns();
+                count = parsers[p](&input, &checksum);
+                long long ns = now_ns() - start;
+                if (min_ns < 0 || ns < min_ns)
+                    min_ns = ns;
+            }
+            printf("%-4d %-20s %-12s %10zu %10.2f %10.3f %20lld\n", formats[i].day, formats[i].name, parser_names[p], input.size,
+                   count ? (double)min_ns / count : 0.0, (double)input.size / (min_ns ? min_ns : 1), checksum);
+        }
+        close_input(&input);
+    }
+    return 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr, "Usage: %s [-i INPUT_DIR] [-r REPETITIONS]\n", program_name);
+}
@@ -0,0 +1,110 @@
+#include <string.h>
+#include <unistd.h>
+
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+const char *perf_event_names[PERF_EVENTS] = {"Cycles", "Instructions", "L1D misses", "LLC misses", "Branch misses"};
+
+#ifdef __linux__
+// The perf_event_attr type and config of each PerfEvent
+static const struct
+{
+    unsigned type;
+    unsigned long long config;
+} perf_event_configs[PERF_EVENTS] = {
+    [PERF_CYCLES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    [PERF_INSTRUCTIONS] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    [PERF_L1D_MISSES] = {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    [PERF_LLC_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    [PERF_BRANCH_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+#endif
+
+/// @brief Open every event for this thread and every thread it starts afterwards, disabled. Call it before starting the
+/// thread pool, so the workers and stream readers are counted with the thread that runs the solver
+/// @param counters Out: The counters. Close with close_perf_counters
+/// @return The number of events that are available
+int open_perf_counters(PerfCounters *counters)
+{
+    int available = 0;
+    for (int i = 0; i < PERF_EVENTS; i++)
+    {
+        counters->fd[i] = -1;
+#ifdef __linux__
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = perf_event_configs[i].type;
+        attr.config = perf_event_configs[i].config;
+        attr.disabled = 1;
+        // Only count the solver, which also works with the default perf_event_paranoid of 2
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Threads started later get their own copy of each event, which is enabled, reset, and read through this one
+        attr.inherit = 1;
+        // If there are more events than hardware counters, the kernel takes turns, so the count has to be scaled
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        counters->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+        available += counters->fd[i] != -1;
+    }
+    return available;
+}
+
+// Reset and enable every available event
+void start_perf_counters(PerfCounters *counters)
+{
+#ifdef __linux__
+    for (int i = 0; i < PERF_EVENTS; i++)
+    {
+        if (counters->fd[i] == -1)
+            continue;
+        ioctl(counters->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counters->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/// @brief Disable every available event and read the counts since start_perf_counters
+/// @param counters The counters
+/// @return The counts, with -1 for unavailable events
+PerfSample stop_perf_counters(PerfCounters *counters)
+{
+    PerfSample sample;
+    for (int i = 0; i < PERF_EVENTS; i++)
+        sample.count[i] = -1LL;
+#ifdef __linux__
+    for (int i = 0; i < PERF_EVENTS; i++)
+        if (counters->fd[i] != -1)
+            ioctl(counters->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    for (int i = 0; i < PERF_EVENTS; i++)
+    {
+        // The count, the time enabled, and the time actually counting
+        unsigned long long values[3];
+        if (counters->fd[i] == -1 || read(counters->fd[i], values, sizeof(values)) != sizeof(values))
+            continue;
+        if (values[2] && values[2] < values[1])
+            sample.count[i] = (long long)((double)values[0] * values[1] / values[2]);
+        else if (values[2] || !values[1])
+            sample.count[i] = (long long)values[0];
+        // Otherwise the event was enabled but never got a hardware counter, so nothing is known
+    }
+#endif
+    return sample;
+}
+
+void close_perf_counters(PerfCounters *counters)
+{
+    for (int i = 0; i < PERF_EVENTS; i++)
+    {
+        if (counters->fd[i] != -1)
+            close(counters->fd[i]);
+        counters->fd[i] = -1;
+    }
+}
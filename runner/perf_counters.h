@@ -0,0 +1,41 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdbool.h>
+
+// Hardware event counts for a phase of a solver, from Linux perf_event_open
+// Each event is opened on its own, so an event the CPU or kernel doesn't support (common in containers and VMs)
+// only leaves that event unavailable. Without any events, or on other systems, every count is unavailable.
+// Events are inherited, so the counts cover every thread started after they were opened, summed together.
+
+typedef enum PerfEvent
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    // Dummy variant to hold the number of events
+    PERF_EVENTS,
+} PerfEvent;
+
+typedef struct PerfCounters
+{
+    // The file descriptor of each event, or -1 if it is unavailable
+    int fd[PERF_EVENTS];
+} PerfCounters;
+
+typedef struct PerfSample
+{
+    // The count of each event, or -1 if it is unavailable
+    long long count[PERF_EVENTS];
+} PerfSample;
+
+extern const char *perf_event_names[PERF_EVENTS];
+
+int open_perf_counters(PerfCounters *counters);
+void start_perf_counters(PerfCounters *counters);
+PerfSample stop_perf_counters(PerfCounters *counters);
+void close_perf_counters(PerfCounters *counters);
+
+#endif
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "priority_queue.h"
+#include "generator.h"
+#include "timer.h"
+
+// Compare the queues from priority_queue.h on searches like the ones in the puzzles
+// Each run pops `pops` elements, and each pop pushes 1 or 2 new elements with a larger key, like a move in a maze
+
+typedef struct Item
+{
+    int key;
+    int payload;
+} Item;
+
+DEF_PQ(Item, key)
+
+typedef struct Workload
+{
+    char *name;
+    // The change in key from an element to the elements it pushes, chosen randomly
+    const int *steps;
+    int steps_size;
+    int max_step;
+} Workload;
+
+// The random choices made by every run, made ahead of time so every queue does the same work
+typedef struct Choices
+{
+    // The number of elements pushed after each pop
+    char *children;
+    // The index into the workload's steps for each pushed element, 2 for each pop
+    char *steps;
+} Choices;
+
+void print_usage(char *program_name);
+Choices make_choices(Workload workload, long long pops);
+
+// Define run_Q, which times `pops` pops of an Item_Q made with `new_queue` and returns the time in nanoseconds
+// The sum of popped keys is returned in `checksum`, which is the same for every queue because they all pop in key order
+#define DEF_RUN(Q, new_queue)                                                                       \
+    long long run_##Q(Workload workload, Choices choices, long long pops, long long *checksum)      \
+    {                                                                                               \
+        Item_##Q pq = new_queue;                                                                    \
+        long long start = now_ns();                                                                 \
+        push_Item_##Q(&pq, (Item){.key = 0, .payload = 0});                                         \
+        Item top;                                                                                   \
+        long long popped = 0;                                                                       \
+        *checksum = 0LL;                                                                            \
+        while (popped < pops && pop_Item_##Q(&pq, &top))                                            \
+        {                                                                                           \
+            *checksum += top.key;                                                                   \
+            for (int i = 0; i < choices.children[popped]; i++)                                      \
+            {                                                                                       \
+                int step = workload.steps[(int)choices.steps[(2 * popped) + i]];                    \
+                push_Item_##Q(&pq, (Item){.key = top.key + step, .payload = top.payload + 1});      \
+            }                                                                                       \
+            popped++;                                                                               \
+        }                                                                                           \
+        long long elapsed = now_ns() - start;                                                       \
+        delete_Item_##Q(&pq);                                                                       \
+        return elapsed;                                                                             \
+    }
+
+DEF_RUN(PQ, new_Item_PQ())
+DEF_RUN(BucketPQ, new_Item_BucketPQ(workload.max_step))
+DEF_RUN(RadixPQ, new_Item_RadixPQ())
+
+typedef struct Queue
+{
+    char *name;
+    long long (*run)(Workload workload, Choices choices, long long pops, long long *checksum);
+} Queue;
+
+int main(int argc, char *argv[])
+{
+    // The number of elements popped in each run
+    long long pops = 1000000LL;
+    // The number of runs of each queue. The fastest is reported
+    int repetitions = 5;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            pops = atoll(optarg);
+            break;
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (pops < 1 || repetitions < 1)
+    {
+        fprintf(stderr, "The number of pops and repetitions must be at least 1\n");
+        return 1;
+    }
+
+    // Days 18 and 20 count steps, and day 16 scores 1 for a step and 1000 for a turn
+    static const int UNIT_STEPS[] = {1};
+    static const int MAZE_STEPS[] = {1, 1000};
+    Workload workloads[] = {
+        {"unit (days 18, 20)", UNIT_STEPS, 1, 1},
+        {"1/1000 (day 16)", MAZE_STEPS, 2, 1000},
+    };
+    Queue queues[] = {
+        {"4-ary heap", run_PQ},
+        {"bucket queue", run_BucketPQ},
+        {"radix heap", run_RadixPQ},
+    };
+
+    printf("%-20s %-14s %10s %20s\n", "Workload", "Queue", "ns/pop", "Checksum");
+    for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++)
+    {
+        Choices choices = make_choices(workloads[w], pops);
+        for (size_t q = 0; q < sizeof(queues) / sizeof(queues[0]); q++)
+        {
+            long long min_ns = -1LL;
+            long long checksum;
+            for (int i = 0; i < repetitions; i++)
+            {
+                long long ns = queues[q].run(workloads[w], choices, pops, &checksum);
+                if (min_ns < 0 || ns < min_ns)
+                    min_ns = ns;
+            }
+            printf("%-20s %-14s %10.1f %20lld\n", workloads[w].name, queues[q].name, (double)min_ns / pops, checksum);
+        }
+        free(choices.children);
+        free(choices.steps);
+    }
+    return 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr, "Usage: %s [-n POPS] [-r REPETITIONS]\n", program_name);
+}
+
+/// @brief Make the random choices for every pop of a run
+/// @param workload The workload, which determines the possible steps
+/// @param pops The number of pops in a run
+/// @return The choices. Free both arrays after use
+Choices make_choices(Workload workload, long long pops)
+{
+    seed_random(DEFAULT_SEED);
+    Choices choices = {.children = malloc(pops), .steps = malloc(2 * pops)};
+    for (long long i = 0; i < pops; i++)
+    {
+        choices.children[i] = random_range(1, 2);
+        choices.steps[2 * i] = random_range(0, workload.steps_size - 1);
+        choices.steps[(2 * i) + 1] = random_range(0, workload.steps_size - 1);
+    }
+    return choices;
+}
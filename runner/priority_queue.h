@@ -0,0 +1,211 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+// Min priority queues of any type, ordered by an integer member
+// DEF_PQ(T, key) defines three queues of T, which all pop the element with the smallest `key` first:
+// - T##_PQ: A 4-ary heap. Works for any keys
+// - T##_BucketPQ: A monotone bucket queue. Every pushed key must be between the last popped key and that plus `max_step`
+// - T##_RadixPQ: A radix heap. Every pushed key must be non-negative and at least the last popped key
+// Searches where every move costs at least 0 (Dijkstra's algorithm, BFS) only ever push keys at least the last popped key,
+// so they can use any of them. Elements with equal keys are popped in no particular order.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+// The number of children of each heap node. More children make the heap shallower, and 4 children are usually in one cache line
+// The smallest child is found with a comparison of each pair, so this must stay 4
+#define PQ_ARITY 4
+// The number of buckets in a radix heap: one for keys equal to the last popped key, and one for each bit that can differ
+#define PQ_RADIX_BUCKETS 33
+
+#define DEF_PQ(T, key)                                                                                             \
+    /* A stack of elements, used for each bucket */                                                                \
+    typedef struct T##_PQBucket                                                                                    \
+    {                                                                                                              \
+        T *arr;                                                                                                    \
+        size_t len;                                                                                                \
+        size_t cap;                                                                                                \
+    } T##_PQBucket;                                                                                                \
+                                                                                                                   \
+    static inline void push_##T##_PQBucket(T##_PQBucket *bucket, T val)                                            \
+    {                                                                                                              \
+        if (bucket->len + 1 > bucket->cap)                                                                         \
+        {                                                                                                          \
+            bucket->cap = bucket->cap ? bucket->cap * 2 : 4;                                                       \
+            bucket->arr = realloc(bucket->arr, sizeof(T) * bucket->cap);                                           \
+        }                                                                                                          \
+        bucket->arr[bucket->len++] = val;                                                                          \
+    }                                                                                                              \
+                                                                                                                   \
+    typedef struct T##_PQ                                                                                          \
+    {                                                                                                              \
+        T *arr;                                                                                                    \
+        size_t len;                                                                                                \
+        size_t cap;                                                                                                \
+    } T##_PQ;                                                                                                      \
+                                                                                                                   \
+    static inline T##_PQ new_##T##_PQ() { return (T##_PQ){NULL, 0UL, 0UL}; }                                       \
+                                                                                                                   \
+    static inline void push_##T##_PQ(T##_PQ *pq, T val)                                                            \
+    {                                                                                                              \
+        if (pq->len + 1 > pq->cap)                                                                                 \
+        {                                                                                                          \
+            pq->cap = pq->cap ? pq->cap * 2 : 16;                                                                  \
+            pq->arr = realloc(pq->arr, sizeof(T) * pq->cap);                                                       \
+        }                                                                                                          \
+        /* Move parents down into the hole until `val` is not less than its parent */                              \
+        size_t hole = pq->len++;                                                                                   \
+        while (hole)                                                                                               \
+        {                                                                                                          \
+            size_t parent = (hole - 1) / PQ_ARITY;                                                                 \
+            if (pq->arr[parent].key <= val.key)                                                                    \
+                break;                                                                                             \
+            pq->arr[hole] = pq->arr[parent];                                                                       \
+            hole = parent;                                                                                         \
+        }                                                                                                          \
+        pq->arr[hole] = val;                                                                                       \
+    }                                                                                                              \
+                                                                                                                   \
+    /* Remove the smallest element into `top`. Returns false if the queue is empty */                              \
+    static inline bool pop_##T##_PQ(T##_PQ *pq, T *top)                                                            \
+    {                                                                                                              \
+        if (!pq->len)                                                                                              \
+            return false;                                                                                          \
+        *top = pq->arr[0];                                                                                         \
+        T last = pq->arr[--pq->len];                                                                               \
+        /* Move the smallest child up into the hole until `last` is not more than any child */                     \
+        size_t hole = 0UL;                                                                                         \
+        for (;;)                                                                                                   \
+        {                                                                                                          \
+            size_t first_child = (hole * PQ_ARITY) + 1;                                                            \
+            if (first_child >= pq->len)                                                                            \
+                break;                                                                                             \
+            size_t min_child = first_child;                                                                        \
+            if (first_child + 4 <= pq->len)                                                                        \
+            {                                                                                                      \
+                /* Compare in pairs, which compiles to conditional moves instead of unpredictable branches */      \
+                size_t min_low = first_child + (pq->arr[first_child + 1].key < pq->arr[first_child].key);          \
+                size_t min_high = first_child + 2 + (pq->arr[first_child + 3].key < pq->arr[first_child + 2].key); \
+                min_child = pq->arr[min_high].key < pq->arr[min_low].key ? min_high : min_low;                     \
+            }                                                                                                      \
+            else                                                                                                   \
+                for (size_t child = first_child + 1; child < pq->len; child++)                                     \
+                    if (pq->arr[child].key < pq->arr[min_child].key)                                               \
+                        min_child = child;                                                                         \
+            if (last.key <= pq->arr[min_child].key)                                                                \
+                break;                                                                                             \
+            pq->arr[hole] = pq->arr[min_child];                                                                    \
+            hole = min_child;                                                                                      \
+        }                                                                                                          \
+        pq->arr[hole] = last;                                                                                      \
+        return true;                                                                                               \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline void delete_##T##_PQ(T##_PQ *pq)                                                                 \
+    {                                                                                                              \
+        free(pq->arr);                                                                                             \
+        *pq = new_##T##_PQ();                                                                                      \
+    }                                                                                                              \
+                                                                                                                   \
+    typedef struct T##_BucketPQ                                                                                    \
+    {                                                                                                              \
+        /* Bucket i holds the elements whose key is i modulo `bucket_count` */                                     \
+        T##_PQBucket *buckets;                                                                                     \
+        size_t bucket_count;                                                                                       \
+        /* No element in the queue has a smaller key */                                                            \
+        long long min_key;                                                                                         \
+        size_t len;                                                                                                \
+    } T##_BucketPQ;                                                                                                \
+                                                                                                                   \
+    /* `max_step` is the most a pushed key can be more than the last popped key */                                 \
+    static inline T##_BucketPQ new_##T##_BucketPQ(int max_step)                                                    \
+    {                                                                                                              \
+        T##_BucketPQ pq = {.bucket_count = max_step + 1, .min_key = 0LL, .len = 0UL};                              \
+        pq.buckets = calloc(pq.bucket_count, sizeof(pq.buckets[0]));                                               \
+        return pq;                                                                                                 \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline void push_##T##_BucketPQ(T##_BucketPQ *pq, T val)                                                \
+    {                                                                                                              \
+        push_##T##_PQBucket(&pq->buckets[(size_t)val.key % pq->bucket_count], val);                                \
+        pq->len++;                                                                                                 \
+    }                                                                                                              \
+                                                                                                                   \
+    /* Remove the smallest element into `top`. Returns false if the queue is empty */                              \
+    static inline bool pop_##T##_BucketPQ(T##_BucketPQ *pq, T *top)                                                \
+    {                                                                                                              \
+        if (!pq->len)                                                                                              \
+            return false;                                                                                          \
+        T##_PQBucket *bucket;                                                                                      \
+        while (!(bucket = &pq->buckets[(size_t)pq->min_key % pq->bucket_count])->len)                              \
+            pq->min_key++;                                                                                         \
+        *top = bucket->arr[--bucket->len];                                                                         \
+        pq->len--;                                                                                                 \
+        return true;                                                                                               \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline void delete_##T##_BucketPQ(T##_BucketPQ *pq)                                                     \
+    {                                                                                                              \
+        for (size_t i = 0; i < pq->bucket_count; i++)                                                              \
+            free(pq->buckets[i].arr);                                                                              \
+        free(pq->buckets);                                                                                         \
+        pq->buckets = NULL;                                                                                        \
+        pq->len = 0UL;                                                                                             \
+    }                                                                                                              \
+                                                                                                                   \
+    typedef struct T##_RadixPQ                                                                                     \
+    {                                                                                                              \
+        /* Bucket i > 0 holds the elements whose key first differs from `last_key` at bit i - 1 */                 \
+        T##_PQBucket buckets[PQ_RADIX_BUCKETS];                                                                    \
+        unsigned last_key;                                                                                         \
+        size_t len;                                                                                                \
+    } T##_RadixPQ;                                                                                                 \
+                                                                                                                   \
+    static inline T##_RadixPQ new_##T##_RadixPQ() { return (T##_RadixPQ){.last_key = 0U, .len = 0UL}; }            \
+                                                                                                                   \
+    static inline size_t T##_RadixPQ_bucket(T##_RadixPQ *pq, unsigned val_key)                                     \
+    {                                                                                                              \
+        return val_key == pq->last_key ? 0UL : 32UL - __builtin_clz(val_key ^ pq->last_key);                       \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline void push_##T##_RadixPQ(T##_RadixPQ *pq, T val)                                                  \
+    {                                                                                                              \
+        push_##T##_PQBucket(&pq->buckets[T##_RadixPQ_bucket(pq, val.key)], val);                                   \
+        pq->len++;                                                                                                 \
+    }                                                                                                              \
+                                                                                                                   \
+    /* Remove the smallest element into `top`. Returns false if the queue is empty */                              \
+    static inline bool pop_##T##_RadixPQ(T##_RadixPQ *pq, T *top)                                                  \
+    {                                                                                                              \
+        if (!pq->len)                                                                                              \
+            return false;                                                                                          \
+        if (!pq->buckets[0].len)                                                                                   \
+        {                                                                                                          \
+            /* Make the smallest key in the first non-empty bucket the last key. */                                \
+            /* Every element in that bucket then moves to a lower bucket, including at least one to bucket 0 */    \
+            size_t i = 1;                                                                                          \
+            while (!pq->buckets[i].len)                                                                            \
+                i++;                                                                                               \
+            T##_PQBucket bucket = pq->buckets[i];                                                                  \
+            pq->buckets[i].len = 0UL;                                                                              \
+            unsigned min_key = bucket.arr[0].key;                                                                  \
+            for (size_t j = 1; j < bucket.len; j++)                                                                \
+                if ((unsigned)bucket.arr[j].key < min_key)                                                         \
+                    min_key = bucket.arr[j].key;                                                                   \
+            pq->last_key = min_key;                                                                                \
+            for (size_t j = 0; j < bucket.len; j++)                                                                \
+                push_##T##_PQBucket(&pq->buckets[T##_RadixPQ_bucket(pq, bucket.arr[j].key)], bucket.arr[j]);       \
+        }                                                                                                          \
+        *top = pq->buckets[0].arr[--pq->buckets[0].len];                                                           \
+        pq->len--;                                                                                                 \
+        return true;                                                                                               \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline void delete_##T##_RadixPQ(T##_RadixPQ *pq)                                                       \
+    {                                                                                                              \
+        for (size_t i = 0; i < PQ_RADIX_BUCKETS; i++)                                                              \
+            free(pq->buckets[i].arr);                                                                              \
+        *pq = new_##T##_RadixPQ();                                                                                 \
+    }
+
+#endif
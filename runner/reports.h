@@ -0,0 +1,219 @@
+#ifndef REPORTS_H
+#define REPORTS_H
+
+// Checking day 2's reports for safety 16 at a time, as they are or with one level removed
+// A ReportBatch stores up to REPORT_BATCH reports level-major (structure of arrays): levels[j] holds level j of every
+// report, one report per 16 bit lane, so one vector subtraction gets the change between levels j and j + 1 of all of
+// them. A report is safe if every change is in MIN..MAX, or every change is in -MAX..-MIN. Both are kept as masks that
+// are ANDed over the changes, and lanes past the end of a shorter report are masked out by comparing j with its length,
+// so nothing branches on the levels. The vectors are GCC vector extensions, which become AVX2 with -march=native and
+// pairs of SSE2 instructions otherwise.
+// Reports longer than REPORT_MAX_LEVELS, or with levels too large for 16 bit changes, don't fit, and are checked one at
+// a time with safe_with_removals, which takes any number of levels and removals.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Reports checked at once, one per lane
+#define REPORT_BATCH 16
+// The longest report that fits in a batch. Real reports have 5 to 8 levels
+#define REPORT_MAX_LEVELS 8
+// The safe change between adjacent levels, in the direction of the report
+#define REPORT_MIN_CHANGE 1
+#define REPORT_MAX_CHANGE 3
+// Levels are limited to half the 16 bit range so their changes can't overflow
+#define REPORT_MAX_LEVEL (INT16_MAX / 2)
+// safe_with_removals keeps its counts on the stack for at most this many removals
+#define REPORT_STACK_REMOVALS 31
+
+typedef int16_t ReportLanes __attribute__((vector_size(REPORT_BATCH * sizeof(int16_t))));
+
+typedef struct ReportBatch
+{
+    // levels[j][r] is level j of report r. Levels past the end of a report are left over from earlier reports, and are
+    // masked out, so a batch only has to be zeroed when it is made
+    ReportLanes levels[REPORT_MAX_LEVELS];
+    // The number of levels in each report, 0 for lanes without one
+    ReportLanes lens;
+    // The number of reports in the batch
+    int size;
+} ReportBatch;
+
+/// @brief Empty a batch to reuse it
+/// @param batch The batch, which was zeroed when it was made
+static inline void clear_report_batch(ReportBatch *batch)
+{
+    batch->lens = (ReportLanes){0};
+    batch->size = 0;
+}
+
+/// @brief Add a report to a batch that isn't full
+/// @param batch The batch
+/// @param levels The levels of the report
+/// @param levels_size The number of levels
+/// @return Whether the report fits. If not, the batch is unchanged
+static inline bool add_to_report_batch(ReportBatch *batch, const int *levels, size_t levels_size)
+{
+    if (levels_size > REPORT_MAX_LEVELS)
+        return false;
+    for (size_t j = 0; j < levels_size; j++)
+        if (levels[j] < -REPORT_MAX_LEVEL || levels[j] > REPORT_MAX_LEVEL)
+            return false;
+
+    int r = batch->size++;
+    for (size_t j = 0; j < levels_size; j++)
+        batch->levels[j][r] = levels[j];
+    batch->lens[r] = levels_size;
+    return true;
+}
+
+/// @brief Find which changes in a batch of reports are safe in each direction
+/// @param batch The batch
+/// @param gap 1 for the changes between adjacent levels, or 2 for the changes that skip a level
+/// @param ok Out: ok[0][j] has the lanes where the change from level j to level j + gap is in MIN..MAX, ok[1][j] those
+/// where it is in -MAX..-MIN. Both also have the lanes where level j + gap is past the end of the report. Fills j from 0
+/// to REPORT_MAX_LEVELS - 1 - gap
+static inline void report_batch_changes(const ReportBatch *batch, int gap, ReportLanes ok[2][REPORT_MAX_LEVELS])
+{
+    for (int j = 0; j + gap < REPORT_MAX_LEVELS; j++)
+    {
+        ReportLanes change = batch->levels[j + gap] - batch->levels[j];
+        ReportLanes past_end = batch->lens <= (int16_t)(j + gap);
+        ok[0][j] = ((change >= REPORT_MIN_CHANGE) & (change <= REPORT_MAX_CHANGE)) | past_end;
+        ok[1][j] = ((change >= -REPORT_MAX_CHANGE) & (change <= -REPORT_MIN_CHANGE)) | past_end;
+    }
+}
+
+/// @brief Turn a vector of all ones and zeros lanes into a bit mask
+/// @param batch The batch the lanes are for. Lanes without a report are left out
+/// @param lanes The lanes
+/// @return A mask with bit r set if lane r is all ones
+static inline uint32_t report_batch_mask(const ReportBatch *batch, const ReportLanes *lanes)
+{
+    ReportLanes set = *lanes & (batch->lens > 0);
+    uint32_t mask = 0U;
+    for (int r = 0; r < REPORT_BATCH; r++)
+        mask |= (uint32_t)(set[r] & 1) << r;
+    return mask;
+}
+
+/// @brief Find which reports in a batch are safe without removing any levels
+/// @param batch The batch
+/// @return A mask with bit r set if report r is safe
+static inline uint32_t safe_in_report_batch(const ReportBatch *batch)
+{
+    ReportLanes ok[2][REPORT_MAX_LEVELS];
+    report_batch_changes(batch, 1, ok);
+    // Every lane starts safe in both directions, and is made unsafe by any change that isn't
+    ReportLanes increasing = ~(ReportLanes){0};
+    ReportLanes decreasing = ~(ReportLanes){0};
+    for (int j = 0; j + 1 < REPORT_MAX_LEVELS; j++)
+    {
+        increasing &= ok[0][j];
+        decreasing &= ok[1][j];
+    }
+    ReportLanes safe = increasing | decreasing;
+    return report_batch_mask(batch, &safe);
+}
+
+/// @brief Find which reports in a batch are safe with at most one level removed
+/// Removing level k keeps the changes before level k - 1 and after level k + 1, and replaces the two changes next to
+/// level k with the change from level k - 1 to level k + 1. Ending (prefix) and starting (suffix) runs of safe adjacent
+/// changes give the first part for every k at once, so each direction takes two passes over the levels
+/// @param batch The batch
+/// @return A mask with bit r set if report r is safe with at most one level removed
+static inline uint32_t dampened_safe_in_report_batch(const ReportBatch *batch)
+{
+    ReportLanes ok[2][REPORT_MAX_LEVELS], skip_ok[2][REPORT_MAX_LEVELS];
+    report_batch_changes(batch, 1, ok);
+    report_batch_changes(batch, 2, skip_ok);
+
+    const ReportLanes all = ~(ReportLanes){0};
+    ReportLanes safe = {0};
+    for (int direction = 0; direction < 2; direction++)
+    {
+        // suffix[i] has the lanes where changes i onwards are all safe
+        ReportLanes suffix[REPORT_MAX_LEVELS + 1];
+        suffix[REPORT_MAX_LEVELS] = suffix[REPORT_MAX_LEVELS - 1] = all;
+        for (int i = REPORT_MAX_LEVELS - 2; i >= 0; i--)
+            suffix[i] = suffix[i + 1] & ok[direction][i];
+
+        // The lanes where changes before k - 1 are all safe
+        ReportLanes prefix = all;
+        for (int k = 0; k < REPORT_MAX_LEVELS; k++)
+        {
+            ReportLanes removed = prefix & suffix[k + 1];
+            // Past the end of a report this is set, so removing its last level (or one it doesn't have) only needs the
+            // rest of its changes to be safe
+            if (k > 0 && k + 1 < REPORT_MAX_LEVELS)
+                removed &= skip_ok[direction][k - 1];
+            safe |= removed;
+            if (k > 0)
+                prefix &= ok[direction][k - 1];
+        }
+    }
+    return report_batch_mask(batch, &safe);
+}
+
+/// @brief Check whether a report is safe with at most `max_removed` levels removed, in O(levels * max_removed)
+/// fewest[i] is the fewest levels that must be removed before level i to keep it, with every kept change before it safe:
+/// either all of them, or those between it and an earlier kept level j whose change to level i is safe, after
+/// fewest[j]. Keeping the fewest is enough, since removals left over can only help later. j is at most max_removed + 1
+/// levels back, so only that many counts are kept, in a ring for each direction
+/// @param levels The levels of the report
+/// @param levels_size The number of levels
+/// @param max_removed The most levels that can be removed
+/// @return Whether the report is safe in either direction with at most `max_removed` levels removed
+static inline bool safe_with_removals(const int *levels, size_t levels_size, size_t max_removed)
+{
+    // A single level is safe
+    if (levels_size <= max_removed + 1)
+        return true;
+
+    size_t window = max_removed + 1;
+    size_t stack_fewest[2 * (REPORT_STACK_REMOVALS + 1)];
+    size_t *fewest[2];
+    fewest[0] = max_removed <= REPORT_STACK_REMOVALS ? stack_fewest : malloc(sizeof(fewest[0][0]) * 2 * window);
+    fewest[1] = fewest[0] + window;
+
+    bool safe = false;
+    // The last level that can be kept in either direction. Once the window has moved past it, no later one can be
+    size_t last_kept = 0;
+    // Where level i's counts go in the rings
+    size_t slot = 0;
+    for (size_t i = 0; i < levels_size && !safe; i++)
+    {
+        if (i > max_removed && i - last_kept > window)
+            break;
+        // Removing every level before this one
+        size_t best[2] = {i, i};
+        size_t back_slot = slot;
+        for (size_t back = 1; back <= i && back <= window; back++)
+        {
+            back_slot = back_slot ? back_slot - 1 : window - 1;
+            long long change = (long long)levels[i] - levels[i - back];
+            if (change >= REPORT_MIN_CHANGE && change <= REPORT_MAX_CHANGE && fewest[0][back_slot] + back - 1 < best[0])
+                best[0] = fewest[0][back_slot] + back - 1;
+            if (-change >= REPORT_MIN_CHANGE && -change <= REPORT_MAX_CHANGE && fewest[1][back_slot] + back - 1 < best[1])
+                best[1] = fewest[1][back_slot] + back - 1;
+        }
+        for (int direction = 0; direction < 2; direction++)
+        {
+            fewest[direction][slot] = best[direction];
+            if (best[direction] <= max_removed)
+                last_kept = i;
+            // Removing every level after this one too
+            if (best[direction] + (levels_size - 1 - i) <= max_removed)
+                safe = true;
+        }
+        slot = slot + 1 < window ? slot + 1 : 0;
+    }
+
+    if (fewest[0] != stack_fewest)
+        free(fewest[0]);
+    return safe;
+}
+
+#endif
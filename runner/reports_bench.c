@@ -0,0 +1,200 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "reports.h"
+#include "generator.h"
+#include "timer.h"
+
+// Compare safe_with_removals in reports.h with trying every set of at most k removals, on long reports like day 2's
+// For each k, half of the reports have k broken levels, which removing them fixes, and half have k + 1, so about half are
+// safe. Trying every set is only timed if it checks at most BRUTE_FORCE_MAX_LEVELS levels in total
+// Both must find the same safe reports, or the row is marked MISMATCH
+
+#define BRUTE_FORCE_MAX_LEVELS 10000000000.0
+
+void print_usage(char *program_name);
+void make_report(int *levels, int levels_size, int broken);
+bool safe_without(const int *levels, int levels_size, const bool *removed);
+bool brute_force_safe(const int *levels, int levels_size, bool *removed, int start, int max_removed);
+double count_subsets(int n, int k);
+
+int main(int argc, char *argv[])
+{
+    // The number of levels in each report, reports for each k, and the largest k
+    int levels_size = 10000;
+    int reports = 10;
+    int max_k = 4;
+    // The number of runs of safe_with_removals. The fastest is reported. Trying every set is only run once
+    int repetitions = 5;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:c:k:r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            levels_size = atoi(optarg);
+            break;
+        case 'c':
+            reports = atoi(optarg);
+            break;
+        case 'k':
+            max_k = atoi(optarg);
+            break;
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (levels_size < 2 || reports < 1 || max_k < 0 || repetitions < 1)
+    {
+        fprintf(stderr, "Reports need at least 2 levels, and there must be at least 1 report and repetition\n");
+        return 1;
+    }
+
+    int *levels = malloc(sizeof(levels[0]) * levels_size * reports);
+    bool *removed = calloc(levels_size, sizeof(removed[0]));
+    bool *dp_safe = malloc(sizeof(dp_safe[0]) * reports);
+    printf("%-3s %10s %8s %14s %16s %10s\n", "k", "Levels", "Safe", "DP (ms)", "Every set (ms)", "Speedup");
+    for (int k = 0; k <= max_k; k++)
+    {
+        seed_random(DEFAULT_SEED + k);
+        for (int r = 0; r < reports; r++)
+            make_report(&levels[(size_t)r * levels_size], levels_size, k + (r & 1));
+
+        long long dp_ns = -1LL;
+        int safe_count = 0;
+        for (int rep = 0; rep < repetitions; rep++)
+        {
+            long long start = now_ns();
+            for (int r = 0; r < reports; r++)
+                dp_safe[r] = safe_with_removals(&levels[(size_t)r * levels_size], levels_size, k);
+            long long ns = now_ns() - start;
+            if (dp_ns < 0 || ns < dp_ns)
+                dp_ns = ns;
+        }
+        for (int r = 0; r < reports; r++)
+            safe_count += dp_safe[r];
+        printf("%-3d %10d %8d %14.3f", k, levels_size, safe_count, dp_ns / 1e6);
+
+        if (count_subsets(levels_size, k) * levels_size * reports > BRUTE_FORCE_MAX_LEVELS)
+        {
+            printf(" %16s %10s\n", "-", "-");
+            continue;
+        }
+        bool mismatch = false;
+        long long start = now_ns();
+        for (int r = 0; r < reports; r++)
+            mismatch |= brute_force_safe(&levels[(size_t)r * levels_size], levels_size, removed, 0, k) != dp_safe[r];
+        long long brute_ns = now_ns() - start;
+        printf(" %16.3f %9.1fx%s\n", brute_ns / 1e6, (double)brute_ns / (dp_ns ? dp_ns : 1), mismatch ? " MISMATCH" : "");
+    }
+
+    free(levels);
+    free(removed);
+    free(dp_safe);
+    return 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr, "Usage: %s [-n LEVELS] [-c REPORTS] [-k MAX_REMOVED] [-r REPETITIONS]\n", program_name);
+}
+
+/// @brief Make a safe report in a random direction, with some broken levels among its levels
+/// @param levels Out: The levels
+/// @param levels_size The number of levels
+/// @param broken The number of broken levels. Each is far the wrong way from the level before it, so it has to be
+/// removed, and removing it leaves a safe change
+void make_report(int *levels, int levels_size, int broken)
+{
+    int direction = (next_random() & 1) ? 1 : -1;
+    // One broken level in each of `broken` equal parts of the report
+    int b = 0;
+    int next_broken = broken ? random_range(0, levels_size / broken - 1) : -1;
+    int last = 0;
+    for (int i = 0; i < levels_size; i++)
+    {
+        if (i == next_broken)
+        {
+            levels[i] = last - direction * 1000;
+            b++;
+            next_broken = b < broken ? random_range((long long)levels_size * b / broken, (long long)levels_size * (b + 1) / broken - 1) : -1;
+            continue;
+        }
+        last = i ? last + direction * random_range(1, 3) : 0;
+        levels[i] = last;
+    }
+}
+
+/// @brief Check whether a report is safe in either direction with some levels removed
+/// @param levels The levels
+/// @param levels_size The number of levels
+/// @param removed Whether each level is removed
+/// @return Whether every change between kept levels is safe in the same direction
+bool safe_without(const int *levels, int levels_size, const bool *removed)
+{
+    for (int direction = 0; direction < 2; direction++)
+    {
+        bool safe = true;
+        int last = -1;
+        for (int i = 0; i < levels_size && safe; i++)
+        {
+            if (removed[i])
+                continue;
+            if (last >= 0)
+            {
+                int change = direction ? levels[last] - levels[i] : levels[i] - levels[last];
+                safe = change >= REPORT_MIN_CHANGE && change <= REPORT_MAX_CHANGE;
+            }
+            last = i;
+        }
+        if (safe)
+            return true;
+    }
+    return false;
+}
+
+/// @brief Check whether a report is safe by trying every set of at most `max_removed` levels to remove
+/// @param levels The levels
+/// @param levels_size The number of levels
+/// @param removed Which levels are removed so far. Restored before returning
+/// @param start The first level that may be removed next, so each set is only tried once
+/// @param max_removed The most levels that may still be removed
+/// @return Whether any of the sets makes the report safe
+bool brute_force_safe(const int *levels, int levels_size, bool *removed, int start, int max_removed)
+{
+    if (safe_without(levels, levels_size, removed))
+        return true;
+    if (!max_removed)
+        return false;
+    for (int i = start; i < levels_size; i++)
+    {
+        removed[i] = true;
+        bool safe = brute_force_safe(levels, levels_size, removed, i + 1, max_removed - 1);
+        removed[i] = false;
+        if (safe)
+            return true;
+    }
+    return false;
+}
+
+/// @brief Count the sets of at most k of n things
+/// @param n The number of things
+/// @param k The most things in a set
+/// @return The number of sets, approximately if it is large
+double count_subsets(int n, int k)
+{
+    double total = 0.0, choose = 1.0;
+    for (int i = 0; i <= k && i <= n; i++)
+    {
+        total += choose;
+        choose = choose * (n - i) / (i + 1);
+    }
+    return total;
+}
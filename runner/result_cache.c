@@ -0,0 +1,164 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <link.h>
+#include <sys/stat.h>
+
+#include "result_cache.h"
+#include "input.h"
+#include "hashmap.h"
+
+// The first line of every entry, so files from anything else (or an older format) are never read as answers
+#define RESULT_CACHE_MAGIC "aoc-result 1"
+
+// The notes of the program's own ELF headers hold the build id the linker computed from everything it linked
+static int find_build_id(struct dl_phdr_info *info, size_t size, void *data)
+{
+    uint64_t *build_hash = data;
+    for (int i = 0; i < info->dlpi_phnum; i++)
+    {
+        if (info->dlpi_phdr[i].p_type != PT_NOTE)
+            continue;
+        const char *note = (const char *)(info->dlpi_addr + info->dlpi_phdr[i].p_vaddr);
+        const char *end = note + info->dlpi_phdr[i].p_memsz;
+        while (note + sizeof(ElfW(Nhdr)) <= end)
+        {
+            const ElfW(Nhdr) *header = (const ElfW(Nhdr) *)note;
+            const char *name = note + sizeof(*header);
+            const char *desc = name + ((header->n_namesz + 3) & ~3U);
+            if (header->n_type == NT_GNU_BUILD_ID && header->n_namesz == 4 && !memcmp(name, "GNU", 4))
+            {
+                for (ElfW(Word) j = 0; j < header->n_descsz; j++)
+                    *build_hash = hash_mix(*build_hash ^ (uint8_t)desc[j]);
+                return 1;
+            }
+            note = desc + ((header->n_descsz + 3) & ~3U);
+        }
+    }
+    // Only the program itself, which is always first
+    return 1;
+}
+
+/// @brief Open a cache directory, creating it if needed
+/// @param cache Out: The cache
+/// @param dir The directory
+/// @return 0 if success, 1 if the directory can't be created or the program has no build id to key entries with
+int open_result_cache(ResultCache *cache, const char *dir)
+{
+    if (mkdir(dir, 0777) && errno != EEXIST)
+    {
+        perror("Error creating the result cache");
+        return 1;
+    }
+    snprintf(cache->dir, sizeof(cache->dir), "%s", dir);
+
+    cache->build_hash = 0ULL;
+    dl_iterate_phdr(find_build_id, &cache->build_hash);
+    if (!cache->build_hash)
+    {
+        fprintf(stderr, "This build has no build id (link with -Wl,--build-id), so results can't be cached\n");
+        return 1;
+    }
+    return 0;
+}
+
+/// @brief Hash an input in one pass over its mapped bytes
+/// @param cache The cache
+/// @param solver The solver the answer is for
+/// @param input_file The input
+/// @param key Out: The key of the answer
+/// @return 0 if success, non-zero if the input can't be read
+int get_result_key(const ResultCache *cache, const Solver *solver, char *input_file, ResultKey *key)
+{
+    Input input;
+    if (open_input(input_file, &input))
+        return 1;
+
+    // Two independent lanes of 64 bits, 8 bytes at a time
+    uint64_t h0 = cache->build_hash ^ ((uint64_t)solver->day << 8 | (uint64_t)solver->part);
+    uint64_t h1 = hash_mix(h0 + 0x9e3779b97f4a7c15ULL);
+    size_t i = 0;
+    for (; i + 8 <= input.size; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, input.data + i, sizeof(word));
+        h0 = (h0 ^ word) * 0x9fb21c651e98df25ULL;
+        h0 ^= h0 >> 29;
+        h1 = (h1 + word) * 0xc2b2ae3d27d4eb4fULL;
+        h1 ^= h1 >> 31;
+    }
+    // The input is null terminated, so the last word can be padded with zeros
+    uint64_t last = 0ULL;
+    memcpy(&last, input.data + i, input.size - i);
+    key->hash[0] = hash_mix(h0 ^ last ^ input.size);
+    key->hash[1] = hash_mix(h1 + last + input.size);
+    key->input_size = input.size;
+
+    close_input(&input);
+    return 0;
+}
+
+// Get the path of the entry for a key
+static void get_entry_file(const ResultCache *cache, ResultKey key, char *file, size_t file_size)
+{
+    snprintf(file, file_size, "%s/%016llx%016llx", cache->dir, (unsigned long long)key.hash[0], (unsigned long long)key.hash[1]);
+}
+
+/// @brief Read a cached answer
+/// @param cache The cache
+/// @param solver The solver the answer is for
+/// @param key The key from get_result_key
+/// @param answer Out: The answer, if it was cached
+/// @return true if the answer was cached
+bool get_cached_result(const ResultCache *cache, const Solver *solver, ResultKey key, char *answer)
+{
+    char file[INPUT_FILE_SIZE + 40];
+    get_entry_file(cache, key, file, sizeof(file));
+    FILE *f = fopen(file, "r");
+    if (f == NULL)
+        return false;
+
+    // The magic line, then "DAY PART INPUT_SIZE", then the answer
+    char magic[sizeof(RESULT_CACHE_MAGIC) + 1];
+    int day, part;
+    unsigned long long input_size;
+    bool found = fgets(magic, sizeof(magic), f) && !strcmp(magic, RESULT_CACHE_MAGIC "\n") &&
+                 fscanf(f, "%d %d %llu\n", &day, &part, &input_size) == 3 &&
+                 day == solver->day && part == solver->part && input_size == key.input_size &&
+                 fgets(answer, ANSWER_SIZE, f);
+    fclose(f);
+    if (!found)
+        return false;
+    answer[strcspn(answer, "\n")] = '\0';
+    return true;
+}
+
+/// @brief Save an answer, replacing any cached one
+/// @param cache The cache
+/// @param solver The solver the answer is for
+/// @param key The key from get_result_key
+/// @param answer The answer
+void put_cached_result(const ResultCache *cache, const Solver *solver, ResultKey key, const char *answer)
+{
+    char file[INPUT_FILE_SIZE + 40];
+    char temp_file[INPUT_FILE_SIZE + 40];
+    get_entry_file(cache, key, file, sizeof(file));
+    snprintf(temp_file, sizeof(temp_file), "%s/.tmp-XXXXXX", cache->dir);
+
+    int fd = mkstemp(temp_file);
+    if (fd == -1)
+        return;
+    FILE *f = fdopen(fd, "w");
+    if (f == NULL)
+    {
+        close(fd);
+        unlink(temp_file);
+        return;
+    }
+    fprintf(f, RESULT_CACHE_MAGIC "\n%d %d %llu\n%s\n", solver->day, solver->part, (unsigned long long)key.input_size, answer);
+    // Only a complete entry is renamed into place, which replaces any old one at once
+    if (fclose(f) || rename(temp_file, file))
+        unlink(temp_file);
+}
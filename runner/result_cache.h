@@ -0,0 +1,38 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "solver.h"
+#include "solvers.h"
+
+// Answers from earlier runs, stored on disk so an unchanged input doesn't have to be solved again
+// Each answer is a file in the cache directory named by a hash of the input's bytes, the day and part, and the build
+// id of the program. Every constant a solver is compiled with (MIN_SAVE, INDIRECTION, MAX_CHEAT_LENGTH, ...) is part
+// of the build, so changing one changes every key instead of returning stale answers.
+// Entries are written to a temporary file and renamed into place, so processes sharing a directory only ever see
+// whole entries, and two processes writing the same entry both write the same answer.
+
+typedef struct ResultCache
+{
+    // The directory holding the entries
+    char dir[INPUT_FILE_SIZE];
+    // A hash of the program's build id, which is in every key
+    uint64_t build_hash;
+} ResultCache;
+
+// The key of one input's answer for one solver
+typedef struct ResultKey
+{
+    uint64_t hash[2];
+    // The size of the input, which is checked on reading in case two inputs hash the same
+    uint64_t input_size;
+} ResultKey;
+
+int open_result_cache(ResultCache *cache, const char *dir);
+int get_result_key(const ResultCache *cache, const Solver *solver, char *input_file, ResultKey *key);
+bool get_cached_result(const ResultCache *cache, const Solver *solver, ResultKey key, char *answer);
+void put_cached_result(const ResultCache *cache, const Solver *solver, ResultKey key, const char *answer);
+
+#endif
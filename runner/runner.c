@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <getopt.h>
+
+#include "solvers.h"
+#include "perf_counters.h"
+#include "thread_pool.h"
+#include "result_cache.h"
+#include "trace.h"
+
+typedef struct SolverResult
+{
+    char answer[ANSWER_SIZE];
+    // Time spent in `parse` in nanoseconds
+    long long parse_ns;
+    // Time spent in `solve` in nanoseconds
+    long long solve_ns;
+    // Hardware events in each phase, if counting
+    PerfSample parse_events;
+    PerfSample solve_events;
+    // Whether the answer came from the result cache, so nothing was timed
+    bool cached;
+    // 0 if success, non-zero if failure
+    int error;
+} SolverResult;
+
+void print_usage(char *program_name);
+SolverResult run_solver(const Solver *solver, char *input_dir, bool verbose, bool stream, PerfCounters *counters, ResultCache *cache,
+                        bool refresh);
+void print_events(int day, int part, char *phase, PerfSample sample);
+
+int main(int argc, char *argv[])
+{
+    // The directory containing day_XX/input.txt
+    char *input_dir = ".";
+    // Whether to let solvers print to stdout
+    bool verbose = false;
+    // Whether to count hardware events in each phase
+    bool count_events = false;
+    // The number of threads for solvers that use parallel_for
+    int threads = 1;
+    // The result cache directory, or NULL to not cache
+    char *cache_dir = getenv("AOC_CACHE_DIR");
+    // Whether to solve again and replace cached answers instead of reading them
+    bool refresh = false;
+    // Whether solvers that can should solve their input while reading it
+    bool stream = false;
+
+    static const struct option long_options[] = {{"threads", required_argument, NULL, 'j'}, {NULL, 0, NULL, 0}};
+    int opt;
+    while ((opt = getopt_long(argc, argv, "i:vcj:C:BRsh", long_options, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 'i':
+            input_dir = optarg;
+            break;
+        case 'v':
+            verbose = true;
+            break;
+        case 'c':
+            count_events = true;
+            break;
+        case 'j':
+            threads = atoi(optarg);
+            break;
+        case 'C':
+            cache_dir = optarg;
+            break;
+        case 'B':
+            cache_dir = NULL;
+            break;
+        case 'R':
+            refresh = true;
+            break;
+        case 's':
+            stream = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    bool selected[all_solvers_size];
+    if (select_solvers(argc - optind, argv + optind, selected))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (threads < 1 || threads > MAX_THREADS)
+    {
+        fprintf(stderr, "Threads must be between 1 and %d\n", MAX_THREADS);
+        return 1;
+    }
+
+    // Without a usable cache, every solver just runs
+    ResultCache cache;
+    ResultCache *result_cache = NULL;
+    if (cache_dir && cache_dir[0] && !open_result_cache(&cache, cache_dir))
+        result_cache = &cache;
+
+    // Counting is best effort: without perf events (e.g. in a container), the counts are just left out
+    PerfCounters counters;
+    if (count_events && !open_perf_counters(&counters))
+    {
+        fprintf(stderr, "Hardware event counters are unavailable, only timing\n");
+        close_perf_counters(&counters);
+        count_events = false;
+    }
+    // The workers start after the events are opened, so they inherit them
+    set_thread_count(threads);
+
+    SolverResult *results = malloc(sizeof(results[0]) * all_solvers_size);
+
+    printf("%-4s %-4s %-24s %12s %12s\n", "Day", "Part", "Answer", "Parse (ms)", "Solve (ms)");
+    long long total_parse_ns = 0LL;
+    long long total_solve_ns = 0LL;
+    int failures = 0;
+    for (size_t i = 0; i < all_solvers_size; i++)
+    {
+        if (!selected[i])
+            continue;
+
+        const Solver *solver = all_solvers[i];
+        SolverResult result = results[i] = run_solver(solver, input_dir, verbose, stream, count_events ? &counters : NULL, result_cache, refresh);
+        if (result.error)
+        {
+            failures++;
+            printf("%-4d %-4d %-24s %12s %12s\n", solver->day, solver->part, "FAILED", "-", "-");
+            continue;
+        }
+        if (result.cached)
+        {
+            printf("%-4d %-4d %-24s %12s %12s\n", solver->day, solver->part, result.answer, "cached", "cached");
+            continue;
+        }
+
+        total_parse_ns += result.parse_ns;
+        total_solve_ns += result.solve_ns;
+        printf("%-4d %-4d %-24s %12.3f %12.3f\n", solver->day, solver->part, result.answer, result.parse_ns / 1e6, result.solve_ns / 1e6);
+    }
+    printf("%-4s %-4s %-24s %12.3f %12.3f\n", "", "", "Total", total_parse_ns / 1e6, total_solve_ns / 1e6);
+
+    if (count_events)
+    {
+        printf("\n%-4s %-4s %-6s", "Day", "Part", "Phase");
+        for (int event = 0; event < PERF_EVENTS; event++)
+            printf(" %15s", perf_event_names[event]);
+        printf(" %6s\n", "IPC");
+        for (size_t i = 0; i < all_solvers_size; i++)
+        {
+            if (!selected[i] || results[i].error || results[i].cached)
+                continue;
+            print_events(all_solvers[i]->day, all_solvers[i]->part, "parse", results[i].parse_events);
+            print_events(all_solvers[i]->day, all_solvers[i]->part, "solve", results[i].solve_events);
+        }
+        close_perf_counters(&counters);
+    }
+
+    free(results);
+    set_thread_count(1);
+    return failures ? 1 : 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr,
+            "Usage: %s [-i INPUT_DIR] [-v] [-c] [-j THREADS] [-C CACHE_DIR] [-B] [-R] [-s] [DAY[.PART] ...]\n"
+            "Run the given solvers in-process, or every solver if none are given.\n"
+            "  -i INPUT_DIR  Read each day's input from INPUT_DIR/day_XX/input.txt (default: .), or from stdin if INPUT_DIR is -\n"
+            "  -v            Let solvers print to stdout\n"
+            "  -c            Count cycles, instructions, cache misses, and branch misses in each phase, summed over the -j\n"
+            "                workers and -s reader threads (Linux only)\n"
+            "  -j THREADS    Run the loops of solvers that use parallel_for on THREADS threads (default: 1). Also --threads\n"
+            "  -C CACHE_DIR  Reuse answers for unchanged inputs from CACHE_DIR, and save new ones (default: $AOC_CACHE_DIR)\n"
+            "  -B            Bypass the cache: don't read or write it\n"
+            "  -R            Refresh the cache: solve again and replace the cached answers\n"
+            "  -s            Stream: solvers that can (days 2, 7, 13, and 22 part 1) solve while reading, in bounded memory.\n"
+            "                The whole time is under Solve\n",
+            program_name);
+}
+
+/// @brief Parse and solve one puzzle, timing each phase
+/// @param solver The solver to run
+/// @param input_dir The directory containing day_XX/input.txt
+/// @param verbose Whether to let the solver print to stdout
+/// @param stream Whether to solve while reading the input, if the solver can
+/// @param counters The counters to count hardware events in each phase with, or NULL to not count
+/// @param cache The result cache, or NULL to not cache
+/// @param refresh Whether to solve even if the answer is cached, replacing it
+/// @return The answer, timings, and event counts
+SolverResult run_solver(const Solver *solver, char *input_dir, bool verbose, bool stream, PerfCounters *counters, ResultCache *cache,
+                        bool refresh)
+{
+    SolverResult result = {.error = 1};
+    char input_path[INPUT_FILE_SIZE];
+    get_input_file(input_path, sizeof(input_path), input_dir, solver->day);
+    // stdin can only be read once, so it is never cached
+    char *input_file = input_path;
+    if (!strcmp(input_dir, "-"))
+    {
+        input_file = NULL;
+        cache = NULL;
+    }
+
+    ResultKey key;
+    if (cache && get_result_key(cache, solver, input_file, &key))
+        cache = NULL;
+    if (cache && !refresh && get_cached_result(cache, solver, key, result.answer))
+    {
+        result.cached = true;
+        result.error = 0;
+        return result;
+    }
+
+    silence_stdout(!verbose);
+    // The tables are built for every run, so the solve time is the same as for a single input
+    init_solver_tables(solver);
+
+    if (stream && solver->stream)
+    {
+        // Parsing and solving overlap, so they are timed together
+        if (counters)
+            start_perf_counters(counters);
+        long long start = now_ns();
+        TRACE_BEGIN_ARG("stream", "day", solver->day);
+        result.error = solver->stream(input_file, result.answer);
+        TRACE_END();
+        result.solve_ns = now_ns() - start;
+        if (counters)
+            result.solve_events = stop_perf_counters(counters);
+        if (cache && !result.error)
+            put_cached_result(cache, solver, key, result.answer);
+        for (int event = 0; event < PERF_EVENTS; event++)
+            result.parse_events.count[event] = -1LL;
+
+        delete_solver_tables(solver);
+        silence_stdout(false);
+        return result;
+    }
+
+    if (counters)
+        start_perf_counters(counters);
+    long long start = now_ns();
+    TRACE_BEGIN_ARG("parse", "day", solver->day);
+    void *puzzle = solver->parse(input_file);
+    TRACE_END();
+    result.parse_ns = now_ns() - start;
+    if (counters)
+        result.parse_events = stop_perf_counters(counters);
+
+    if (puzzle)
+    {
+        if (counters)
+            start_perf_counters(counters);
+        start = now_ns();
+        TRACE_BEGIN_ARG("solve", "day", solver->day);
+        result.error = solver->solve(puzzle, result.answer);
+        TRACE_END();
+        result.solve_ns = now_ns() - start;
+        if (counters)
+            result.solve_events = stop_perf_counters(counters);
+        solver->delete(puzzle);
+        if (cache && !result.error)
+            put_cached_result(cache, solver, key, result.answer);
+    }
+
+    delete_solver_tables(solver);
+    silence_stdout(false);
+    return result;
+}
+
+// Print one row of the event table, with "-" for unavailable events
+void print_events(int day, int part, char *phase, PerfSample sample)
+{
+    printf("%-4d %-4d %-6s", day, part, phase);
+    for (int event = 0; event < PERF_EVENTS; event++)
+    {
+        if (sample.count[event] >= 0)
+            printf(" %15lld", sample.count[event]);
+        else
+            printf(" %15s", "-");
+    }
+    if (sample.count[PERF_CYCLES] > 0 && sample.count[PERF_INSTRUCTIONS] >= 0)
+        printf(" %6.2f\n", (double)sample.count[PERF_INSTRUCTIONS] / sample.count[PERF_CYCLES]);
+    else
+        printf(" %6s\n", "-");
+}
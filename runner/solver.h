@@ -0,0 +1,51 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stddef.h>
+
+// The maximum length of an answer, including the null terminator
+#define ANSWER_SIZE 256
+
+// The entry points of one part of one day so the runner can parse and solve it in-process
+typedef struct Solver
+{
+    int day;
+    int part;
+    /// @brief Parse the input file into the state used by `solve`
+    /// @param input_file The path of the file to input from. If null, stdin will be used
+    /// @return The parsed puzzle, or NULL if failure
+    void *(*parse)(char *input_file);
+    /// @brief Solve a parsed puzzle
+    /// @param puzzle The puzzle returned by `parse`. This may be modified
+    /// @param answer Out: The answer as a string of at most ANSWER_SIZE characters, including the null terminator
+    /// @return 0 if success, non-zero if failure
+    int (*solve)(void *puzzle, char *answer);
+    /// @brief Free everything allocated by `parse`
+    /// @param puzzle The puzzle returned by `parse`
+    void (*delete)(void *puzzle);
+    /// @brief Build the tables that depend only on the day, not the input, such as memoization caches. May be NULL.
+    /// The tables are shared by every puzzle solved until `delete_tables`, so a batch of inputs builds them once
+    void (*init_tables)(void);
+    /// @brief Free the tables built by `init_tables`. May be NULL
+    void (*delete_tables)(void);
+    /// @brief Parse and solve at once while the input is read, without keeping all of it (see stream.h). May be NULL
+    /// @param input_file The path of the file to input from. If null, stdin will be used
+    /// @param answer Out: The answer, the same as from `solve`
+    /// @return 0 if success, non-zero if failure
+    int (*stream)(char *input_file, char *answer);
+} Solver;
+
+// Define the solver for a day and part. The runner keeps only these symbols global when it links every part together,
+// so the rest of each part can keep using the same names (parse_input, print_map, ...) as every other part.
+#define DEF_SOLVER(d, p, parse_fn, solve_fn, delete_fn) \
+    const Solver day##d##_part##p##_solver = {d, p, parse_fn, solve_fn, delete_fn, NULL, NULL, NULL};
+
+// Define the solver for a day and part that keeps tables between puzzles. See Solver.init_tables
+#define DEF_SOLVER_WITH_TABLES(d, p, parse_fn, solve_fn, delete_fn, init_tables_fn, delete_tables_fn) \
+    const Solver day##d##_part##p##_solver = {d, p, parse_fn, solve_fn, delete_fn, init_tables_fn, delete_tables_fn, NULL};
+
+// Define the solver for a day and part that can also solve its input while it is read. See Solver.stream
+#define DEF_STREAM_SOLVER(d, p, parse_fn, solve_fn, delete_fn, stream_fn) \
+    const Solver day##d##_part##p##_solver = {d, p, parse_fn, solve_fn, delete_fn, NULL, NULL, stream_fn};
+
+#endif
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "solvers.h"
+
+#define SOLVER_ADDRESS(d, p) &day##d##_part##p##_solver,
+const Solver *all_solvers[] = {FOR_EACH_SOLVER(SOLVER_ADDRESS)};
+#undef SOLVER_ADDRESS
+
+const size_t all_solvers_size = sizeof(all_solvers) / sizeof(all_solvers[0]);
+
+/// @brief Parse the solver selection from the command line
+/// @param argc The number of selection arguments
+/// @param argv The selection arguments, each in the form DAY or DAY.PART
+/// @param selected Out: For each solver in `all_solvers`, whether it was selected
+/// @return 0 if success, non-zero if an argument is invalid
+int select_solvers(int argc, char *argv[], bool *selected)
+{
+    // Select everything if there is no selection
+    for (size_t i = 0; i < all_solvers_size; i++)
+        selected[i] = !argc;
+
+    for (int i = 0; i < argc; i++)
+    {
+        char *end;
+        int day = (int)strtol(argv[i], &end, 10);
+        int part = 0;
+        if (*end == '.')
+            part = (int)strtol(end + 1, &end, 10);
+        if (*end || end == argv[i])
+        {
+            fprintf(stderr, "Invalid solver: '%s'\n", argv[i]);
+            return 1;
+        }
+
+        bool found = false;
+        for (size_t j = 0; j < all_solvers_size; j++)
+        {
+            if (all_solvers[j]->day == day && (!part || all_solvers[j]->part == part))
+            {
+                selected[j] = true;
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            fprintf(stderr, "No solver for '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/// @brief Get the path of a day's input
+/// @param input_file Out: The path, INPUT_DIR/day_XX/input.txt
+/// @param input_file_size The size of `input_file`
+/// @param input_dir The directory containing day_XX/input.txt
+/// @param day The day
+void get_input_file(char *input_file, size_t input_file_size, char *input_dir, int day)
+{
+    snprintf(input_file, input_file_size, "%s/day_%02d/input.txt", input_dir, day);
+}
+
+// Build the solver's shared tables, if it has any
+void init_solver_tables(const Solver *solver)
+{
+    if (solver->init_tables)
+        solver->init_tables();
+}
+
+// Free the solver's shared tables, if it has any
+void delete_solver_tables(const Solver *solver)
+{
+    if (solver->delete_tables)
+        solver->delete_tables();
+}
+
+/// @brief Redirect stdout to /dev/null, or restore it. Solvers print a lot of debugging output that would otherwise bury the results
+/// @param silence true to redirect stdout to /dev/null, false to restore it
+void silence_stdout(bool silence)
+{
+    // The original stdout while silenced, or -1 if not silenced
+    static int saved_stdout = -1;
+
+    fflush(stdout);
+    if (silence && saved_stdout == -1)
+    {
+        int dev_null = open("/dev/null", O_WRONLY);
+        if (dev_null == -1)
+            return;
+        saved_stdout = dup(STDOUT_FILENO);
+        dup2(dev_null, STDOUT_FILENO);
+        close(dev_null);
+    }
+    else if (!silence && saved_stdout != -1)
+    {
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+        saved_stdout = -1;
+    }
+}
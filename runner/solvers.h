@@ -0,0 +1,78 @@
+#ifndef SOLVERS_H
+#define SOLVERS_H
+
+#include <stdbool.h>
+
+#include "solver.h"
+#include "timer.h"
+
+// The maximum length of a path to an input file
+#define INPUT_FILE_SIZE 4096
+
+// Every day and part the runner knows about, in order. Day 24 part 2 was solved by hand, so it has no solver
+// X(day, part) is expanded once per solver
+#define FOR_EACH_SOLVER(X) \
+    X(1, 1)                \
+    X(1, 2)                \
+    X(2, 1)                \
+    X(2, 2)                \
+    X(3, 1)                \
+    X(3, 2)                \
+    X(4, 1)                \
+    X(4, 2)                \
+    X(5, 1)                \
+    X(5, 2)                \
+    X(6, 1)                \
+    X(6, 2)                \
+    X(7, 1)                \
+    X(7, 2)                \
+    X(8, 1)                \
+    X(8, 2)                \
+    X(9, 1)                \
+    X(9, 2)                \
+    X(10, 1)               \
+    X(10, 2)               \
+    X(11, 1)               \
+    X(11, 2)               \
+    X(12, 1)               \
+    X(12, 2)               \
+    X(13, 1)               \
+    X(13, 2)               \
+    X(14, 1)               \
+    X(14, 2)               \
+    X(15, 1)               \
+    X(15, 2)               \
+    X(16, 1)               \
+    X(16, 2)               \
+    X(17, 1)               \
+    X(17, 2)               \
+    X(18, 1)               \
+    X(18, 2)               \
+    X(19, 1)               \
+    X(19, 2)               \
+    X(20, 1)               \
+    X(20, 2)               \
+    X(21, 1)               \
+    X(21, 2)               \
+    X(22, 1)               \
+    X(22, 2)               \
+    X(23, 1)               \
+    X(23, 2)               \
+    X(24, 1)               \
+    X(25, 1)
+
+#define DECLARE_SOLVER(d, p) extern const Solver day##d##_part##p##_solver;
+FOR_EACH_SOLVER(DECLARE_SOLVER)
+#undef DECLARE_SOLVER
+
+// Every solver in FOR_EACH_SOLVER, in order
+extern const Solver *all_solvers[];
+extern const size_t all_solvers_size;
+
+int select_solvers(int argc, char *argv[], bool *selected);
+void get_input_file(char *input_file, size_t input_file_size, char *input_dir, int day);
+void init_solver_tables(const Solver *solver);
+void delete_solver_tables(const Solver *solver);
+void silence_stdout(bool silence);
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef SORT_H
+#define SORT_H
+
+// Sorting arrays of ints without comparing them
+// sort_ints finds the range of the values first. If it is small compared to the number of values (like day 1's 5 digit
+// location IDs in a long list), the values are counting sorted: count each value, then write each one out as many times as
+// it was counted. Otherwise they are LSD radix sorted on (value - min), a digit at a time from the lowest: one pass makes
+// the histogram of every digit, then each digit takes one pass to scatter the values into a scratch array in order of that
+// digit. Digits are 8 or 11 bits, whichever needs fewer passes, and a digit that is the same in every value is skipped.
+// Both are O(n) for a fixed range, where merge sort is O(n log n).
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Counting sort is used if there are at least this many values for each value in the range. With fewer, going over the
+// counts costs more than radix sorting the values (`make sort-bench`)
+#define SORT_COUNTING_MIN_DENSITY 2
+// The widest digit, whose histogram (2^11 counts) still fits in the L1 cache
+#define SORT_MAX_DIGIT_BITS 11
+
+/// @brief Find the smallest and largest values in an array
+/// @param arr The array, which must not be empty
+/// @param n The length of the array
+/// @param min Out: The smallest value
+/// @param max Out: The largest value
+static inline void int_range(const int *arr, size_t n, int *min, int *max)
+{
+    int lo = arr[0], hi = arr[0];
+    for (size_t i = 1; i < n; i++)
+    {
+        lo = arr[i] < lo ? arr[i] : lo;
+        hi = arr[i] > hi ? arr[i] : hi;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+/// @brief Sort an array by counting each value
+/// @param arr The array to sort, in place
+/// @param n The length of the array
+/// @param min The smallest value in the array
+/// @param max The largest value in the array. Uses (max - min + 1) counts of memory
+static inline void counting_sort_ints(int *arr, size_t n, int min, int max)
+{
+    size_t range = (size_t)((uint32_t)max - (uint32_t)min) + 1;
+    size_t *counts = calloc(range, sizeof(counts[0]));
+    for (size_t i = 0; i < n; i++)
+        counts[(uint32_t)arr[i] - (uint32_t)min]++;
+
+    int *out = arr;
+    for (size_t value = 0; value < range; value++)
+        for (size_t count = counts[value]; count; count--)
+            *out++ = (int)((uint32_t)min + value);
+    free(counts);
+}
+
+/// @brief Sort an array with an LSD radix sort on each value's offset from the smallest value
+/// @param arr The array to sort, in place
+/// @param n The length of the array
+/// @param min The smallest value in the array
+/// @param max The largest value in the array. Uses a scratch array of n ints
+static inline void radix_sort_ints(int *arr, size_t n, int min, int max)
+{
+    uint32_t range = (uint32_t)max - (uint32_t)min;
+    if (!range)
+        return;
+    int bits = 32 - __builtin_clz(range);
+    // 11 bit digits only if they save a pass, since their histograms are 8 times larger
+    int digit_bits = (bits + SORT_MAX_DIGIT_BITS - 1) / SORT_MAX_DIGIT_BITS < (bits + 7) / 8 ? SORT_MAX_DIGIT_BITS : 8;
+    int passes = (bits + digit_bits - 1) / digit_bits;
+    size_t radix = 1UL << digit_bits;
+    uint32_t digit_mask = radix - 1;
+
+    // Every digit's histogram in one pass
+    size_t *counts = calloc(radix * passes, sizeof(counts[0]));
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t key = (uint32_t)arr[i] - (uint32_t)min;
+        for (int pass = 0; pass < passes; pass++)
+            counts[(pass * radix) + ((key >> (pass * digit_bits)) & digit_mask)]++;
+    }
+
+    int *scratch = malloc(sizeof(scratch[0]) * n);
+    int *src = arr, *dst = scratch;
+    for (int pass = 0; pass < passes; pass++)
+    {
+        int shift = pass * digit_bits;
+        size_t *offsets = &counts[pass * radix];
+        // Every value has the same digit, so this pass wouldn't move anything
+        if (offsets[(((uint32_t)src[0] - (uint32_t)min) >> shift) & digit_mask] == n)
+            continue;
+
+        // Turn the histogram into where the first value with each digit goes
+        size_t total = 0UL;
+        for (size_t digit = 0; digit < radix; digit++)
+        {
+            size_t count = offsets[digit];
+            offsets[digit] = total;
+            total += count;
+        }
+        for (size_t i = 0; i < n; i++)
+            dst[offsets[(((uint32_t)src[i] - (uint32_t)min) >> shift) & digit_mask]++] = src[i];
+
+        int *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != arr)
+        memcpy(arr, src, sizeof(arr[0]) * n);
+    free(scratch);
+    free(counts);
+}
+
+/// @brief Sort an array in ascending order, counting sorting it if the range of its values is small and radix sorting it
+/// otherwise
+/// @param arr The array to sort, in place
+/// @param n The length of the array
+static inline void sort_ints(int *arr, size_t n)
+{
+    if (n < 2)
+        return;
+    int min, max;
+    int_range(arr, n, &min, &max);
+    size_t range = (size_t)((uint32_t)max - (uint32_t)min) + 1;
+    if (range <= n / SORT_COUNTING_MIN_DENSITY)
+        counting_sort_ints(arr, n, min, max);
+    else
+        radix_sort_ints(arr, n, min, max);
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../c-data-structures/merge_sort/merge_sort.h"
+#include "sort.h"
+#include "generator.h"
+#include "timer.h"
+
+// Compare merge_sort with the sorts in sort.h on lists like day 1's, from 10^5 values up to `-n` values
+// Every sort must give the same array as merge_sort, or its row is marked MISMATCH
+
+typedef struct Distribution
+{
+    char *name;
+    int min, max;
+} Distribution;
+
+void print_usage(char *program_name);
+void sort_counting(int *arr, size_t n);
+void sort_radix(int *arr, size_t n);
+
+typedef struct Sort
+{
+    char *name;
+    void (*sort)(int *arr, size_t n);
+    // Skip this sort if the range of the values is more than this
+    long long max_range;
+} Sort;
+
+int main(int argc, char *argv[])
+{
+    // The largest number of values sorted. Each size is 10 times the last, starting at 10^5
+    long long max_size = 10000000LL;
+    // The number of runs of each sort. The fastest is reported
+    int repetitions = 3;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            max_size = atoll(optarg);
+            break;
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (max_size < 1 || repetitions < 1)
+    {
+        fprintf(stderr, "The number of values and repetitions must be at least 1\n");
+        return 1;
+    }
+
+    // Day 1's location IDs have 5 digits. Full range ints need every radix pass
+    Distribution distributions[] = {
+        {"5 digit", 10000, 99999},
+        {"31 bit", 0, 0x7fffffff},
+    };
+    Sort sorts[] = {
+        {"merge_sort", merge_sort, 0x7fffffffLL},
+        {"counting", sort_counting, 1LL << 27},
+        {"radix", sort_radix, 0x7fffffffLL},
+        {"sort_ints", sort_ints, 0x7fffffffLL},
+    };
+
+    printf("%-10s %-12s %12s %10s\n", "Values", "Sort", "Size", "ns/value");
+    for (size_t d = 0; d < sizeof(distributions) / sizeof(distributions[0]); d++)
+    {
+        Distribution distribution = distributions[d];
+        for (long long size = 100000LL; size <= max_size; size *= 10)
+        {
+            seed_random(DEFAULT_SEED);
+            int *values = malloc(sizeof(values[0]) * size);
+            int *sorted = malloc(sizeof(sorted[0]) * size);
+            int *expected = malloc(sizeof(expected[0]) * size);
+            for (long long i = 0; i < size; i++)
+                values[i] = random_range(distribution.min, distribution.max);
+
+            for (size_t s = 0; s < sizeof(sorts) / sizeof(sorts[0]); s++)
+            {
+                if ((long long)distribution.max - distribution.min > sorts[s].max_range)
+                    continue;
+                long long min_ns = -1LL;
+                for (int r = 0; r < repetitions; r++)
+                {
+                    memcpy(sorted, values, sizeof(values[0]) * size);
+                    long long start = now_ns();
+                    sorts[s].sort(sorted, size);
+                    long long ns = now_ns() - start;
+                    if (min_ns < 0 || ns < min_ns)
+                        min_ns = ns;
+                }
+                // merge_sort is first, so it makes the expected array for the rest
+                if (!s)
+                    memcpy(expected, sorted, sizeof(sorted[0]) * size);
+                printf("%-10s %-12s %12lld %10.2f%s\n", distribution.name, sorts[s].name, size, (double)min_ns / size,
+                       memcmp(sorted, expected, sizeof(sorted[0]) * size) ? " MISMATCH" : "");
+            }
+            free(values);
+            free(sorted);
+            free(expected);
+        }
+    }
+    return 0;
+}
+
+void print_usage(char *program_name)
+{
+    fprintf(stderr, "Usage: %s [-n MAX_VALUES] [-r REPETITIONS]\n", program_name);
+}
+
+// Always counting sort, whatever the range
+void sort_counting(int *arr, size_t n)
+{
+    int min, max;
+    int_range(arr, n, &min, &max);
+    counting_sort_ints(arr, n, min, max);
+}
+
+// Always radix sort, whatever the range
+void sort_radix(int *arr, size_t n)
+{
+    int min, max;
+    int_range(arr, n, &min, &max);
+    radix_sort_ints(arr, n, min, max);
+}
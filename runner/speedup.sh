@@ -0,0 +1,42 @@
+#!/bin/sh
+# Print a table comparing the parse + solve time of every solver across the debug, release, and PGO builds
+# Usage: speedup.sh INPUT_DIR DEBUG_AOC RELEASE_AOC PGO_AOC
+
+if [ $# -ne 4 ]; then
+    echo "Usage: $0 INPUT_DIR DEBUG_AOC RELEASE_AOC PGO_AOC" >&2
+    exit 1
+fi
+
+input_dir=$1
+shift
+
+# Run each build, bypassing the result cache so every solver is timed, keeping only "day part milliseconds" for solvers that succeeded
+for aoc in "$@"; do
+    "$aoc" -i "$input_dir" -B | awk '$1 ~ /^[0-9]+$/ && $NF != "-" { print $1, $2, $(NF - 1) + $NF }'
+    echo "END"
+done | awk '
+    BEGIN { build = 0 }
+    # Each build is terminated by END
+    $1 == "END" { build++; next }
+    {
+        key = $1 " " $2
+        if (!(key in seen)) { seen[key] = 1; keys[n++] = key }
+        ms[key, build] = $3
+    }
+    END {
+        printf "%-4s %-4s %12s %12s %12s %9s %9s\n", "Day", "Part", "Debug (ms)", "Release (ms)", "PGO (ms)", "Release", "PGO"
+        for (i = 0; i < n; i++) {
+            key = keys[i]
+            split(key, day_part, " ")
+            # Skip solvers that failed in any build
+            if (!((key, 0) in ms) || !((key, 1) in ms) || !((key, 2) in ms))
+                continue
+            printf "%-4d %-4d %12.3f %12.3f %12.3f %8.2fx %8.2fx\n", day_part[1], day_part[2], ms[key, 0], ms[key, 1], ms[key, 2], ratio(ms[key, 0], ms[key, 1]), ratio(ms[key, 0], ms[key, 2])
+            for (b = 0; b < 3; b++)
+                total[b] += ms[key, b]
+        }
+        printf "%-4s %-4s %12.3f %12.3f %12.3f %8.2fx %8.2fx\n", "", "", total[0], total[1], total[2], ratio(total[0], total[1]), ratio(total[0], total[2])
+    }
+    # Speedup of `fast` over `slow`, avoiding division by 0 for very fast solvers
+    function ratio(slow, fast) { return fast > 0 ? slow / fast : 0 }
+'
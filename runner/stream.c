@@ -0,0 +1,224 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "stream.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+// Zeroed bytes after the data of each chunk, so parsing that reads a word or 16 bytes at a time never leaves the chunk
+#define STREAM_PADDING 64
+
+typedef struct StreamJob
+{
+    int fd;
+    const char *separator;
+    size_t separator_size;
+    StreamSumFn fn;
+    void *ctx;
+
+    // Protects everything below except the partial sums
+    pthread_mutex_t lock;
+    // Signalled when a chunk is ready to solve, or the reader is done
+    pthread_cond_t ready;
+    // Signalled when a chunk has been solved and can be filled again
+    pthread_cond_t emptied;
+
+    char *chunks[STREAM_CHUNKS];
+    // The number of bytes of whole records in each ready chunk
+    size_t sizes[STREAM_CHUNKS];
+    // The chunks that are full and waiting to be solved, in the order they were read
+    int ready_chunks[STREAM_CHUNKS];
+    size_t ready_head, ready_size;
+    // The chunks that can be filled
+    int free_chunks[STREAM_CHUNKS];
+    size_t free_size;
+    // Whether the reader has read the last chunk
+    bool done;
+    // 0, or non-zero if reading or solving a chunk failed
+    int error;
+
+    struct
+    {
+        _Alignas(64) long long value;
+    } partials[MAX_THREADS];
+} StreamJob;
+
+// Take a chunk to fill, waiting for one to be solved if every chunk is in use
+static int take_free_chunk(StreamJob *job)
+{
+    pthread_mutex_lock(&job->lock);
+    while (!job->free_size)
+        pthread_cond_wait(&job->emptied, &job->lock);
+    int chunk = job->free_chunks[--job->free_size];
+    pthread_mutex_unlock(&job->lock);
+    return chunk;
+}
+
+// Hand `size` bytes of whole records in `chunk` to the solving threads
+static void publish_chunk(StreamJob *job, int chunk, size_t size)
+{
+    memset(job->chunks[chunk] + size, 0, STREAM_PADDING);
+    pthread_mutex_lock(&job->lock);
+    job->sizes[chunk] = size;
+    job->ready_chunks[(job->ready_head + job->ready_size++) % STREAM_CHUNKS] = chunk;
+    pthread_cond_signal(&job->ready);
+    pthread_mutex_unlock(&job->lock);
+}
+
+// The length of the whole records at the start of `data`: up to the end of the last separator, or 0 if there is none
+static size_t whole_records_size(const char *data, size_t size, const char *separator, size_t separator_size)
+{
+    for (size_t end = size; end >= separator_size; end--)
+        if (!memcmp(data + end - separator_size, separator, separator_size))
+            return end;
+    return 0UL;
+}
+
+// Fill chunks from the input until it ends, cutting each after its last whole record and starting the next with the rest
+static void *read_chunks(void *arg)
+{
+    StreamJob *job = arg;
+    int chunk = take_free_chunk(job);
+    size_t filled = 0UL;
+    int error = 1;
+    while (true)
+    {
+        TRACE_BEGIN("read");
+        ssize_t bytes_read = read(job->fd, job->chunks[chunk] + filled, STREAM_CHUNK_SIZE - filled);
+        TRACE_END();
+        if (bytes_read < 0)
+        {
+            perror("Error reading input");
+            break;
+        }
+        if (!bytes_read)
+        {
+            // The last record may not end with a separator, so the rest of the input is all records
+            if (filled)
+                publish_chunk(job, chunk, filled);
+            error = 0;
+            break;
+        }
+        filled += bytes_read;
+        // Read pipes until the chunk is full, so chunks are few and large
+        if (filled < STREAM_CHUNK_SIZE)
+            continue;
+
+        size_t records_size = whole_records_size(job->chunks[chunk], filled, job->separator, job->separator_size);
+        if (!records_size)
+        {
+            fprintf(stderr, "A record is longer than the %lu byte stream chunks\n", STREAM_CHUNK_SIZE);
+            break;
+        }
+        int next_chunk = take_free_chunk(job);
+        memcpy(job->chunks[next_chunk], job->chunks[chunk] + records_size, filled - records_size);
+        publish_chunk(job, chunk, records_size);
+        chunk = next_chunk;
+        filled -= records_size;
+    }
+
+    pthread_mutex_lock(&job->lock);
+    if (error)
+        job->error = error;
+    job->done = true;
+    pthread_cond_broadcast(&job->ready);
+    pthread_mutex_unlock(&job->lock);
+    return NULL;
+}
+
+// Solve chunks as they become ready until the reader is done and every chunk is solved. Runs once on each thread
+static void solve_chunks(size_t begin, size_t end, int worker, void *ctx)
+{
+    StreamJob *job = ctx;
+    while (true)
+    {
+        pthread_mutex_lock(&job->lock);
+        while (!job->ready_size && !job->done)
+            pthread_cond_wait(&job->ready, &job->lock);
+        if (!job->ready_size)
+        {
+            pthread_mutex_unlock(&job->lock);
+            return;
+        }
+        int chunk = job->ready_chunks[job->ready_head];
+        job->ready_head = (job->ready_head + 1) % STREAM_CHUNKS;
+        job->ready_size--;
+        pthread_mutex_unlock(&job->lock);
+
+        Span records = {job->chunks[chunk], job->chunks[chunk] + job->sizes[chunk]};
+        TRACE_BEGIN_ARG("solve_chunk", "bytes", job->sizes[chunk]);
+        int error = job->fn(records, worker, job->ctx, &job->partials[worker].value);
+        TRACE_END();
+
+        pthread_mutex_lock(&job->lock);
+        if (error)
+            job->error = error;
+        job->free_chunks[job->free_size++] = chunk;
+        pthread_cond_signal(&job->emptied);
+        pthread_mutex_unlock(&job->lock);
+    }
+}
+
+/// @brief Read an input a chunk at a time, summing the results of `fn` on every chunk while the rest is read.
+/// If a chunk fails, the rest are still read and solved, but the sum is not valid
+/// @param input_file The path of the file to input from. If null, stdin will be used
+/// @param separator What every record ends with, e.g. "\n" for lines or "\n\n" for blocks of lines
+/// @param fn The function to solve the records of each chunk
+/// @param ctx Passed to `fn`
+/// @param sum Out: The sum of the results of `fn`
+/// @return 0 if success, non-zero if failure
+int stream_sum(char *input_file, const char *separator, StreamSumFn fn, void *ctx, long long *sum)
+{
+    int fd = input_file ? open(input_file, O_RDONLY) : STDIN_FILENO;
+    if (fd < 0)
+    {
+        perror("Error opening input file");
+        return 1;
+    }
+
+    StreamJob *job = aligned_alloc(_Alignof(StreamJob), sizeof(*job));
+    *job = (StreamJob){.fd = fd, .separator = separator, .separator_size = strlen(separator), .fn = fn, .ctx = ctx};
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->ready, NULL);
+    pthread_cond_init(&job->emptied, NULL);
+    for (int i = 0; i < STREAM_CHUNKS; i++)
+    {
+        job->chunks[i] = malloc(STREAM_CHUNK_SIZE + STREAM_PADDING);
+        job->free_chunks[job->free_size++] = i;
+    }
+
+    int result = 0;
+    pthread_t reader;
+    if (pthread_create(&reader, NULL, read_chunks, job))
+    {
+        fprintf(stderr, "Error starting the stream reader\n");
+        result = 1;
+    }
+    else
+    {
+        // One call per thread, each of which solves chunks until the input ends
+        int threads = get_thread_count();
+        parallel_for(0UL, threads, 1UL, solve_chunks, job);
+        pthread_join(reader, NULL);
+        result = job->error;
+    }
+
+    *sum = 0LL;
+    for (int i = 0; i < MAX_THREADS; i++)
+        *sum += job->partials[i].value;
+
+    for (int i = 0; i < STREAM_CHUNKS; i++)
+        free(job->chunks[i]);
+    pthread_cond_destroy(&job->ready);
+    pthread_cond_destroy(&job->emptied);
+    pthread_mutex_destroy(&job->lock);
+    free(job);
+    if (input_file)
+        close(fd);
+    return result;
+}
@@ -0,0 +1,27 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+// Solving an input while it is read, for inputs made of independent records (lines, or blocks of lines)
+// A reader thread fills a few fixed-size chunks from the file or pipe, each cut after the last whole record in it, and
+// every thread of the pool takes full chunks and solves the records in them as they arrive. Memory stays at
+// STREAM_CHUNKS chunks however long the input is, and reading overlaps with solving even with 1 thread.
+// Chunks are solved in any order and on any thread, so the results of the chunks must be combinable in any order.
+
+#include "input.h"
+
+// The size of each chunk. A record can be at most this long
+#define STREAM_CHUNK_SIZE (1UL << 20)
+// The number of chunks, which is the most memory a stream holds. At least 2, so one can fill while another is solved
+#define STREAM_CHUNKS 8
+
+/// @brief Solve the records of one chunk
+/// @param records Whole records, each ending in the separator except possibly the last record of the input
+/// @param worker The thread running this, between 0 and get_thread_count() - 1
+/// @param ctx Passed through from stream_sum
+/// @param sum In/out: The sum to add the result of each record to
+/// @return 0 if success, non-zero if a record is invalid
+typedef int (*StreamSumFn)(Span records, int worker, void *ctx, long long *sum);
+
+int stream_sum(char *input_file, const char *separator, StreamSumFn fn, void *ctx, long long *sum);
+
+#endif
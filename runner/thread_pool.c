@@ -0,0 +1,260 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "thread_pool.h"
+
+// One thread's share of the current loop, as offsets from the loop's start: the begin in the low 32 bits and the end
+// in the high 32 bits, so the owner and thieves can both update it with one compare and swap
+typedef struct Share
+{
+    _Alignas(64) _Atomic uint64_t range;
+} Share;
+
+typedef struct Scratch
+{
+    _Alignas(64) void *ptr;
+    size_t size;
+} Scratch;
+
+static struct
+{
+    // The number of threads, including the one calling parallel_for
+    int threads;
+    // Thread i + 1 is workers[i]
+    pthread_t workers[MAX_THREADS - 1];
+
+    // Protects everything below except the shares
+    pthread_mutex_t lock;
+    // Signalled when a loop starts or the workers should stop
+    pthread_cond_t start;
+    // Signalled when the last worker has finished its part of a loop
+    pthread_cond_t finish;
+    // Incremented for each loop, so workers can tell a new loop from a spurious wakeup
+    unsigned long generation;
+    // The generation when the workers were started, which they have not run yet
+    unsigned long spawn_generation;
+    bool stopping;
+    // The number of workers that have not finished the current loop
+    int active;
+
+    // The current loop
+    ParallelForFn fn;
+    void *ctx;
+    size_t begin;
+    size_t grain;
+    Share shares[MAX_THREADS];
+
+    Scratch scratch[MAX_THREADS];
+} pool = {
+    .threads = 1,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .finish = PTHREAD_COND_INITIALIZER,
+};
+
+// The index of this thread in the pool. The thread calling parallel_for is 0
+static _Thread_local int current_worker = 0;
+// Whether this thread is running part of a loop, so a nested parallel_for runs on this thread instead
+static _Thread_local bool in_loop = false;
+
+static inline uint64_t pack_range(uint32_t begin, uint32_t end) { return ((uint64_t)end << 32) | begin; }
+static inline uint32_t range_begin(uint64_t range) { return (uint32_t)range; }
+static inline uint32_t range_end(uint64_t range) { return (uint32_t)(range >> 32); }
+
+/// @brief Take the next `grain` iterations from the front of a thread's own share
+/// @param worker The thread
+/// @param begin Out: The first iteration taken, relative to the start of the loop
+/// @param end Out: One past the last iteration taken
+/// @return false if the share is empty
+static bool take_own(int worker, uint32_t *begin, uint32_t *end)
+{
+    _Atomic uint64_t *share = &pool.shares[worker].range;
+    uint64_t range = atomic_load(share);
+    while (range_begin(range) < range_end(range))
+    {
+        *begin = range_begin(range);
+        *end = (range_end(range) - *begin > pool.grain) ? *begin + pool.grain : range_end(range);
+        if (atomic_compare_exchange_weak(share, &range, pack_range(*end, range_end(range))))
+            return true;
+    }
+    return false;
+}
+
+/// @brief Move the back half of the largest share into a thread's own (empty) share
+/// @param worker The thread
+/// @return false if every share is empty
+static bool steal(int worker)
+{
+    for (;;)
+    {
+        int victim = -1;
+        uint32_t victim_size = 0;
+        for (int i = 0; i < pool.threads; i++)
+        {
+            uint64_t range = atomic_load(&pool.shares[i].range);
+            if (range_end(range) - range_begin(range) > victim_size)
+            {
+                victim = i;
+                victim_size = range_end(range) - range_begin(range);
+            }
+        }
+        if (victim == -1)
+            return false;
+
+        uint64_t range = atomic_load(&pool.shares[victim].range);
+        uint32_t begin = range_begin(range);
+        uint32_t end = range_end(range);
+        if (begin >= end)
+            continue;
+        // A share of one grain or less is taken whole, since splitting it would only make smaller chunks
+        uint32_t middle = (end - begin > pool.grain) ? begin + ((end - begin) / 2) : begin;
+        if (atomic_compare_exchange_strong(&pool.shares[victim].range, &range, pack_range(begin, middle)))
+        {
+            atomic_store(&pool.shares[worker].range, pack_range(middle, end));
+            return true;
+        }
+    }
+}
+
+// Run chunks of the current loop until there are none left to take or steal
+static void work(int worker)
+{
+    in_loop = true;
+    uint32_t begin, end;
+    for (;;)
+    {
+        if (take_own(worker, &begin, &end))
+            pool.fn(pool.begin + begin, pool.begin + end, worker, pool.ctx);
+        else if (!steal(worker))
+            break;
+    }
+    in_loop = false;
+}
+
+static void *worker_main(void *arg)
+{
+    current_worker = (int)(intptr_t)arg;
+    pthread_mutex_lock(&pool.lock);
+    unsigned long seen = pool.spawn_generation;
+    for (;;)
+    {
+        while (pool.generation == seen && !pool.stopping)
+            pthread_cond_wait(&pool.start, &pool.lock);
+        if (pool.stopping)
+            break;
+        seen = pool.generation;
+        pthread_mutex_unlock(&pool.lock);
+
+        work(current_worker);
+
+        pthread_mutex_lock(&pool.lock);
+        if (!--pool.active)
+            pthread_cond_signal(&pool.finish);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+/// @brief Set the number of threads that run each parallel_for, stopping or starting workers as needed.
+/// Must not be called from inside a parallel_for
+/// @param threads The number of threads, including the calling thread. Clamped to 1 through MAX_THREADS
+void set_thread_count(int threads)
+{
+    if (threads < 1)
+        threads = 1;
+    if (threads > MAX_THREADS)
+        threads = MAX_THREADS;
+    if (threads == pool.threads)
+        return;
+
+    // Stop every worker, then start the new number of them
+    pthread_mutex_lock(&pool.lock);
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+    for (int i = 0; i < pool.threads - 1; i++)
+        pthread_join(pool.workers[i], NULL);
+    pool.stopping = false;
+
+    for (int i = threads; i < pool.threads; i++)
+    {
+        free(pool.scratch[i].ptr);
+        pool.scratch[i] = (Scratch){NULL, 0UL};
+    }
+
+    pool.threads = 1;
+    pool.spawn_generation = pool.generation;
+    for (int i = 0; i < threads - 1; i++)
+    {
+        if (pthread_create(&pool.workers[i], NULL, worker_main, (void *)(intptr_t)(i + 1)))
+            break;
+        pool.threads++;
+    }
+}
+
+// The number of threads that run each parallel_for, including the calling thread
+int get_thread_count() { return pool.threads; }
+
+/// @brief Call `fn` on chunks of [begin, end) on every thread in the pool, returning once every chunk is done
+/// @param begin The first iteration
+/// @param end One past the last iteration
+/// @param grain The most iterations in one call to `fn`. At least 1
+/// @param fn The function to call
+/// @param ctx Passed to `fn`
+void parallel_for(size_t begin, size_t end, size_t grain, ParallelForFn fn, void *ctx)
+{
+    if (begin >= end)
+        return;
+    if (!grain)
+        grain = 1;
+    if (pool.threads == 1 || in_loop || end - begin <= grain)
+    {
+        fn(begin, end, current_worker, ctx);
+        return;
+    }
+    // Shares are 32 bits, so split up loops too long for them
+    while (end - begin > UINT32_MAX)
+    {
+        parallel_for(begin, begin + UINT32_MAX, grain, fn, ctx);
+        begin += UINT32_MAX;
+    }
+
+    size_t size = end - begin;
+    pthread_mutex_lock(&pool.lock);
+    pool.fn = fn;
+    pool.ctx = ctx;
+    pool.begin = begin;
+    pool.grain = grain > UINT32_MAX ? UINT32_MAX : grain;
+    for (int i = 0; i < pool.threads; i++)
+        atomic_store(&pool.shares[i].range, pack_range(size * i / pool.threads, size * (i + 1) / pool.threads));
+    pool.active = pool.threads - 1;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+
+    work(0);
+
+    pthread_mutex_lock(&pool.lock);
+    while (pool.active)
+        pthread_cond_wait(&pool.finish, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+}
+
+/// @brief Get memory that only `worker` uses, which is kept between loops. Its contents are undefined
+/// @param worker The thread, as passed to a ParallelForFn
+/// @param size The number of bytes needed
+/// @return The memory, which is valid until the next call with the same worker or set_thread_count
+void *worker_scratch(int worker, size_t size)
+{
+    Scratch *scratch = &pool.scratch[worker];
+    if (scratch->size < size)
+    {
+        free(scratch->ptr);
+        scratch->ptr = malloc(size);
+        scratch->size = size;
+    }
+    return scratch->ptr;
+}
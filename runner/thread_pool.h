@@ -0,0 +1,69 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// A pool of worker threads for loops whose iterations don't depend on each other
+// The pool starts with 1 thread (the caller), so every loop runs in order on the calling thread until
+// set_thread_count is given more. The runner does that with --threads N.
+//
+// parallel_for splits [begin, end) evenly between the threads. Each thread takes `grain` iterations at a time from the
+// front of its share, and a thread that runs out steals the back half of the largest remaining share, so uneven
+// iterations still keep every thread busy. A parallel_for inside another one runs on the calling thread.
+// Solvers that print from inside a loop will print in no particular order with more than 1 thread.
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// The most threads the pool will run
+#define MAX_THREADS 64
+
+// Run iterations [begin, end) of a loop on thread `worker`, which is between 0 and get_thread_count() - 1
+typedef void (*ParallelForFn)(size_t begin, size_t end, int worker, void *ctx);
+
+void set_thread_count(int threads);
+int get_thread_count();
+void parallel_for(size_t begin, size_t end, size_t grain, ParallelForFn fn, void *ctx);
+void *worker_scratch(int worker, size_t size);
+
+// DEF_PARALLEL_REDUCE(T) defines parallel_reduce_##T, which combines the results of `fn` over every chunk of [begin, end)
+// T must be a single identifier. `combine` must be associative and commutative, because chunks finish in any order
+// and are combined on whichever thread ran them. The partial result of each thread is on its own cache line.
+#define DEF_PARALLEL_REDUCE(T)                                                                                          \
+    typedef T (*T##_ReduceFn)(size_t begin, size_t end, int worker, void *ctx);                                         \
+                                                                                                                        \
+    typedef struct T##_ReduceJob                                                                                        \
+    {                                                                                                                   \
+        T##_ReduceFn fn;                                                                                                \
+        T (*combine)(T, T);                                                                                             \
+        void *ctx;                                                                                                      \
+        struct                                                                                                          \
+        {                                                                                                               \
+            _Alignas(64) T value;                                                                                       \
+        } partials[MAX_THREADS];                                                                                        \
+    } T##_ReduceJob;                                                                                                    \
+                                                                                                                        \
+    static inline void T##_reduce_chunk(size_t begin, size_t end, int worker, void *ctx)                                \
+    {                                                                                                                   \
+        T##_ReduceJob *job = ctx;                                                                                       \
+        job->partials[worker].value = job->combine(job->partials[worker].value, job->fn(begin, end, worker, job->ctx)); \
+    }                                                                                                                   \
+                                                                                                                        \
+    /* Combine `identity` and the result of `fn` on every chunk of [begin, end) with `combine` */                       \
+    static inline T parallel_reduce_##T(size_t begin, size_t end, size_t grain, T identity, T##_ReduceFn fn,            \
+                                        T (*combine)(T, T), void *ctx)                                                  \
+    {                                                                                                                   \
+        T##_ReduceJob *job = aligned_alloc(_Alignof(T##_ReduceJob), sizeof(*job));                                      \
+        job->fn = fn;                                                                                                   \
+        job->combine = combine;                                                                                         \
+        job->ctx = ctx;                                                                                                 \
+        int threads = get_thread_count();                                                                               \
+        for (int i = 0; i < threads; i++)                                                                               \
+            job->partials[i].value = identity;                                                                          \
+        parallel_for(begin, end, grain, T##_reduce_chunk, job);                                                         \
+        T result = identity;                                                                                            \
+        for (int i = 0; i < threads; i++)                                                                               \
+            result = combine(result, job->partials[i].value);                                                           \
+        free(job);                                                                                                      \
+        return result;                                                                                                  \
+    }
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <time.h>
+
+// Get the current monotonic time in nanoseconds
+static inline long long now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "trace.h"
+
+// Everything here is only needed when tracing is compiled in
+#ifdef AOC_TRACE
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+_Thread_local TraceBuffer *trace_buffer = NULL;
+
+// Every thread's buffer, newest first. They outlive their threads so the trace is complete at exit
+static TraceBuffer *trace_buffers = NULL;
+static int trace_threads = 0;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void write_trace();
+
+// Give this thread a buffer to record into, the first time it records an event. NULL if out of memory
+TraceBuffer *new_trace_buffer()
+{
+    TraceBuffer *buffer = malloc(sizeof(*buffer));
+    if (!buffer)
+        return NULL;
+    buffer->size = 0UL;
+
+    pthread_mutex_lock(&trace_lock);
+    // The trace is written once, after every thread is done
+    if (!trace_threads)
+        atexit(write_trace);
+    buffer->thread_id = trace_threads++;
+    buffer->next = trace_buffers;
+    trace_buffers = buffer;
+    pthread_mutex_unlock(&trace_lock);
+
+    trace_buffer = buffer;
+    return buffer;
+}
+
+// Write one thread's events, oldest first. `first_buffer` is whether it is the first in the file
+static void write_buffer(FILE *f, TraceBuffer *buffer, int pid, bool first_buffer)
+{
+    fprintf(f, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+            first_buffer ? "" : ",", pid, buffer->thread_id, buffer->thread_id);
+
+    size_t first = buffer->size > TRACE_RING_SIZE ? buffer->size - TRACE_RING_SIZE : 0UL;
+    // If the ring wrapped, the ends of spans whose beginnings were overwritten are dropped
+    int depth = 0;
+    for (size_t i = first; i < buffer->size; i++)
+    {
+        TraceEvent *event = &buffer->events[i % TRACE_RING_SIZE];
+        if (event->phase == 'E' && !depth)
+            continue;
+        depth += event->phase == 'B' ? 1 : -1;
+
+        // Timestamps are in microseconds
+        fprintf(f, ",\n{\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%lld.%03lld", event->phase, pid, buffer->thread_id,
+                event->ns / 1000, event->ns % 1000);
+        if (event->name)
+            fprintf(f, ",\"name\":\"%s\"", event->name);
+        if (event->arg_name)
+            fprintf(f, ",\"args\":{\"%s\":%lld}", event->arg_name, event->arg);
+        fputc('}', f);
+    }
+}
+
+// Write every buffer to $AOC_TRACE_FILE, or trace.json
+static void write_trace()
+{
+    char *trace_file = getenv("AOC_TRACE_FILE");
+    if (!trace_file || !trace_file[0])
+        trace_file = "trace.json";
+    FILE *f = fopen(trace_file, "w");
+    if (!f)
+    {
+        perror("Error writing the trace");
+        return;
+    }
+
+    pthread_mutex_lock(&trace_lock);
+    int pid = (int)getpid();
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (TraceBuffer *buffer = trace_buffers; buffer; buffer = buffer->next)
+        write_buffer(f, buffer, pid, buffer == trace_buffers);
+    fprintf(f, "\n]}\n");
+    // The buffers are left for the exit to free, since other threads may still point to theirs
+    pthread_mutex_unlock(&trace_lock);
+
+    fclose(f);
+    fprintf(stderr, "Wrote the trace to %s\n", trace_file);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Timelines of what solvers do, in Chrome's trace event format (open the file in chrome://tracing or Perfetto)
+// TRACE_SCOPE marks the rest of the enclosing block as one span, and TRACE_BEGIN and TRACE_END mark spans that don't
+// follow a block. Each thread records its events into its own ring buffer without locking, and every buffer is written
+// to $AOC_TRACE_FILE (default: trace.json) when the program exits. A thread that records more than TRACE_RING_SIZE
+// events keeps only the newest.
+//
+// Tracing is only compiled in with -DAOC_TRACE (the `trace` build). Otherwise every macro expands to nothing, so
+// neither the names nor the values are evaluated.
+
+#ifdef AOC_TRACE
+
+#include "timer.h"
+
+// The number of events each thread keeps
+#define TRACE_RING_SIZE (1UL << 16)
+
+typedef struct TraceEvent
+{
+    // Must be a string literal (or live until exit)
+    const char *name;
+    // The name of `arg`, or NULL if the event has none
+    const char *arg_name;
+    long long arg;
+    long long ns;
+    // 'B' to begin a span, 'E' to end the last one
+    char phase;
+} TraceEvent;
+
+typedef struct TraceBuffer
+{
+    TraceEvent events[TRACE_RING_SIZE];
+    // The number of events ever recorded. The newest is at (size - 1) % TRACE_RING_SIZE
+    size_t size;
+    // Small sequential ids, in the order threads first traced
+    int thread_id;
+    struct TraceBuffer *next;
+} TraceBuffer;
+
+// The end of a TRACE_SCOPE, which ends its span when it goes out of scope
+typedef struct TraceScope
+{
+    const char *name;
+} TraceScope;
+
+extern _Thread_local TraceBuffer *trace_buffer;
+TraceBuffer *new_trace_buffer();
+
+static inline void trace_event(char phase, const char *name, const char *arg_name, long long arg)
+{
+    TraceBuffer *buffer = trace_buffer ? trace_buffer : new_trace_buffer();
+    if (!buffer)
+        return;
+    buffer->events[buffer->size++ % TRACE_RING_SIZE] =
+        (TraceEvent){.name = name, .arg_name = arg_name, .arg = arg, .ns = now_ns(), .phase = phase};
+}
+
+static inline TraceScope trace_scope_begin(const char *name, const char *arg_name, long long arg)
+{
+    trace_event('B', name, arg_name, arg);
+    return (TraceScope){name};
+}
+
+static inline void trace_scope_end(TraceScope *scope) { trace_event('E', scope->name, NULL, 0LL); }
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Trace from here to the end of the enclosing block as `name`
+#define TRACE_SCOPE(name) \
+    TraceScope TRACE_CONCAT(trace_scope_, __LINE__) __attribute__((cleanup(trace_scope_end))) = trace_scope_begin(name, NULL, 0LL)
+// Trace from here to the end of the enclosing block as `name`, showing the integer `value` as `arg_name`
+#define TRACE_SCOPE_ARG(name, arg_name, value)                                                         \
+    TraceScope TRACE_CONCAT(trace_scope_, __LINE__) __attribute__((cleanup(trace_scope_end))) = \
+        trace_scope_begin(name, arg_name, value)
+// Begin a span called `name`, which lasts until the next TRACE_END on this thread
+#define TRACE_BEGIN(name) trace_event('B', name, NULL, 0LL)
+#define TRACE_BEGIN_ARG(name, arg_name, value) trace_event('B', name, arg_name, value)
+// End the last span begun on this thread
+#define TRACE_END() trace_event('E', NULL, NULL, 0LL)
+
+#else
+
+#define TRACE_SCOPE(name)
+#define TRACE_SCOPE_ARG(name, arg_name, value)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_BEGIN_ARG(name, arg_name, value) ((void)0)
+#define TRACE_END() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+// Capacity management for the vectors from DEF_VEC in c-data-structures, which only grow one append at a time.
+// DEF_VEC_CAPACITY(T) goes after DEF_VEC(T), and lets a parser allocate a vector once at the size the input needs.
+// Memory comes from realloc and goes back with free, the same as append_T_Vec, so the functions can be mixed freely.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../c-data-structures/vector/vector_template.h"
+
+#define DEF_VEC_CAPACITY(T)                                                \
+    /* Allocate room for `cap` elements up front */                        \
+    T##_Vec with_capacity_##T##_Vec(size_t cap)                            \
+    {                                                                      \
+        return (T##_Vec){cap ? malloc(sizeof(T) * cap) : NULL, 0UL, cap}; \
+    }                                                                      \
+    /* Make room for `additional` more elements, growing at least 2x */    \
+    void reserve_##T##_Vec(T##_Vec *vec, size_t additional)                \
+    {                                                                      \
+        if (vec->len + additional <= vec->cap)                             \
+            return;                                                        \
+        vec->cap *= 2;                                                     \
+        if (vec->cap < vec->len + additional)                              \
+            vec->cap = vec->len + additional;                              \
+        vec->arr = realloc(vec->arr, sizeof(T) * vec->cap);                \
+    }                                                                      \
+    /* Append `vals_size` elements at once */                              \
+    void extend_##T##_Vec(T##_Vec *vec, const T *vals, size_t vals_size)   \
+    {                                                                      \
+        reserve_##T##_Vec(vec, vals_size);                                 \
+        if (vals_size)                                                     \
+            memcpy(vec->arr + vec->len, vals, sizeof(T) * vals_size);      \
+        vec->len += vals_size;                                             \
+    }                                                                      \
+    /* Give back the room past the last element */                         \
+    void shrink_##T##_Vec(T##_Vec *vec)                                    \
+    {                                                                      \
+        if (vec->cap == vec->len)                                          \
+            return;                                                        \
+        if (!vec->len)                                                     \
+        {                                                                  \
+            free(vec->arr);                                                \
+            *vec = new_##T##_Vec();                                        \
+            return;                                                        \
+        }                                                                  \
+        vec->arr = realloc(vec->arr, sizeof(T) * vec->len);                \
+        vec->cap = vec->len;                                               \
+    }                                                                      \
+    /* Remove every element, keeping the memory to reuse */                \
+    void clear_##T##_Vec(T##_Vec *vec) { vec->len = 0UL; }                 \
+    void delete_##T##_Vec(T##_Vec *vec)                                    \
+    {                                                                      \
+        free(vec->arr);                                                    \
+        *vec = new_##T##_Vec();                                            \
+    }
+
+#endif